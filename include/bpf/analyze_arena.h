@@ -0,0 +1,114 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_ARENA_H
+#define __ANALYZE_ARENA_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 作为对照的传统hash，容量由用户态在加载前调整
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 1024);
+    __type(key, u64);
+    __type(value, u64);
+} arena_hash_map SEC(".maps");
+
+// 槽位数(2的幂)、arena页数、已写入key数、key序号与命中次数
+__u32 arena_nr_slots = 0;
+__u32 arena_nr_pages = 0;
+__u32 arena_nr_keys = 0;
+__u64 arena_seq = 0;
+__u64 arena_hits = 0;
+
+static __always_inline int arena_hash_insert_one(void) {
+    u64 key = ++arena_seq;
+
+    bpf_map_update_elem(&arena_hash_map, &key, &key, BPF_NOEXIST);
+    return 0;
+}
+
+static __always_inline int arena_hash_lookup_one(void) {
+    u64 key = arena_seq++ % arena_nr_keys + 1;
+
+    if (bpf_map_lookup_elem(&arena_hash_map, &key))
+        __sync_fetch_and_add(&arena_hits, 1);
+    return 0;
+}
+
+// arena 需要 clang 支持 BPF 地址空间转换(clang >= 18)，旧编译器不生成
+// arena 相关的map与程序，用户态据此跳过测试
+#if defined(__BPF_FEATURE_ADDR_SPACE_CAST)
+#define ARENA_ENABLED 1
+#define __arena __attribute__((address_space(1)))
+// vmlinux.h 早于 6.9，没有 BPF_MAP_TYPE_ARENA 的定义
+#define ARENA_MAP_TYPE 33
+#define ARENA_NUMA_NO_NODE (-1)
+
+// arena 的页数由用户态在加载前调整
+struct {
+    __uint(type, ARENA_MAP_TYPE);
+    __uint(map_flags, BPF_F_MMAPABLE);
+    __uint(max_entries, 1);
+} arena SEC(".maps");
+
+void __arena *bpf_arena_alloc_pages(void *map, void __arena *addr,
+                                    __u32 page_cnt, int node_id,
+                                    __u64 flags) __ksym __weak;
+
+// 哈希表位于 arena 起始处，用户态直接通过 mmap 的地址访问
+struct arena_slot __arena *arena_table;
+
+// 一次性分配整个哈希表所需的页，第一次分配从 arena 起始地址开始
+static __always_inline int arena_alloc_table(void) {
+    arena_table = bpf_arena_alloc_pages(&arena, NULL, arena_nr_pages,
+                                        ARENA_NUMA_NO_NODE, 0);
+    return arena_table ? 0 : 1;
+}
+
+static __always_inline int arena_insert_one(void) {
+    u64 key = ++arena_seq;
+    u32 mask = arena_nr_slots - 1, idx = arena_slot_hash(key, mask);
+
+    for (int i = 0; i < ARENA_MAX_PROBES; i++) {
+        struct arena_slot __arena *slot = &arena_table[(idx + i) & mask];
+
+        if (slot->key == 0) {
+            slot->value = key;
+            slot->key = key;
+            return 0;
+        }
+    }
+    return 0;
+}
+
+static __always_inline int arena_lookup_one(void) {
+    u64 key = arena_seq++ % arena_nr_keys + 1;
+    u32 mask = arena_nr_slots - 1, idx = arena_slot_hash(key, mask);
+
+    for (int i = 0; i < ARENA_MAX_PROBES; i++) {
+        struct arena_slot __arena *slot = &arena_table[(idx + i) & mask];
+
+        if (slot->key == key) {
+            __sync_fetch_and_add(&arena_hits, 1);
+            return 0;
+        }
+        if (slot->key == 0)
+            return 0;
+    }
+    return 0;
+}
+#endif /* __BPF_FEATURE_ADDR_SPACE_CAST */
+#endif /* __ANALYZE_ARENA_H */
@@ -0,0 +1,74 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_BLOOM_H
+#define __ANALYZE_BLOOM_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 容量与哈希函数个数(map_extra)由用户态在加载前调整
+struct {
+    __uint(type, BPF_MAP_TYPE_BLOOM_FILTER);
+    __uint(max_entries, 1024);
+    __type(value, u64);
+    __uint(map_extra, 3);
+} bloom_map SEC(".maps");
+// 布隆过滤器之后的真实数据表，与 bloom_map 存入相同的key
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 1024);
+    __type(key, u64);
+    __type(value, u64);
+} bloom_hash_map SEC(".maps");
+
+// 每次调用使用 bloom_seq 作为key并递增，用户态设置起点
+__u64 bloom_seq = 0;
+// 已写入 bloom_map/bloom_hash_map 的key个数(0..bloom_nr_keys-1)
+__u64 bloom_nr_keys = 0;
+// 端到端查找中命中key的比例(0-100)
+__u32 bloom_hit_pct = 0;
+// 端到端查找中 hash 表命中次数，用于校验命中率
+__u64 bloom_hash_hits = 0;
+// 端到端查找中实际执行的 hash 查找次数，先查过滤器时与命中次数之差为误判
+__u64 bloom_hash_lookups = 0;
+
+static __always_inline int bloom_push(void) {
+    u64 value = bloom_seq++;
+    bpf_map_push_elem(&bloom_map, &value, 0);
+    return 0;
+}
+static __always_inline int bloom_peek(void) {
+    u64 value = bloom_seq++;
+    bpf_map_peek_elem(&bloom_map, &value);
+    return 0;
+}
+// 按命中率生成一个已存在或不存在的key
+static __always_inline u64 bloom_next_key(void) {
+    u64 seq = bloom_seq++;
+    if (bpf_get_prandom_u32() % 100 < bloom_hit_pct && bloom_nr_keys)
+        return seq % bloom_nr_keys;
+    return bloom_nr_keys + seq;
+}
+static __always_inline int bloom_lookup(bool use_filter) {
+    u64 key = bloom_next_key();
+    // 布隆过滤器判定不存在时直接跳过 hash 查找
+    if (use_filter && bpf_map_peek_elem(&bloom_map, &key))
+        return 0;
+    bloom_hash_lookups++;
+    if (bpf_map_lookup_elem(&bloom_hash_map, &key))
+        bloom_hash_hits++;
+    return 0;
+}
+#endif /* __ANALYZE_BLOOM_H */
@@ -0,0 +1,100 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_COUNTER_H
+#define __ANALYZE_COUNTER_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 共享计数器的四种更新方式，每种 value 大小(n 个u64)各有一组map:
+//   spin_lock: value 中带 bpf_spin_lock，加锁后逐个递增
+//   atomic:    对共享 value 的每个u64做 __sync_fetch_and_add
+//   percpu:    每CPU value 上的普通递增，读取时由用户态汇总
+//   plain:     对共享 value 的普通递增，作为会丢失更新的对照
+#define CNT_DEFINE(n)                                                          \
+    struct cnt_locked_##n {                                                    \
+        struct bpf_spin_lock lock;                                             \
+        u64 words[n];                                                          \
+    };                                                                         \
+    struct cnt_value_##n {                                                     \
+        u64 words[n];                                                          \
+    };                                                                         \
+    struct {                                                                   \
+        __uint(type, BPF_MAP_TYPE_ARRAY);                                      \
+        __uint(max_entries, 1);                                                \
+        __type(key, u32);                                                      \
+        __type(value, struct cnt_locked_##n);                                  \
+    } cnt_lock_map_##n SEC(".maps");                                           \
+    struct {                                                                   \
+        __uint(type, BPF_MAP_TYPE_ARRAY);                                      \
+        __uint(max_entries, 1);                                                \
+        __type(key, u32);                                                      \
+        __type(value, struct cnt_value_##n);                                   \
+    } cnt_shared_map_##n SEC(".maps");                                         \
+    struct {                                                                   \
+        __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);                               \
+        __uint(max_entries, 1);                                                \
+        __type(key, u32);                                                      \
+        __type(value, struct cnt_value_##n);                                   \
+    } cnt_percpu_map_##n SEC(".maps");                                         \
+    static __always_inline int cnt_lock_##n##_update(void) {                   \
+        struct cnt_locked_##n *v;                                              \
+        u32 zero = 0;                                                          \
+        v = bpf_map_lookup_elem(&cnt_lock_map_##n, &zero);                     \
+        if (!v)                                                                \
+            return 0;                                                          \
+        bpf_spin_lock(&v->lock);                                               \
+        for (int i = 0; i < n; i++)                                            \
+            v->words[i]++;                                                     \
+        bpf_spin_unlock(&v->lock);                                             \
+        return 0;                                                              \
+    }                                                                          \
+    static __always_inline int cnt_atomic_##n##_update(void) {                 \
+        struct cnt_value_##n *v;                                               \
+        u32 zero = 0;                                                          \
+        v = bpf_map_lookup_elem(&cnt_shared_map_##n, &zero);                   \
+        if (!v)                                                                \
+            return 0;                                                          \
+        for (int i = 0; i < n; i++)                                            \
+            __sync_fetch_and_add(&v->words[i], 1);                             \
+        return 0;                                                              \
+    }                                                                          \
+    static __always_inline int cnt_percpu_##n##_update(void) {                 \
+        struct cnt_value_##n *v;                                               \
+        u32 zero = 0;                                                          \
+        v = bpf_map_lookup_elem(&cnt_percpu_map_##n, &zero);                   \
+        if (!v)                                                                \
+            return 0;                                                          \
+        for (int i = 0; i < n; i++)                                            \
+            v->words[i]++;                                                     \
+        return 0;                                                              \
+    }                                                                          \
+    static __always_inline int cnt_plain_##n##_update(void) {                  \
+        struct cnt_value_##n *v;                                               \
+        u32 zero = 0;                                                          \
+        v = bpf_map_lookup_elem(&cnt_shared_map_##n, &zero);                   \
+        if (!v)                                                                \
+            return 0;                                                          \
+        for (int i = 0; i < n; i++)                                            \
+            v->words[i]++;                                                     \
+        return 0;                                                              \
+    }
+
+// value 为 8/32/128/512 字节
+CNT_DEFINE(1)
+CNT_DEFINE(4)
+CNT_DEFINE(16)
+CNT_DEFINE(64)
+#endif /* __ANALYZE_COUNTER_H */
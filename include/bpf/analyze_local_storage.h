@@ -0,0 +1,162 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_LOCAL_STORAGE_H
+#define __ANALYZE_LOCAL_STORAGE_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 每个任务保存的状态
+struct ls_value {
+    u64 counter;
+    u64 first_ns;
+};
+
+struct {
+    __uint(type, BPF_MAP_TYPE_TASK_STORAGE);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, int);
+    __type(value, struct ls_value);
+} ls_task_map SEC(".maps");
+struct {
+    __uint(type, BPF_MAP_TYPE_CGRP_STORAGE);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, int);
+    __type(value, struct ls_value);
+} ls_cgrp_map SEC(".maps");
+// 按pid索引的传统写法，进程退出后若不主动删除就会残留
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 8192);
+    __type(key, u32);
+    __type(value, struct ls_value);
+} ls_hash_map SEC(".maps");
+struct {
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
+    __uint(max_entries, 8192);
+    __type(key, u32);
+    __type(value, struct ls_value);
+} ls_lru_map SEC(".maps");
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, u32);
+    __type(value, struct ls_stat);
+} ls_stats SEC(".maps");
+
+// 负载生成进程的tgid，只统计它 fork 出的子进程；生成进程自身的线程
+// (包括 -L 的负载线程)不计入
+__u32 ls_gen_tgid = 0;
+
+static __always_inline bool ls_is_target(struct task_struct *task) {
+    if (!ls_gen_tgid)
+        return false;
+    return task->tgid != ls_gen_tgid &&
+           BPF_CORE_READ(task, real_parent, tgid) == ls_gen_tgid;
+}
+
+// 返回本CPU的统计，并顺带采样一次计时开销
+static __always_inline struct ls_stat *ls_get_stat(void) {
+    u32 zero = 0;
+    struct ls_stat *st = bpf_map_lookup_elem(&ls_stats, &zero);
+    u64 t0, t1;
+    if (!st)
+        return NULL;
+    t0 = bpf_ktime_get_ns();
+    t1 = bpf_ktime_get_ns();
+    st->clock_ns += t1 - t0;
+    st->clocks++;
+    return st;
+}
+
+static __always_inline void ls_count_create(struct ls_stat *st, u64 ns,
+                                            bool ok) {
+    st->create_ns += ns;
+    st->creates++;
+    if (!ok)
+        st->create_fails++;
+}
+
+// 任务/cgroup本地存储: 先查找，不存在时再带 F_CREATE 创建
+static __always_inline int ls_storage(struct task_struct *task, bool cgrp) {
+    struct ls_value *v;
+    struct ls_stat *st;
+    u64 t0, t1;
+
+    if (!ls_is_target(task) || !(st = ls_get_stat()))
+        return 0;
+    t0 = bpf_ktime_get_ns();
+    if (cgrp)
+        v = bpf_cgrp_storage_get(&ls_cgrp_map, task->cgroups->dfl_cgrp, 0, 0);
+    else
+        v = bpf_task_storage_get(&ls_task_map, task, 0, 0);
+    t1 = bpf_ktime_get_ns();
+    st->lookup_ns += t1 - t0;
+    st->lookups++;
+    if (!v) {
+        t0 = bpf_ktime_get_ns();
+        if (cgrp)
+            v = bpf_cgrp_storage_get(&ls_cgrp_map, task->cgroups->dfl_cgrp, 0,
+                                     BPF_LOCAL_STORAGE_GET_F_CREATE);
+        else
+            v = bpf_task_storage_get(&ls_task_map, task, 0,
+                                     BPF_LOCAL_STORAGE_GET_F_CREATE);
+        t1 = bpf_ktime_get_ns();
+        ls_count_create(st, t1 - t0, v != NULL);
+        if (v)
+            v->first_ns = t1;
+    }
+    if (v)
+        v->counter++;
+    return 0;
+}
+
+// 以线程id为key的 hash/LRU hash: 先查找，不存在时插入
+static __always_inline int ls_pid_hash(struct task_struct *task, void *map) {
+    struct ls_value init = {.counter = 1}, *v;
+    u32 pid = (u32)bpf_get_current_pid_tgid();
+    struct ls_stat *st;
+    u64 t0, t1;
+    long err;
+
+    if (!ls_is_target(task) || !(st = ls_get_stat()))
+        return 0;
+    t0 = bpf_ktime_get_ns();
+    v = bpf_map_lookup_elem(map, &pid);
+    t1 = bpf_ktime_get_ns();
+    st->lookup_ns += t1 - t0;
+    st->lookups++;
+    if (v) {
+        v->counter++;
+        return 0;
+    }
+    init.first_ns = t1;
+    t0 = bpf_ktime_get_ns();
+    err = bpf_map_update_elem(map, &pid, &init, BPF_NOEXIST);
+    t1 = bpf_ktime_get_ns();
+    ls_count_create(st, t1 - t0, err == 0);
+    return 0;
+}
+
+// 进程退出时删除hash中的条目，对应"记得清理"的写法
+static __always_inline int ls_pid_hash_cleanup(struct task_struct *task) {
+    u32 pid = task->pid;
+
+    if (ls_is_target(task))
+        bpf_map_delete_elem(&ls_hash_map, &pid);
+    return 0;
+}
+#endif /* __ANALYZE_LOCAL_STORAGE_H */
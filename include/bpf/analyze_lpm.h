@@ -0,0 +1,63 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_LPM_H
+#define __ANALYZE_LPM_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 前缀条目数由用户态在加载前调整，LPM trie 必须使用 BPF_F_NO_PREALLOC
+struct {
+    __uint(type, BPF_MAP_TYPE_LPM_TRIE);
+    __uint(max_entries, 1024);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, struct lpm_v4_key);
+    __type(value, u32);
+} lpm_v4_map SEC(".maps");
+struct {
+    __uint(type, BPF_MAP_TYPE_LPM_TRIE);
+    __uint(max_entries, 1024);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, struct lpm_v6_key);
+    __type(value, u32);
+} lpm_v6_map SEC(".maps");
+// 用户态预先写入的查找地址，IPv4 只使用 addr 的前4个字节
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, LPM_LOOKUP_KEYS);
+    __type(key, u32);
+    __type(value, struct lpm_v6_key);
+} lpm_lookup_keys SEC(".maps");
+
+__u32 lpm_nr_keys = 0;
+__u32 lpm_seq = 0;
+__u64 lpm_hits = 0;
+
+static __always_inline struct lpm_v6_key *lpm_next_key(void) {
+    u32 idx = lpm_seq++;
+    if (lpm_nr_keys)
+        idx %= lpm_nr_keys;
+    return bpf_map_lookup_elem(&lpm_lookup_keys, &idx);
+}
+// map 为空时只取查找地址，作为扣除取地址开销的基线
+static __always_inline int lpm_lookup(void *map) {
+    struct lpm_v6_key *key = lpm_next_key();
+    if (!key || !map)
+        return 0;
+    if (bpf_map_lookup_elem(map, key))
+        lpm_hits++;
+    return 0;
+}
+#endif /* __ANALYZE_LPM_H */
@@ -0,0 +1,88 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_MAP_IN_MAP_H
+#define __ANALYZE_MAP_IN_MAP_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "analyze_map.h"
+#include "common.h"
+
+// 内层map模板，与 analyze_map.h 中的四种map保持相同的几何参数
+struct mim_inner_hash {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, MAX_ENTRIES);
+    __type(key, u32);
+    __type(value, u64);
+};
+struct mim_inner_array {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, MAX_ENTRIES);
+    __type(key, u32);
+    __type(value, u64);
+};
+struct mim_inner_percpu_array {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, MAX_ENTRIES);
+    __type(key, u32);
+    __type(value, u64);
+};
+struct mim_inner_percpu_hash {
+    __uint(type, BPF_MAP_TYPE_PERCPU_HASH);
+    __uint(max_entries, MAX_ENTRIES);
+    __type(key, u32);
+    __type(value, u64);
+};
+
+// 外层map的条目数(内层map个数)由用户态在加载前调整
+#define MIM_OUTER(name, outer_type, inner)                                      \
+    struct {                                                                   \
+        __uint(type, outer_type);                                              \
+        __uint(max_entries, 1);                                                \
+        __type(key, u32);                                                      \
+        __array(values, struct inner);                                         \
+    } name SEC(".maps")
+
+MIM_OUTER(aom_hash, BPF_MAP_TYPE_ARRAY_OF_MAPS, mim_inner_hash);
+MIM_OUTER(aom_array, BPF_MAP_TYPE_ARRAY_OF_MAPS, mim_inner_array);
+MIM_OUTER(aom_percpu_array, BPF_MAP_TYPE_ARRAY_OF_MAPS, mim_inner_percpu_array);
+MIM_OUTER(aom_percpu_hash, BPF_MAP_TYPE_ARRAY_OF_MAPS, mim_inner_percpu_hash);
+MIM_OUTER(hom_hash, BPF_MAP_TYPE_HASH_OF_MAPS, mim_inner_hash);
+MIM_OUTER(hom_array, BPF_MAP_TYPE_HASH_OF_MAPS, mim_inner_array);
+MIM_OUTER(hom_percpu_array, BPF_MAP_TYPE_HASH_OF_MAPS, mim_inner_percpu_array);
+MIM_OUTER(hom_percpu_hash, BPF_MAP_TYPE_HASH_OF_MAPS, mim_inner_percpu_hash);
+
+// 已装入外层map的内层map个数，内层索引为 0..mim_nr_inner-1
+__u32 mim_nr_inner = 1;
+__u32 mim_seq = 0;
+__u64 mim_hits = 0;
+
+// 直接查找，与经外层map的查找使用相同的key序列，作为对照
+static __always_inline int mim_lookup_direct(void *map) {
+    u32 key = mim_seq++ % MAX_ENTRIES;
+    if (bpf_map_lookup_elem(map, &key))
+        mim_hits++;
+    return 0;
+}
+// 先在外层map中找到内层map，再在内层map中查找
+static __always_inline int mim_lookup_outer(void *outer) {
+    u32 seq = mim_seq++;
+    u32 idx = mim_nr_inner ? seq % mim_nr_inner : 0;
+    u32 key = seq % MAX_ENTRIES;
+    void *inner = bpf_map_lookup_elem(outer, &idx);
+    if (inner && bpf_map_lookup_elem(inner, &key))
+        mim_hits++;
+    return 0;
+}
+#endif /* __ANALYZE_MAP_IN_MAP_H */
@@ -0,0 +1,40 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_MAP_SCAN_H
+#define __ANALYZE_MAP_SCAN_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 被遍历map的key与value字节数(每CPU map为所有CPU的value之和)，
+// 由用户态在加载前按map设置，校验器据此确认读取不越界
+const volatile __u32 scan_key_size = 8;
+const volatile __u32 scan_value_size = 8;
+
+// 像导出程序那样把每个元素的key和value原样写入seq文件，
+// 用户态 read() 得到 key|value 连续排列的记录
+static __always_inline int scan_dump_elem(struct bpf_iter__bpf_map_elem *ctx) {
+    struct seq_file *seq = ctx->meta->seq;
+    void *key = ctx->key;
+    void *value = ctx->value;
+
+    // 遍历结束时会以空元素再调用一次
+    if (!key || !value)
+        return 0;
+    bpf_seq_write(seq, key, scan_key_size);
+    bpf_seq_write(seq, value, scan_value_size);
+    return 0;
+}
+#endif /* __ANALYZE_MAP_SCAN_H */
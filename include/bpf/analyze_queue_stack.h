@@ -0,0 +1,54 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel space BPF program used for eBPF performance testing.
+#ifndef __ANALYZE_QUEUE_STACK_H
+#define __ANALYZE_QUEUE_STACK_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+
+// 容量由用户态在加载前通过 bpf_map__set_max_entries 调整
+struct {
+    __uint(type, BPF_MAP_TYPE_QUEUE);
+    __uint(max_entries, 1024);
+    __type(value, u64);
+} queue_map SEC(".maps");
+struct {
+    __uint(type, BPF_MAP_TYPE_STACK);
+    __uint(max_entries, 1024);
+    __type(value, u64);
+} stack_map SEC(".maps");
+
+// push满/pop空等失败次数，用户态据此判断本轮测量是否有效
+__u64 qs_errors = 0;
+
+static __always_inline int qs_push(void *map) {
+    u64 value = 1;
+    if (bpf_map_push_elem(map, &value, 0))
+        __sync_fetch_and_add(&qs_errors, 1);
+    return 0;
+}
+static __always_inline int qs_pop(void *map) {
+    u64 value;
+    if (bpf_map_pop_elem(map, &value))
+        __sync_fetch_and_add(&qs_errors, 1);
+    return 0;
+}
+static __always_inline int qs_peek(void *map) {
+    u64 value;
+    if (bpf_map_peek_elem(map, &value))
+        __sync_fetch_and_add(&qs_errors, 1);
+    return 0;
+}
+#endif /* __ANALYZE_QUEUE_STACK_H */
@@ -0,0 +1,26 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Empty program shared by the objects that time BPF_PROG_TEST_RUN.
+#ifndef __BENCH_NOP_H
+#define __BENCH_NOP_H
+
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+
+// 空程序，用来测量 BPF_PROG_TEST_RUN 自身的开销
+SEC("tc")
+int bench_nop(struct __sk_buff *skb) {
+	return 0;
+}
+
+#endif /* __BENCH_NOP_H */
@@ -17,26 +17,9 @@
 typedef unsigned int __u32;
 typedef long long unsigned int __u64;
 
-#define OPTIONS_LIST "-a"
 #define RING_BUFFER_TIMEOUT_MS 100
 #define OUTPUT_INTERVAL(SECONDS) sleep(SECONDS)
 
-#define PRINT_USAGE_ERR()                                               \
-    do {                                                                \
-        fprintf(stderr, "Please specify exactly one option from %s.\n", \
-                OPTIONS_LIST);                                          \
-        argp_state_help(state, stdout, ARGP_HELP_STD_HELP);             \
-    } while (0)
-
-#define SET_OPTION_AND_CHECK_USAGE(option, value) \
-    do {                                          \
-        if (option == 0) {                        \
-            value = true;                         \
-            option = 1;                           \
-        } else {                                  \
-            PRINT_USAGE_ERR();                    \
-        }                                         \
-    } while (0)
 #define RESERVE_RINGBUF_ENTRY(rb, e)                             \
     do {                                                         \
         typeof(e) _tmp = bpf_ringbuf_reserve(rb, sizeof(*e), 0); \
@@ -44,10 +27,43 @@ typedef long long unsigned int __u64;
             return 0;                                            \
         e = _tmp;                                                \
     } while (0)
-enum EventType {
-    NONE_TYPE,
-    EXECUTE_TEST_MAPS,
-} event_type;
+
+// LPM trie 的key，前缀长度之后紧跟地址(网络字节序)
+struct lpm_v4_key {
+    __u32 prefixlen;
+    unsigned char addr[4];
+};
+struct lpm_v6_key {
+    __u32 prefixlen;
+    unsigned char addr[16];
+};
+// 内核态LPM查找时使用的查找地址个数
+#define LPM_LOOKUP_KEYS 65536
+
+// 本地存储与按pid索引的hash对比测试中，每个CPU上累计的延迟统计
+struct ls_stat {
+    __u64 lookup_ns;
+    __u64 lookups;
+    __u64 create_ns;
+    __u64 creates;
+    __u64 create_fails;
+    // 两次连续读取时钟的耗时，用于扣除计时本身的开销
+    __u64 clock_ns;
+    __u64 clocks;
+};
+
+// arena 内开放寻址哈希表的槽位，key 为0表示空槽
+struct arena_slot {
+    __u64 key;
+    __u64 value;
+};
+// 线性探测的最大次数，内核态与用户态一致
+#define ARENA_MAX_PROBES 64
+
+// 内核态与用户态共用的槽位哈希(Fibonacci hashing)，mask 为槽位数-1
+static inline __u32 arena_slot_hash(__u64 key, __u32 mask) {
+    return (__u32)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
 
 struct common_event{
     union {
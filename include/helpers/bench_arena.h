@@ -0,0 +1,23 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// BPF arena benchmark.
+#ifndef __BENCH_ARENA_H
+#define __BENCH_ARENA_H
+
+#include <stdbool.h>
+
+// 在 BPF_MAP_TYPE_ARENA 中构建开放寻址哈希表，与 BPF_MAP_TYPE_HASH 对比
+// 内核态/用户态的插入与查找延迟及内存占用；内核或编译器不支持时跳过
+int bench_arena(volatile bool *exiting);
+
+#endif /* __BENCH_ARENA_H */
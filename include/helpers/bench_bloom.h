@@ -0,0 +1,23 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Bloom filter map benchmark.
+#ifndef __BENCH_BLOOM_H
+#define __BENCH_BLOOM_H
+
+#include <stdbool.h>
+
+// 对 BPF_MAP_TYPE_BLOOM_FILTER 在不同容量和哈希函数个数下测量
+// push/peek 开销、实际误判率，以及布隆过滤器前置对 hash 查找的收益
+int bench_bloom(volatile bool *exiting);
+
+#endif /* __BENCH_BLOOM_H */
@@ -0,0 +1,26 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Baseline vs candidate regression comparison.
+#ifndef __BENCH_COMPARE_H
+#define __BENCH_COMPARE_H
+
+// 对比两份 -o 生成的二进制结果，按阶段(map类型 × 操作等)输出中位数变化、
+// bootstrap 95% 置信区间与 Mann-Whitney U 检验的 p 值。每个阶段流式读入，
+// 最多均匀保留 65536 个样本。
+// 存在变慢超过 threshold_pct、p < alpha 且置信区间不含0的阶段时返回1，
+// 无回归返回0；基线中的阶段在候选结果中缺失或没有可比较的阶段时返回2，
+// 出错返回负值
+int bench_compare(const char *base_path, const char *cand_path,
+                  double threshold_pct, double alpha);
+
+#endif /* __BENCH_COMPARE_H */
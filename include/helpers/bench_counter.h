@@ -0,0 +1,25 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Shared counter benchmark: bpf_spin_lock vs atomics vs per-CPU values.
+#ifndef __BENCH_COUNTER_H
+#define __BENCH_COUNTER_H
+
+#include <stdbool.h>
+
+// 在1个与全部在线CPU上同时运行更新共享计数器的程序，比较 bpf_spin_lock、
+// 原子加、每CPU value 与普通递增在不同 value 大小下的吞吐与丢失的更新；
+// 另在写线程运行时测量用户态带/不带 BPF_F_LOCK 的查找与更新，
+// 统计读到更新到一半的 value 的次数
+int bench_counter(volatile bool *exiting);
+
+#endif /* __BENCH_COUNTER_H */
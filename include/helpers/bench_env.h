@@ -0,0 +1,37 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Measurement environment control and noise checks.
+#ifndef __BENCH_ENV_H
+#define __BENCH_ENV_H
+
+#include <stdbool.h>
+
+// 测量所在的CPU(默认0)，背景负载线程会避开该CPU
+void bench_env_set_cpu(int cpu);
+int bench_env_cpu(void);
+
+// 进程启动时允许运行的CPU(在任何绑核之前取样)，用于分配负载线程与
+// 多线程基准测试的工作线程
+bool bench_env_cpu_allowed(int cpu);
+
+// 低噪声测量模式: 把调用线程绑定到测量CPU，fifo_prio > 0 时切换为
+// SCHED_FIFO，mlockall 锁定当前及以后的内存，并预先触碰栈与堆，
+// 避免测量过程中出现缺页。之后创建的背景负载线程固定为 SCHED_OTHER，
+// 多线程基准测试的工作线程仅在各自独占CPU时继承 SCHED_FIFO(见 bench_util.h)
+int bench_env_control(int fifo_prio);
+
+// 检查调频策略、深度C-state、SMT兄弟线程是否繁忙、CPU是否隔离等
+// 噪声来源，逐项打印警告并写入结构化结果(bench 为 "env")
+void bench_env_check(void);
+
+#endif /* __BENCH_ENV_H */
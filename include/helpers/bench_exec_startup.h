@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Process startup benchmark: libbpf skeleton vs light skeleton.
+#ifndef __BENCH_EXEC_STARTUP_H
+#define __BENCH_EXEC_STARTUP_H
+
+#include <stdbool.h>
+
+// 反复启动与本程序同目录的 startup_probe(libbpf 骨架)与
+// startup_probe_lskel(轻量骨架)，比较二进制与共享库大小、常驻内存，
+// 以及从 exec 到进入 main、到探针附加完成的耗时
+int bench_exec_startup(volatile bool *exiting);
+
+#endif /* __BENCH_EXEC_STARTUP_H */
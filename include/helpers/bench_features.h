@@ -0,0 +1,53 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel feature probing for the benchmark matrix.
+#ifndef __BENCH_FEATURES_H
+#define __BENCH_FEATURES_H
+
+#include <bpf/libbpf.h>
+#include <stdbool.h>
+
+// 用户态 uapi 头文件可能早于这些类型，直接使用内核中的编号
+#define BENCH_MAP_TYPE_CGRP_STORAGE 32
+#define BENCH_MAP_TYPE_ARENA 33
+
+enum bench_feature_kind {
+	BENCH_FEAT_MAP,
+	BENCH_FEAT_PROG,
+	BENCH_FEAT_HELPER,
+};
+
+// 基准测试依赖的一项内核特性
+struct bench_feature {
+	enum bench_feature_kind kind;
+	// map类型或程序类型，helper 时为调用它的程序类型
+	int type;
+	int helper;
+	const char *name;
+};
+
+#define BENCH_MAP(t) {BENCH_FEAT_MAP, BPF_MAP_TYPE_##t, 0, "map:" #t}
+#define BENCH_PROG(t) {BENCH_FEAT_PROG, BPF_PROG_TYPE_##t, 0, "prog:" #t}
+#define BENCH_HELPER(p, h)                                                     \
+	{BENCH_FEAT_HELPER, BPF_PROG_TYPE_##p, BPF_FUNC_##h, "helper:" #h}
+
+// 探测结果会被缓存，重复查询不再创建map或加载程序
+bool bench_feature_supported(const struct bench_feature *f);
+bool bench_map_type_supported(int type);
+bool bench_prog_type_supported(int type);
+
+// 返回第一个当前内核不支持的特性，全部支持时返回NULL
+const struct bench_feature *
+bench_features_missing(const struct bench_feature *feats, int nr);
+
+#endif /* __BENCH_FEATURES_H */
@@ -0,0 +1,38 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Built-in background load generators.
+#ifndef __BENCH_LOAD_H
+#define __BENCH_LOAD_H
+
+#include <stdbool.h>
+
+// 解析负载描述，以逗号分隔，例如 cpu=80,mem=90%,syscall=2,cache=2:
+//   cpu=PCT[:N]    N 个(默认为除测量CPU外每个CPU一个)线程按 PCT% 占空比空转
+//   mem=SIZE|PCT%  常驻 SIZE 字节(支持k/m/g后缀)，或把系统内存使用率抬高到 PCT%
+//   syscall=N      N 个线程持续执行 getppid 系统调用
+//   cache=N[:SIZE] N 个线程以缓存行步长反复写 SIZE(默认末级缓存的2倍)字节的缓冲区
+// 格式错误返回 -EINVAL
+int bench_load_parse(const char *spec);
+bool bench_load_enabled(void);
+
+// 把调用线程绑定到测量CPU(见 bench_env.h)，负载线程绑定到其余CPU，
+// 并等待内存负载写满后返回
+int bench_load_start(volatile bool *exiting);
+
+// 负载线程是否运行在该CPU上
+bool bench_load_on_cpu(int cpu);
+
+// 停止负载线程，打印各负载实际达到的强度并写入结构化结果
+void bench_load_stop(void);
+
+#endif /* __BENCH_LOAD_H */
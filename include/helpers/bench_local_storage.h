@@ -0,0 +1,23 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Local storage vs pid-keyed hash benchmark.
+#ifndef __BENCH_LOCAL_STORAGE_H
+#define __BENCH_LOCAL_STORAGE_H
+
+#include <stdbool.h>
+
+// 在持续 fork/exec/exit 的负载下，对比任务/cgroup本地存储与按pid索引的
+// hash(是否在退出时清理)、LRU hash 的查找/创建延迟、残留条目和内存占用
+int bench_local_storage(volatile bool *exiting);
+
+#endif /* __BENCH_LOCAL_STORAGE_H */
@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// LPM trie map benchmark.
+#ifndef __BENCH_LPM_H
+#define __BENCH_LPM_H
+
+#include <stdbool.h>
+
+// 按接近真实路由表的前缀长度分布向 BPF_MAP_TYPE_LPM_TRIE 写入 1K-1M 条
+// IPv4/IPv6 前缀，测量按匹配前缀长度分组的内核态/用户态查找延迟，
+// 以及持续增删(churn)时的增删开销与并发查找延迟
+int bench_lpm(volatile bool *exiting);
+
+#endif /* __BENCH_LPM_H */
@@ -0,0 +1,23 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Map-in-map indirection benchmark.
+#ifndef __BENCH_MAP_IN_MAP_H
+#define __BENCH_MAP_IN_MAP_H
+
+#include <stdbool.h>
+
+// 以四种基础map为内层map，分别装入 ARRAY_OF_MAPS/HASH_OF_MAPS，测量内核态
+// 两级查找相对直接查找的额外延迟，以及内核读者运行时用户态替换内层map的开销
+int bench_map_in_map(volatile bool *exiting);
+
+#endif /* __BENCH_MAP_IN_MAP_H */
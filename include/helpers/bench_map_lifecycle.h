@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Map creation and teardown cost benchmark.
+#ifndef __BENCH_MAP_LIFECYCLE_H
+#define __BENCH_MAP_LIFECYCLE_H
+
+#include <stdbool.h>
+
+// 对每种map类型与标志组合，在1K到16M条目下计时 bpf_map_create、
+// 首次填满、close 以及关闭后内核(RCU宽限期与工作队列)真正释放内存的
+// 耗时，并按容量拟合固定开销与每条目开销
+int bench_map_lifecycle(volatile bool *exiting);
+
+#endif /* __BENCH_MAP_LIFECYCLE_H */
@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Per-map memory footprint benchmark.
+#ifndef __BENCH_MAP_MEMORY_H
+#define __BENCH_MAP_MEMORY_H
+
+#include <stdbool.h>
+
+// 对每种map类型与标志组合，在不同容量与value大小下创建并填满map，
+// 读取 fdinfo 中的 memlock 与 map_extra，并测量创建和填充前后所在
+// memory cgroup 的用量变化，换算为每个条目的字节数
+int bench_map_memory(volatile bool *exiting);
+
+#endif /* __BENCH_MAP_MEMORY_H */
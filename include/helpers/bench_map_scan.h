@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Full-map scan benchmark.
+#ifndef __BENCH_MAP_SCAN_H
+#define __BENCH_MAP_SCAN_H
+
+#include <stdbool.h>
+
+// 对每种map类型在不同容量与填充率下，分别用 get_next_key+lookup 循环、
+// lookup_batch 与 bpf_iter 程序(经 seq 文件读取)完整遍历一次map，
+// 比较每秒遍历的条目数与每条目消耗的CPU时间
+int bench_map_scan(volatile bool *exiting);
+
+#endif /* __BENCH_MAP_SCAN_H */
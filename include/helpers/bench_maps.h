@@ -0,0 +1,23 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Comparing lookup/insert/delete cost of the basic map types.
+#ifndef __BENCH_MAPS_H
+#define __BENCH_MAPS_H
+
+#include <stdbool.h>
+
+// 每轮对 hash/array/percpu_array/percpu_hash 各执行1023次查找、插入、
+// 删除并打印总耗时，轮数与预热由 bench_rounds.h 控制
+int bench_maps(volatile bool *exiting);
+
+#endif /* __BENCH_MAPS_H */
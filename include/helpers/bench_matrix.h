@@ -0,0 +1,27 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Declarative benchmark matrix runner.
+#ifndef __BENCH_MATRIX_H
+#define __BENCH_MATRIX_H
+
+#include <stdbool.h>
+
+// 按配置文件(格式见 conf/matrix.conf)声明的 map类型 × 标志 × 容量 ×
+// key/value大小 × key分布 × 线程数 × 操作比例 的笛卡尔积逐一测量用户态
+// 操作延迟与吞吐。整个矩阵在同一进程内运行，相邻配置的map几何参数
+// (类型、标志、容量、key/value大小)不变时复用已创建的map，只在几何参数
+// 变化时重新创建。配置文件(-f FILE)由注册表的 setup 在运行前解析，
+// 有误时不运行任何配置，返回负的错误码
+int bench_matrix(volatile bool *exiting);
+
+#endif /* __BENCH_MATRIX_H */
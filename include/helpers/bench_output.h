@@ -0,0 +1,67 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Structured CSV / JSON-lines output with run metadata.
+#ifndef __BENCH_OUTPUT_H
+#define __BENCH_OUTPUT_H
+
+#include <linux/types.h>
+#include <math.h>
+#include <stdbool.h>
+
+enum bench_field_type {
+	BENCH_F_STR,
+	BENCH_F_U64,
+	BENCH_F_I64,
+	// NAN 表示不适用，CSV 中输出为空，JSON 中输出为 null
+	BENCH_F_F64,
+};
+
+// 一条结果记录中的一个具名字段
+struct bench_field {
+	const char *key;
+	enum bench_field_type type;
+	union {
+		const char *s;
+		__u64 u;
+		__s64 i;
+		double f;
+	};
+};
+
+#define BF_STR(k, v) {.key = (k), .type = BENCH_F_STR, .s = (v)}
+#define BF_U64(k, v) {.key = (k), .type = BENCH_F_U64, .u = (v)}
+#define BF_I64(k, v) {.key = (k), .type = BENCH_F_I64, .i = (v)}
+#define BF_F64(k, v) {.key = (k), .type = BENCH_F_F64, .f = (v)}
+
+// 打开 CSV 和/或 JSON-lines 输出(路径为NULL表示不输出)，同时采集
+// 内核版本、CPU型号、CPU个数、调频策略、JIT、git版本等元数据。
+// CSV 每个基准测试一个文件: csv_path 去掉 .csv 后缀再加 .<bench>.csv
+int bench_output_open(const char *csv_path, const char *json_path);
+void bench_output_close(void);
+bool bench_output_enabled(void);
+// 记录本次运行的背景负载描述(见 bench_load.h)，写入每条记录的 load 字段
+void bench_output_set_load(const char *spec);
+
+// 写入一条记录，每条记录都带有完整的运行元数据；CSV 的列为基准测试
+// 注册的 schema，缺少的字段留空，不在 schema 中的字段只写入 JSON
+void bench_output(const char *bench, const struct bench_field *fields, int nr);
+
+#define BENCH_OUTPUT(bench, ...)                                               \
+	do {                                                                       \
+		if (bench_output_enabled()) {                                          \
+			const struct bench_field __f[] = {__VA_ARGS__};                    \
+			bench_output(bench, __f, sizeof(__f) / sizeof(__f[0]));           \
+		}                                                                      \
+	} while (0)
+
+#endif /* __BENCH_OUTPUT_H */
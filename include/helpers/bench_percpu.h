@@ -0,0 +1,55 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Reduction of per-CPU map values read from user space.
+#ifndef __BENCH_PERCPU_H
+#define __BENCH_PERCPU_H
+
+#include <linux/types.h>
+#include <stdbool.h>
+
+// 对每CPU值的归约方式。直方图合并即按桶求和(width 为桶数)
+enum bench_percpu_op {
+	BENCH_PERCPU_SUM,
+	BENCH_PERCPU_MAX,
+};
+
+// 归约的实现方式，SIMD 实现在运行时按CPU支持的指令集选用
+enum bench_percpu_impl {
+	BENCH_PERCPU_SCALAR, // 逐个元素，禁止编译器自动向量化
+	BENCH_PERCPU_AUTO,   // 同样的循环，由编译器按默认目标自动向量化
+	BENCH_PERCPU_AVX2,
+	BENCH_PERCPU_AVX512,
+	BENCH_PERCPU_NEON,
+	BENCH_PERCPU_NR_IMPLS,
+};
+
+const char *bench_percpu_impl_name(enum bench_percpu_impl impl);
+// 当前编译目标与CPU是否能运行该实现
+bool bench_percpu_impl_supported(enum bench_percpu_impl impl);
+// 可用的最快实现
+enum bench_percpu_impl bench_percpu_best(void);
+
+// values 与 lookup/lookup_batch 返回的布局一致: nr_keys 个key依次排列，
+// 每个key有 nr_cpus 个slot，每个slot为 width 个u64(value 按8字节对齐)。
+// 把每个key的 nr_cpus 个slot按元素归约到 out[key * width + i]
+void bench_percpu_reduce_impl(enum bench_percpu_impl impl,
+                              enum bench_percpu_op op, const __u64 *values,
+                              __u32 nr_keys, __u32 nr_cpus, __u32 width,
+                              __u64 *out);
+
+// 使用 bench_percpu_best() 选出的实现，CPU很少时用编译器向量化的循环
+void bench_percpu_reduce(enum bench_percpu_op op, const __u64 *values,
+                         __u32 nr_keys, __u32 nr_cpus, __u32 width,
+                         __u64 *out);
+
+#endif /* __BENCH_PERCPU_H */
@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Per-CPU value aggregation benchmark.
+#ifndef __BENCH_PERCPU_AGG_H
+#define __BENCH_PERCPU_AGG_H
+
+#include <stdbool.h>
+
+// 在8到512个CPU的合成每CPU数据上，比较标量循环、编译器自动向量化与
+// AVX2/AVX-512/NEON 实现对一批key做求和、取最大值与直方图合并的耗时，
+// 再在本机的 percpu_array 上比较 lookup_batch 与归约各自的每key开销
+int bench_percpu_agg(volatile bool *exiting);
+
+#endif /* __BENCH_PERCPU_AGG_H */
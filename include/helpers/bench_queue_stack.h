@@ -0,0 +1,23 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Queue and stack map benchmark.
+#ifndef __BENCH_QUEUE_STACK_H
+#define __BENCH_QUEUE_STACK_H
+
+#include <stdbool.h>
+
+// 对 BPF_MAP_TYPE_QUEUE/STACK 在不同容量、填充率、生产者数量下
+// 分别测量内核态与用户态的 push/pop/peek 吞吐与延迟
+int bench_queue_stack(volatile bool *exiting);
+
+#endif /* __BENCH_QUEUE_STACK_H */
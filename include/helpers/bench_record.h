@@ -0,0 +1,112 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Binary result format and its memory-mapped reader.
+#ifndef __BENCH_RECORD_H
+#define __BENCH_RECORD_H
+
+#include <linux/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// 文件格式(小端、所有记录8字节对齐):
+//   bench_rec_file_header
+//   bench_rec_hdr + 负载, bench_rec_hdr + 负载, ...
+// 新增字段只能追加在结构体末尾并提升版本号，读取方按 header_size/size 跳过
+#define BENCH_REC_MAGIC "EBPFPRF"
+#define BENCH_REC_VERSION 1
+// 单条样本记录最多携带的样本数，更多的样本拆成多条记录
+#define BENCH_REC_MAX_SAMPLES 65536
+// 对数-线性直方图: 每个2的幂区间再等分为8份，覆盖全部 u64
+#define BENCH_HIST_SUB_BITS 3
+#define BENCH_HIST_BUCKETS 496
+
+struct bench_rec_file_header {
+	char magic[8];
+	__u32 version;
+	__u32 header_size;
+	// 运行开始时刻(CLOCK_REALTIME)
+	__u64 start_ns;
+	__u32 nr_cpus;
+	__u32 reserved;
+	char kernel[128];
+	char machine[32];
+	char command[96];
+};
+
+enum bench_rec_type {
+	// 阶段名，样本与直方图通过阶段id引用
+	BENCH_REC_PHASE = 1,
+	BENCH_REC_SAMPLES = 2,
+	BENCH_REC_HIST = 3,
+};
+
+struct bench_rec_hdr {
+	__u32 type;
+	// 含本头部在内的字节数
+	__u32 size;
+};
+
+struct bench_rec_phase {
+	struct bench_rec_hdr hdr;
+	__u32 id;
+	__u32 reserved;
+	// 记录时刻(CLOCK_MONOTONIC)
+	__u64 ts_ns;
+	char name[112];
+};
+
+struct bench_rec_samples {
+	struct bench_rec_hdr hdr;
+	__u32 phase;
+	__u32 nr;
+	__u64 ts_ns;
+	// 单位ns，按测量顺序保存
+	__u64 values[];
+};
+
+struct bench_rec_hist {
+	struct bench_rec_hdr hdr;
+	__u32 phase;
+	__u32 nr_buckets;
+	__u64 count;
+	__u64 min;
+	__u64 max;
+	__u64 sum;
+	__u64 counts[BENCH_HIST_BUCKETS];
+};
+
+// 写入端: 打开后所有 bench_record_* 调用写入文件，未打开时为空操作
+int bench_record_open(const char *path, const char *command);
+void bench_record_close(void);
+bool bench_record_enabled(void);
+// 写入一组原始样本及其直方图
+void bench_record_samples(const char *phase, const __u64 *samples, size_t nr);
+
+// 值 v 所在的直方图桶，以及桶的下界
+int bench_hist_bucket(__u64 v);
+__u64 bench_hist_bucket_low(int idx);
+
+// 读取端: mmap 整个文件后原地遍历记录，不做拷贝和解析
+struct bench_rec_reader {
+	const void *base;
+	size_t size;
+	size_t off;
+	const struct bench_rec_file_header *header;
+};
+
+int bench_rec_reader_open(struct bench_rec_reader *r, const char *path);
+// 返回下一条记录，到达文件末尾或遇到损坏的记录时返回NULL
+const struct bench_rec_hdr *bench_rec_next(struct bench_rec_reader *r);
+void bench_rec_reader_close(struct bench_rec_reader *r);
+
+#endif /* __BENCH_RECORD_H */
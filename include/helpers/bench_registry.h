@@ -0,0 +1,83 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Benchmark registry: each benchmark describes itself in its own file.
+#ifndef __BENCH_REGISTRY_H
+#define __BENCH_REGISTRY_H
+
+#include "bench_features.h"
+#include <stdbool.h>
+
+// 最多可注册的基准测试个数
+#define BENCH_MAX 64
+// 没有短选项的基准测试使用的长选项 key 起始值(argp 要求大于255)
+#define BENCH_LONG_KEY_BASE 0x1000
+
+// 一个基准测试的描述。新增基准测试只需在自己的 .c 文件中用
+// BENCH_REGISTER 定义描述，Makefile 会自动编译 src/helpers 下的文件，
+// 无需修改 main()
+struct bench_desc {
+	// 长选项名，同时是结构化结果中的 bench 字段和 -p 中的名字
+	const char *name;
+	// 短选项字符，0 表示只提供 --name
+	int key;
+	// 选项参数名(如 "FILE")，NULL 表示不带参数
+	const char *arg;
+	const char *doc;
+	// 依赖的内核特性，缺少任何一项时跳过该基准测试
+	const struct bench_feature *feats;
+	int nr_feats;
+	// 结构化结果中除元数据外的字段，以逗号分隔
+	const char *schema;
+	// setup 在所有基准测试运行前调用(用于检查参数)，teardown 在运行后
+	// 调用，均可为NULL；run 返回负的错误码
+	int (*setup)(const char *arg);
+	int (*run)(volatile bool *exiting);
+	void (*teardown)(void);
+};
+
+#define BENCH_ARRAY_SIZE(x) (int)(sizeof(x) / sizeof((x)[0]))
+
+// 在程序启动时(main 之前)注册 bench_desc_<id>，用法:
+//   BENCH_REGISTER(bloom) = { .name = "bloom", ... };
+#define BENCH_REGISTER(id)                                                     \
+	static const struct bench_desc bench_desc_##id;                            \
+	__attribute__((constructor)) static void bench_register_##id(void) {      \
+		bench_register(&bench_desc_##id);                                      \
+	}                                                                          \
+	static const struct bench_desc bench_desc_##id
+
+void bench_register(const struct bench_desc *b);
+
+// 按名字排序后的全部基准测试
+int bench_count(void);
+const struct bench_desc *bench_at(int i);
+const struct bench_desc *bench_find(const char *name);
+// 按选项 key 查找，key 可以是短选项字符或 BENCH_LONG_KEY_BASE + 序号
+const struct bench_desc *bench_find_key(int key);
+int bench_option_key(const struct bench_desc *b);
+// 结构化结果字段是否在声明的 schema 中
+bool bench_schema_has(const struct bench_desc *b, const char *field);
+
+// 按命令行顺序选择要运行的基准测试，重复选择返回 -EEXIST
+int bench_select(const struct bench_desc *b, const char *arg);
+int bench_nr_selected(void);
+
+// 依次对所选基准测试调用 setup，任一失败时返回其错误码
+int bench_setup_selected(void);
+// 依次运行所选基准测试: 缺少内核特性的跳过(不视为失败)，出错或收到
+// 中断时不再运行后续基准测试
+int bench_run_selected(volatile bool *exiting);
+// 对 setup 成功(或没有 setup)的基准测试调用 teardown
+void bench_teardown_selected(void);
+
+#endif /* __BENCH_REGISTRY_H */
@@ -0,0 +1,49 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Round controller: warmup, round/time budget and outlier flagging.
+#ifndef __BENCH_ROUNDS_H
+#define __BENCH_ROUNDS_H
+
+#include <linux/types.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// 修正z分数(0.6745*|x-中位数|/MAD)超过该值的轮次标记为离群
+#define BENCH_OUTLIER_Z 3.5
+
+// 目前只有按轮运行的 -a(bench_maps)使用该控制器，-w/-N 与结束汇总只作用于 -a；
+// 其他基准测试的轮数由各自的参数决定，-T 通过 SIGALRM 约束所有基准测试
+
+// warmup 轮只执行不记录；rounds 为0表示不限轮数，budget_s 为0表示不限时间
+void bench_rounds_init(unsigned int warmup, unsigned int rounds,
+                       unsigned int budget_s);
+
+// 开始一次按轮运行的基准测试: 清空轮次、起始时间与结束原因，保留 init 的参数
+void bench_rounds_start(void);
+
+// 开始下一轮，返回 false 表示应当结束: 被中断、达到轮数，或按上一轮
+// 耗时估计下一轮会超出时间预算
+bool bench_rounds_next(volatile bool *exiting);
+
+// 当前是否为预热轮，以及当前计入结果的轮次编号(从1开始)
+bool bench_rounds_warmup(void);
+unsigned int bench_rounds_current(void);
+
+// 记录本轮某阶段的耗时，用于结束时按 MAD 标记离群轮次(不删除任何数据)
+void bench_rounds_add(const char *phase, __u64 ns);
+
+// 打印轮数、耗时、结束原因以及各阶段的离群轮次，并写入结构化结果
+void bench_rounds_summary(FILE *out);
+void bench_rounds_free(void);
+
+#endif /* __BENCH_ROUNDS_H */
@@ -0,0 +1,63 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Per-object BPF skeleton open/load/attach cost.
+#ifndef __BENCH_SKEL_H
+#define __BENCH_SKEL_H
+
+#include "bench_util.h"
+#include <stdio.h>
+
+// 每个基准测试族有自己的BPF对象(src/bpf/<name>.bpf.c)，只在该基准测试
+// 运行时打开和加载。以下宏包装骨架的 open/load/attach，记录耗时后返回
+// 原函数的结果，例如 skel = BENCH_SKEL_OPEN(bloom);
+#define BENCH_SKEL_OPEN(name)                                                  \
+	({                                                                         \
+		__u64 _start = bench_now_ns();                                         \
+		struct name##_bpf *_skel = name##_bpf__open();                         \
+		bench_skel_time(#name, BENCH_SKEL_PHASE_OPEN,                          \
+		                bench_now_ns() - _start);                              \
+		_skel;                                                                 \
+	})
+#define BENCH_SKEL_LOAD(name, skel)                                            \
+	({                                                                         \
+		__u64 _start = bench_now_ns();                                         \
+		int _err = name##_bpf__load(skel);                                     \
+		if (!_err)                                                             \
+			bench_skel_time(#name, BENCH_SKEL_PHASE_LOAD,                      \
+			                bench_now_ns() - _start);                          \
+		_err;                                                                  \
+	})
+#define BENCH_SKEL_ATTACH(name, skel)                                          \
+	({                                                                         \
+		__u64 _start = bench_now_ns();                                         \
+		int _err = name##_bpf__attach(skel);                                   \
+		if (!_err)                                                             \
+			bench_skel_time(#name, BENCH_SKEL_PHASE_ATTACH,                    \
+			                bench_now_ns() - _start);                          \
+		_err;                                                                  \
+	})
+
+enum bench_skel_phase {
+	BENCH_SKEL_PHASE_OPEN,
+	BENCH_SKEL_PHASE_LOAD,
+	BENCH_SKEL_PHASE_ATTACH,
+	BENCH_SKEL_NR_PHASES,
+};
+
+// 记录一次 open/load/attach 的耗时(ns)，写入二进制结果
+// (phase 为 startup/<对象>/<阶段>)与结构化结果(bench 为 startup)
+void bench_skel_time(const char *obj, enum bench_skel_phase phase, __u64 ns);
+// 打印各对象首次与平均的 open/load/attach 耗时，没有加载过对象时不打印
+void bench_skel_summary(FILE *out);
+
+#endif /* __BENCH_SKEL_H */
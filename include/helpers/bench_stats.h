@@ -0,0 +1,64 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Streaming statistics engine.
+#ifndef __BENCH_STATS_H
+#define __BENCH_STATS_H
+
+#include <linux/types.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// DDSketch 的相对误差，分位数估计值与真实值的相对偏差不超过该值
+#define BENCH_SKETCH_ALPHA 0.01
+// 桶个数，alpha=0.01 时可覆盖 1ns 到数小时
+#define BENCH_SKETCH_BINS 2048
+
+// 汇总表的标题。maps 的指标是一轮1023次操作的总耗时，其余为逐次样本
+#define BENCH_STATS_TITLE                                                      \
+	"Latency summary (ns; per sample, maps/* per round of 1023 ops):"
+
+// 一个指标的流式统计: Welford 均值/方差、最值和 DDSketch 分位数，
+// 内存占用固定，与样本数无关
+struct bench_stat {
+	// 与各基准测试的 phase 缓冲区一样长，避免截断后不同指标合并
+	char name[96];
+	__u64 n;
+	double mean;
+	double m2;
+	__u64 min;
+	__u64 max;
+	// 值为0的样本不落在对数桶内，单独计数
+	__u64 zeros;
+	__u64 bins[BENCH_SKETCH_BINS];
+};
+
+// 按名字获取指标，不存在时创建，失败返回NULL
+struct bench_stat *bench_stats_get(const char *name);
+void bench_stat_add(struct bench_stat *s, __u64 v);
+// 把一批样本加入名为 name 的指标
+void bench_stats_add_samples(const char *name, const __u64 *samples,
+                             size_t nr);
+double bench_stat_stddev(const struct bench_stat *s);
+// q 取值 [0, 1]
+double bench_stat_quantile(const struct bench_stat *s, double q);
+
+// 按创建顺序打印所有指标的汇总表
+void bench_stats_print(FILE *f, const char *title);
+void bench_stats_free(void);
+
+// SIGUSR1 的处理函数: 请求长时间运行的基准测试打印当前的汇总；
+// 基准测试在每轮结束时取走请求(取走后清除)
+void bench_stats_request(int sig);
+bool bench_stats_take_request(void);
+
+#endif /* __BENCH_STATS_H */
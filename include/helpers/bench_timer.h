@@ -0,0 +1,96 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Low-overhead cycle counter timing for per-operation samples.
+#ifndef __BENCH_TIMER_H
+#define __BENCH_TIMER_H
+
+#include <linux/types.h>
+#include <stdbool.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// 校准结果: 计数器是否可用、每个计数对应的ns，以及一次计时本身的开销
+struct bench_timer_cal {
+	bool counter;
+	double ns_per_tick;
+	double overhead_ns;
+};
+
+extern struct bench_timer_cal bench_timer_cal;
+
+// 检测 TSC 是否恒定且被内核用作时钟源(arm64 为 cntvct)，对照
+// CLOCK_MONOTONIC_RAW 校准频率并测量计时开销；计数器不可用时
+// 退回 CLOCK_MONOTONIC。应在绑核之后调用，结果写入结构化输出
+void bench_timer_init(void);
+// 当前计时源名称，"tsc"、"cntvct" 或 "clock_gettime"
+const char *bench_timer_name(void);
+
+static inline __u64 bench_timer_clock(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 计时起点: 等之前的指令执行完再读计数器，且之后的指令不会提前执行
+static inline __u64 bench_timer_start(void) {
+	if (!bench_timer_cal.counter)
+		return bench_timer_clock();
+#if defined(__x86_64__) || defined(__i386__)
+	__u64 t;
+
+	_mm_lfence();
+	t = __rdtsc();
+	_mm_lfence();
+	return t;
+#elif defined(__aarch64__)
+	__u64 t;
+
+	asm volatile("isb; mrs %0, cntvct_el0; isb" : "=r"(t)::"memory");
+	return t;
+#else
+	return bench_timer_clock();
+#endif
+}
+
+// 计时终点: rdtscp 等被测指令完成后才读计数器
+static inline __u64 bench_timer_stop(void) {
+	if (!bench_timer_cal.counter)
+		return bench_timer_clock();
+#if defined(__x86_64__) || defined(__i386__)
+	unsigned int aux;
+	__u64 t = __rdtscp(&aux);
+
+	_mm_lfence();
+	return t;
+#elif defined(__aarch64__)
+	__u64 t;
+
+	asm volatile("isb; mrs %0, cntvct_el0; isb" : "=r"(t)::"memory");
+	return t;
+#else
+	return bench_timer_clock();
+#endif
+}
+
+// 把一对起止读数换算成ns并扣除计时开销，结果不小于0
+static inline __u64 bench_timer_ns(__u64 start, __u64 stop) {
+	double ns = (stop - start) * bench_timer_cal.ns_per_tick -
+	            bench_timer_cal.overhead_ns;
+
+	return ns > 0 ? (__u64)(ns + 0.5) : 0;
+}
+
+#endif /* __BENCH_TIMER_H */
@@ -0,0 +1,85 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// User space helpers shared by the map benchmarks.
+#ifndef __BENCH_UTIL_H
+#define __BENCH_UTIL_H
+
+#include <bpf/libbpf.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+// BPF_PROG_TEST_RUN 输入的伪造报文长度(>= ETH_HLEN)
+#define BENCH_PKT_SIZE 64
+
+// 单次测量的延迟统计(单位: ns)
+struct bench_lat {
+	double avg;
+	double p50;
+	double p99;
+};
+
+static inline __u64 bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 只加载obj中指定名字的程序，其余程序禁用autoload
+void bench_autoload_only(struct bpf_object *obj, const char *const *names,
+                         int nr_names);
+
+// 当前内核不支持的map类型不再创建、程序类型不再加载，避免整个骨架加载失败
+void bench_skip_unsupported(struct bpf_object *obj);
+
+// 从 /proc/self/fdinfo 读取一个数值字段(十进制或0x开头的十六进制)，
+// 失败返回-1
+long long bench_fdinfo_field(int fd, const char *field);
+// 从 /proc/self/fdinfo 读取map的memlock字节数，失败返回-1
+long long bench_map_memlock(int map_fd);
+
+// 系统当前可用内存(/proc/meminfo 的 MemAvailable，字节)，读取失败返回0
+__u64 bench_mem_available(void);
+
+// 本进程所在 memory cgroup 的用量(字节): v2 为 memory.current，v1 为只统计
+// 内核内存的 memory.kmem.usage_in_bytes；处于根cgroup或未挂载时返回-1。
+// 内核按批(64页)预扣用量，小的差值只能精确到这一粒度
+long long bench_memcg_usage(void);
+// 所用的用量文件路径，不可用时为NULL
+const char *bench_memcg_path(void);
+// 关闭的map在RCU宽限期后由工作队列释放，轮询等待用量稳定，
+// 避免上一个map的释放计入下一次测量
+void bench_memcg_settle(void);
+
+// 通过 BPF_PROG_TEST_RUN 执行 repeat 次 tc 程序，返回内核统计的单次平均耗时
+int bench_prog_run(int prog_fd, int repeat, __u64 *avg_ns);
+
+// 让以 attr 创建的线程使用普通调度策略(SCHED_OTHER)，而不是继承
+// 调用线程(-F 时为 SCHED_FIFO)的策略
+void bench_attr_sched_other(pthread_attr_t *attr);
+
+// 对逐次延迟采样求平均值与分位数，会对 samples 原地排序；
+// phase 非空时先把原始样本写入二进制结果文件(见 bench_record.h)
+void bench_lat_summarize(const char *phase, __u64 *samples, size_t nr,
+                         struct bench_lat *lat);
+
+// 启动 nr 个线程同时执行 fn(ctxs[i])，返回整体墙钟耗时。线程依次绑定到
+// 测量CPU(-C)及其余没有背景负载的CPU，CPU不够时轮流共用。每个线程独占
+// 一个CPU时继承调用线程的调度策略(-F 时为 SCHED_FIFO)，共用CPU时改为
+// SCHED_OTHER，避免同一CPU上的 FIFO 线程互相饿死；
+// 线程创建失败时回收已创建的线程并返回负的错误码
+int bench_run_threads(int nr, void *(*fn)(void *), void *ctxs,
+                      size_t ctx_size, __u64 *wall_ns);
+
+#endif /* __BENCH_UTIL_H */
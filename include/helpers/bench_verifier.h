@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// BPF program load and verifier cost benchmark.
+#ifndef __BENCH_VERIFIER_H
+#define __BENCH_VERIFIER_H
+
+#include <stdbool.h>
+
+// 运行时生成复杂度递增的程序(map操作数、分支数、有界循环/展开/bpf_loop、
+// 子程序数)，测量加载墙钟耗时、校验器耗时、处理的指令数与状态数，
+// 以及JIT后的镜像大小
+int bench_verifier(volatile bool *exiting);
+
+#endif /* __BENCH_VERIFIER_H */
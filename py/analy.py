@@ -1,29 +1,69 @@
+import os
+import sys
+
 import pandas as pd
 import matplotlib.pyplot as plt
 
-# 步骤 1: 将 .txt 文件转换为 .csv 文件
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from bench_record import RecordFile
+
+input_bin_file = './results.bin'  # ebpf_performance -o 生成的二进制结果
 input_txt_file = './output.txt'  # 你的 .txt 文件路径
 output_csv_file = './data.csv'  # 输出 .csv 文件路径
 
-# 读取 .txt 文件内容并写入 .csv 文件
-with open(input_txt_file, 'r') as txt_file:
-    lines = txt_file.readlines()
-
-# 写入 .csv 文件
-with open(output_csv_file, 'w') as csv_file:
-    for line in lines:
-        # 替换多余空格为逗号，准备写入到 .csv 文件
-        formatted_line = ','.join(line.split())
-        csv_file.write(formatted_line + '\n')
-
-# 步骤 2: 读取 .csv 文件并进行数据分析
-data = pd.read_csv(output_csv_file, header=None)
-
-# 给列命名，每三个数据为一组，分别对应 lookup、insert、delete 操作
-data.columns = ['hash_lookup', 'hash_insert', 'hash_delete',
-                'array_lookup', 'array_insert', 'array_delete',
-                'percpu_array_lookup', 'percpu_array_insert', 'percpu_array_delete',
-                'percpu_hash_lookup', 'percpu_hash_insert', 'percpu_hash_delete']
+input_json_file = './results.json'  # ebpf_performance -j 生成的结构化结果
+
+# 列名取自程序自身的输出(JSON 字段、二进制阶段名或文本表头)，不再按位置硬编码
+
+
+def is_number(text):
+    try:
+        float(text)
+        return True
+    except ValueError:
+        return False
+
+
+if os.path.exists(input_json_file):
+    # 步骤 1: 结构化结果中每行带有 map 与 op 字段，按"map_op"透视为列
+    rows = pd.read_json(input_json_file, lines=True)
+    rows = rows[rows['bench'] == 'maps']
+    rows['column'] = rows['map'] + '_' + rows['op']
+    rows['round'] = rows.groupby('column').cumcount()
+    data = rows.pivot(index='round', columns='column',
+                      values='elapsed_ns').dropna() / 1e9
+    data.to_csv(output_csv_file, index=False)
+elif os.path.exists(input_bin_file):
+    # 步骤 1: 直接从二进制结果中按阶段取出样本(ns)，换算为秒
+    with RecordFile(input_bin_file) as rec:
+        samples = rec.samples_by_phase()
+        columns = [p[len('maps/'):] for p in samples if p.startswith('maps/')]
+        nr = min(len(samples['maps/' + c]) for c in columns)
+        data = pd.DataFrame({c: samples['maps/' + c][:nr] / 1e9
+                             for c in columns})
+    data.to_csv(output_csv_file, index=False)
+else:
+    # 步骤 1: 将 .txt 文件转换为 .csv 文件，第一行非数字的行为表头
+    with open(input_txt_file, 'r') as txt_file:
+        lines = txt_file.readlines()
+
+    columns = None
+    with open(output_csv_file, 'w') as csv_file:
+        for line in lines:
+            fields = line.split()
+            if columns is None:
+                if fields and not any(is_number(f) for f in fields):
+                    columns = fields
+                    csv_file.write(','.join(columns) + '\n')
+                continue
+            # 跳过程序退出时打印的汇总表等非数据行
+            if len(fields) != len(columns) or not all(map(is_number, fields)):
+                continue
+            # 替换多余空格为逗号，准备写入到 .csv 文件
+            csv_file.write(','.join(fields) + '\n')
+
+    # 步骤 2: 读取 .csv 文件并进行数据分析
+    data = pd.read_csv(output_csv_file)
 
 # 计算每种 map 类型的平均操作时间
 avg_hash = data[['hash_lookup', 'hash_insert', 'hash_delete']].mean()
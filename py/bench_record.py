@@ -0,0 +1,101 @@
+# 读取 ebpf_performance -o 生成的二进制结果文件(格式见 include/helpers/bench_record.h)
+# 整个文件通过 mmap 映射，样本以 numpy 数组视图的方式直接引用文件内容，不做文本解析
+import mmap
+import struct
+
+import numpy as np
+
+MAGIC = b"EBPFPRF\0"
+FILE_HEADER = struct.Struct("<8sIIQII128s32s96s")
+REC_HDR = struct.Struct("<II")
+REC_PHASE = struct.Struct("<IIQ112s")
+REC_SAMPLES = struct.Struct("<IIQ")
+REC_HIST = struct.Struct("<IIQQQQ")
+
+REC_TYPE_PHASE = 1
+REC_TYPE_SAMPLES = 2
+REC_TYPE_HIST = 3
+
+HIST_SUB_BITS = 3
+
+
+def _cstr(raw):
+    return raw.split(b"\0", 1)[0].decode(errors="replace")
+
+
+def hist_bucket_low(idx):
+    """直方图桶的下界(ns)，与 bench_hist_bucket_low() 一致"""
+    if idx < (1 << HIST_SUB_BITS):
+        return idx
+    msb = (idx >> HIST_SUB_BITS) + HIST_SUB_BITS - 1
+    sub = idx & ((1 << HIST_SUB_BITS) - 1)
+    return (1 << msb) | (sub << (msb - HIST_SUB_BITS))
+
+
+class RecordFile:
+    def __init__(self, path):
+        self._file = open(path, "rb")
+        self._mm = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, self.version, self.header_size, self.start_ns, self.nr_cpus,
+         _, kernel, machine, command) = FILE_HEADER.unpack_from(self._mm, 0)
+        if magic != MAGIC or self.header_size < FILE_HEADER.size:
+            raise ValueError("%s is not an ebpf_performance result file" % path)
+        self.kernel = _cstr(kernel)
+        self.machine = _cstr(machine)
+        self.command = _cstr(command)
+        self.phases = {}
+
+    def close(self):
+        self._mm.close()
+        self._file.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def records(self):
+        """依次返回 (类型, 负载偏移, 负载长度)，遇到不完整的记录时停止"""
+        off, size = self.header_size, len(self._mm)
+        while off + REC_HDR.size <= size:
+            rtype, rsize = REC_HDR.unpack_from(self._mm, off)
+            if rsize < REC_HDR.size or off + rsize > size:
+                break
+            if rtype == REC_TYPE_PHASE:
+                pid, _, _, name = REC_PHASE.unpack_from(self._mm,
+                                                        off + REC_HDR.size)
+                self.phases[pid] = _cstr(name)
+            yield rtype, off + REC_HDR.size, rsize - REC_HDR.size
+            off += (rsize + 7) & ~7
+
+    def samples(self):
+        """依次返回 (阶段名, 样本数组)，数组直接引用映射的文件内容"""
+        for rtype, off, _ in self.records():
+            if rtype != REC_TYPE_SAMPLES:
+                continue
+            phase, nr, _ = REC_SAMPLES.unpack_from(self._mm, off)
+            values = np.frombuffer(self._mm, dtype="<u8", count=nr,
+                                   offset=off + REC_SAMPLES.size)
+            yield self.phases.get(phase, str(phase)), values
+
+    def histograms(self):
+        """依次返回 (阶段名, 统计字典)，counts 为各桶的计数数组"""
+        for rtype, off, _ in self.records():
+            if rtype != REC_TYPE_HIST:
+                continue
+            phase, nr_buckets, count, vmin, vmax, vsum = REC_HIST.unpack_from(
+                self._mm, off)
+            counts = np.frombuffer(self._mm, dtype="<u8", count=nr_buckets,
+                                   offset=off + REC_HIST.size)
+            yield self.phases.get(phase, str(phase)), {
+                "count": count, "min": vmin, "max": vmax, "sum": vsum,
+                "counts": counts,
+            }
+
+    def samples_by_phase(self):
+        """按阶段名合并全部样本"""
+        parts = {}
+        for name, values in self.samples():
+            parts.setdefault(name, []).append(values)
+        return {name: np.concatenate(v) for name, v in parts.items()}
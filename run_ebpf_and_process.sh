@@ -1,13 +1,7 @@
 #!/bin/bash
 
-# Function to handle Ctrl+C
-function ctrl_c() {
-    echo "Ctrl+C detected. Stopping ebpf_performance..."
-    pkill -f "ebpf_performance"  # Use -f option to match the complete command line
-
-    # Step 2: Add a short delay to ensure all data is written to output.txt
-    sleep 2  # Increase delay to 2 seconds to ensure file write completion
-
+# Collect and summarize results once ebpf_performance has exited
+function collect_results() {
     # Step 3: Check if output.txt exists and is not empty
     if [ -f "output.txt" ]; then
         echo "Output file exists."
@@ -19,14 +13,19 @@ function ctrl_c() {
     if [ -s "output.txt" ]; then
         echo "Output file generated successfully. File size: $(du -h output.txt)"
 
-        # Step 4: Run Python script to process the data
-        echo "Running Python script to process the data..."
-        sudo python3 ./py/analy.py
+        # Step 4: ebpf_performance prints its own summary table on exit
+        sed -n '/^Latency summary/,$p' output.txt
+
+        # Step 5 (optional): plot with Python, set PLOT=1 to enable
+        if [ "${PLOT:-0}" = "1" ]; then
+            echo "Running Python script to plot the data..."
+            sudo python3 ./py/analy.py
 
-        if [ $? -eq 0 ]; then
-            echo "Python script executed successfully."
-        else
-            echo "Python script failed to execute."
+            if [ $? -eq 0 ]; then
+                echo "Python script executed successfully."
+            else
+                echo "Python script failed to execute."
+            fi
         fi
     else
         echo "Output file exists but is empty. File size: $(du -h output.txt)"
@@ -36,16 +35,30 @@ function ctrl_c() {
     exit 0
 }
 
+# Forward Ctrl+C to ebpf_performance, which finishes the current round,
+# prints its summary and exits on its own
+function ctrl_c() {
+    echo "Ctrl+C detected. Stopping ebpf_performance..."
+    sudo kill -INT "$pid" 2>/dev/null
+}
+
 # Trap Ctrl+C signal
 trap ctrl_c INT
 
-# Step 1: Run eBPF program and redirect output to output.txt in a loop
+# Step 1: Run eBPF program and redirect output to output.txt
 echo "Starting eBPF program..."
-sudo stdbuf -oL ./ebpf_performance -a > output.txt &
+# Set LOAD (e.g. LOAD=cpu=80 or LOAD=mem=90%) to run built-in background load
+# WARMUP/ROUNDS/BUDGET (e.g. BUDGET=10m) bound the run; set ROUNDS=0 to run until Ctrl+C
+sudo stdbuf -oL ./ebpf_performance -a -o results.bin -j results.json \
+    -w "${WARMUP:-2}" -N "${ROUNDS:-30}" ${BUDGET:+-T "$BUDGET"} \
+    ${LOAD:+-L "$LOAD"} > output.txt &
+pid=$!
 
-# Wait for the eBPF program to be manually terminated by Ctrl+C
-wait $!
+# Step 2: wait returns early when a trapped signal arrives, keep waiting
+# until ebpf_performance has written its summary and exited
+while [ -d "/proc/$pid" ]; do
+    wait "$pid"
+done
 
-# If the script reaches here without Ctrl+C, it means ebpf_performance finished by itself
-echo "eBPF program finished by itself, running Python script..."
-ctrl_c
+echo "eBPF program finished, collecting results..."
+collect_results
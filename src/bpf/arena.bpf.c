@@ -0,0 +1,45 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the arena hash table benchmark.
+#include "analyze_arena.h"
+#include "bench_nop.h"
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// arena 内哈希表与传统hash的插入/查找对比
+SEC("tc")
+int arena_hash_insert(struct __sk_buff *skb) {
+	return arena_hash_insert_one();
+}
+SEC("tc")
+int arena_hash_lookup(struct __sk_buff *skb) {
+	return arena_hash_lookup_one();
+}
+#ifdef ARENA_ENABLED
+SEC("syscall")
+int arena_alloc(void *ctx) {
+	return arena_alloc_table();
+}
+SEC("tc")
+int arena_insert(struct __sk_buff *skb) {
+	return arena_insert_one();
+}
+SEC("tc")
+int arena_lookup(struct __sk_buff *skb) {
+	return arena_lookup_one();
+}
+#endif
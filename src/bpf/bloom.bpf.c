@@ -0,0 +1,39 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the bloom filter benchmark.
+#include "analyze_bloom.h"
+#include "bench_nop.h"
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// 布隆过滤器的内核态push/peek，以及"先过滤再查hash"与"只查hash"的端到端对比
+SEC("tc")
+int bloom_kern_push(struct __sk_buff *skb) {
+	return bloom_push();
+}
+SEC("tc")
+int bloom_kern_peek(struct __sk_buff *skb) {
+	return bloom_peek();
+}
+SEC("tc")
+int bloom_then_hash(struct __sk_buff *skb) {
+	return bloom_lookup(true);
+}
+SEC("tc")
+int hash_only(struct __sk_buff *skb) {
+	return bloom_lookup(false);
+}
@@ -0,0 +1,39 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the shared counter benchmark.
+#include "analyze_counter.h"
+#include "bench_nop.h"
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// 程序名为 cnt_<方式>_<u64个数>，用户态按名字查找
+#define CNT_PROGS(n)                                                           \
+	SEC("tc") int cnt_lock_##n(struct __sk_buff *skb) {                        \
+		return cnt_lock_##n##_update();                                        \
+	}                                                                          \
+	SEC("tc") int cnt_atomic_##n(struct __sk_buff *skb) {                      \
+		return cnt_atomic_##n##_update();                                      \
+	}                                                                          \
+	SEC("tc") int cnt_percpu_##n(struct __sk_buff *skb) {                      \
+		return cnt_percpu_##n##_update();                                      \
+	}                                                                          \
+	SEC("tc") int cnt_plain_##n(struct __sk_buff *skb) {                       \
+		return cnt_plain_##n##_update();                                       \
+	}
+
+CNT_PROGS(1)
+CNT_PROGS(4)
+CNT_PROGS(16)
+CNT_PROGS(64)
@@ -0,0 +1,42 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the local storage benchmark.
+#include "analyze_local_storage.h"
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// 每次系统调用时获取/创建当前任务的状态，对比本地存储与按pid索引的hash
+SEC("tp_btf/sys_enter")
+int BPF_PROG(ls_sys_task, struct pt_regs *regs, long id) {
+	return ls_storage(bpf_get_current_task_btf(), false);
+}
+SEC("tp_btf/sys_enter")
+int BPF_PROG(ls_sys_cgrp, struct pt_regs *regs, long id) {
+	return ls_storage(bpf_get_current_task_btf(), true);
+}
+SEC("tp_btf/sys_enter")
+int BPF_PROG(ls_sys_hash, struct pt_regs *regs, long id) {
+	return ls_pid_hash(bpf_get_current_task_btf(), &ls_hash_map);
+}
+SEC("tp_btf/sys_enter")
+int BPF_PROG(ls_sys_lru, struct pt_regs *regs, long id) {
+	return ls_pid_hash(bpf_get_current_task_btf(), &ls_lru_map);
+}
+SEC("tp_btf/sched_process_exit")
+int BPF_PROG(ls_exit_hash, struct task_struct *p) {
+	return ls_pid_hash_cleanup(p);
+}
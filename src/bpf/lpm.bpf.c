@@ -0,0 +1,34 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the LPM trie benchmark.
+#include "analyze_lpm.h"
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// LPM trie 最长前缀匹配查找，lpm_keys_only 只取查找地址作为基线
+SEC("tc")
+int lpm_keys_only(struct __sk_buff *skb) {
+	return lpm_lookup(NULL);
+}
+SEC("tc")
+int lpm_lookup_v4(struct __sk_buff *skb) {
+	return lpm_lookup(&lpm_v4_map);
+}
+SEC("tc")
+int lpm_lookup_v6(struct __sk_buff *skb) {
+	return lpm_lookup(&lpm_v6_map);
+}
@@ -0,0 +1,40 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the map-in-map benchmark.
+#include "analyze_map_in_map.h"
+#include "bench_nop.h"
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// 四种map直接查找与经 ARRAY_OF_MAPS/HASH_OF_MAPS 两级查找的对比
+#define MIM_PROGS(type)                                                        \
+	SEC("tc")                                                                  \
+	int mim_direct_##type(struct __sk_buff *skb) {                             \
+		return mim_lookup_direct(&type##_map);                                 \
+	}                                                                          \
+	SEC("tc")                                                                  \
+	int mim_aom_##type(struct __sk_buff *skb) {                                \
+		return mim_lookup_outer(&aom_##type);                                  \
+	}                                                                          \
+	SEC("tc")                                                                  \
+	int mim_hom_##type(struct __sk_buff *skb) {                                \
+		return mim_lookup_outer(&hom_##type);                                  \
+	}
+MIM_PROGS(hash)
+MIM_PROGS(array)
+MIM_PROGS(percpu_array)
+MIM_PROGS(percpu_hash)
@@ -0,0 +1,24 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the full-map scan benchmark.
+#include "analyze_map_scan.h"
+#include "vmlinux.h"
+#include <bpf/bpf_helpers.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// map元素迭代器，附加时由用户态指定要遍历的map
+SEC("iter/bpf_map_elem")
+int scan_dump(struct bpf_iter__bpf_map_elem *ctx) {
+	return scan_dump_elem(ctx);
+}
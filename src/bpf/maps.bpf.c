@@ -10,7 +10,7 @@
 //
 // author: yys2020haha@163.com
 //
-// Kernel space BPF program used for eBPF performance testing.
+// Kernel side of the basic map comparison (-a).
 #include "analyze_map.h"
 #include "vmlinux.h"
 #include <bpf/bpf_core_read.h>
@@ -18,6 +18,7 @@
 #include <bpf/bpf_tracing.h>
 #include "common.h"
 char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
 struct {
     __uint(type,BPF_MAP_TYPE_RINGBUF);
     __uint(max_entries,1024);
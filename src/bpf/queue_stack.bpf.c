@@ -0,0 +1,47 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel side of the queue/stack benchmark.
+#include "analyze_queue_stack.h"
+#include "bench_nop.h"
+#include "vmlinux.h"
+#include <bpf/bpf_core_read.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include "common.h"
+char LICENSE[] SEC("license") = "Dual BSD/GPL";
+
+// 队列/栈Map的内核态push/pop/peek，由用户态通过 BPF_PROG_TEST_RUN 触发
+SEC("tc")
+int qs_queue_push(struct __sk_buff *skb) {
+	return qs_push(&queue_map);
+}
+SEC("tc")
+int qs_queue_pop(struct __sk_buff *skb) {
+	return qs_pop(&queue_map);
+}
+SEC("tc")
+int qs_queue_peek(struct __sk_buff *skb) {
+	return qs_peek(&queue_map);
+}
+SEC("tc")
+int qs_stack_push(struct __sk_buff *skb) {
+	return qs_push(&stack_map);
+}
+SEC("tc")
+int qs_stack_pop(struct __sk_buff *skb) {
+	return qs_pop(&stack_map);
+}
+SEC("tc")
+int qs_stack_peek(struct __sk_buff *skb) {
+	return qs_peek(&stack_map);
+}
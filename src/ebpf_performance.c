@@ -13,7 +13,17 @@
 // Kernel space BPF program used for eBPF performance testing.
 
 #include "common.h"
-#include "ebpf_performance.skel.h"
+#include "bench_compare.h"
+#include "bench_env.h"
+#include "bench_features.h"
+#include "bench_load.h"
+#include "bench_output.h"
+#include "bench_record.h"
+#include "bench_registry.h"
+#include "bench_rounds.h"
+#include "bench_skel.h"
+#include "bench_stats.h"
+#include "bench_timer.h"
 #include <argp.h>
 #include <bpf/bpf.h>
 #include <bpf/libbpf.h>
@@ -30,23 +40,60 @@
 
 // 定义env结构体，用来存储程序中的事件信息
 static struct env {
-	bool execute_test_maps;
+	bool probe_features;
+	bool noise_control;
+	int fifo_prio;
+	unsigned int warmup_rounds;
+	unsigned int rounds;
+	unsigned int budget_s;
+	const char *output_path;
+	const char *csv_path;
+	const char *json_path;
 	bool verbose;
-	enum EventType event_type;
 } env = {
-    .execute_test_maps = false,
+    .probe_features = false,
+    .noise_control = false,
+    .fifo_prio = 0,
+    .warmup_rounds = 1,
+    .rounds = 0,
+    .budget_s = 0,
+    .output_path = NULL,
+    .csv_path = NULL,
+    .json_path = NULL,
     .verbose = false,
-    .event_type = NONE_TYPE,
 };
 
 const char *argp_program_version = "ebpf_performance 1.0";
 const char *argp_program_bug_address = "<yys2020haha@163.com>";
 const char argp_program_doc[] =
     "BPF program used for eBPF performance testing\n";
-int option_selected = 0; // 功能标志变量,确保激活子功能
-// 具体解释命令行参数
-static const struct argp_option opts[] = {
-    {"Map test", 'a', NULL, 0, "Comparing the differences between eBPF Maps"},
+// 具体解释命令行参数，基准测试的选项由 build_options() 按注册表生成
+static const struct argp_option common_opts[] = {
+    {NULL, 0, NULL, 0, "Options:", 2},
+    {"probe", 'p', NULL, 0,
+     "Probe kernel features and list which benchmarks can run"},
+    {"output", 'o', "FILE", 0,
+     "Also write raw samples and histograms to FILE in binary format"},
+    {"csv", 'c', "FILE", 0,
+     "Also write every result row with run metadata as CSV, one "
+     "FILE.<bench>.csv per benchmark"},
+    {"json", 'j', "FILE", 0,
+     "Also write every result row with run metadata to FILE as JSON lines"},
+    {"noise_control", 'n', NULL, 0,
+     "Pin to the measurement CPU, mlockall and pre-fault memory"},
+    {"cpu", 'C', "CPU", 0, "Measurement CPU for -n and -L (default 0)"},
+    {"fifo", 'F', "PRIO", OPTION_ARG_OPTIONAL,
+     "Run measurement threads (not -L load) at SCHED_FIFO priority PRIO "
+     "(default 50), implies -n"},
+    {"load", 'L', "SPEC", 0,
+     "Run background load while benchmarking, e.g. "
+     "cpu=80,mem=90%,syscall=2,cache=2"},
+    {"warmup", 'w', "N", 0,
+     "Run N warmup rounds of -a that are not reported (default 1)"},
+    {"rounds", 'N', "N", 0,
+     "Stop -a after N measured rounds (default unlimited)"},
+    {"time", 'T', "DURATION", 0,
+     "Stop before exceeding DURATION (e.g. 90, 5m, 1h) of wall-clock time"},
     {"verbose", 'v', NULL, 0, "Verbose debug output"},
     {NULL, 'H', NULL, OPTION_HIDDEN, "Show the full help"},
     {},
@@ -54,424 +101,253 @@ static const struct argp_option opts[] = {
 // 解析命令行参数
 static error_t parse_arg(int key, char *arg, struct argp_state *state) {
 	switch (key) {
-	case 'a':
-		SET_OPTION_AND_CHECK_USAGE(option_selected, env.execute_test_maps);
+	case 'p':
+		env.probe_features = true;
 		break;
+	case 'o':
+		env.output_path = arg;
+		break;
+	case 'c':
+		env.csv_path = arg;
+		break;
+	case 'j':
+		env.json_path = arg;
+		break;
+	case 'n':
+		env.noise_control = true;
+		break;
+	case 'C': {
+		char *end;
+		long cpu = strtol(arg, &end, 10);
+
+		if (*end || cpu < 0 || cpu >= sysconf(_SC_NPROCESSORS_CONF))
+			argp_error(state, "invalid CPU: %s", arg);
+		bench_env_set_cpu(cpu);
+		break;
+	}
+	case 'F':
+		env.noise_control = true;
+		env.fifo_prio = arg ? atoi(arg) : 50;
+		if (env.fifo_prio < 1 || env.fifo_prio > 99)
+			argp_error(state, "invalid SCHED_FIFO priority: %s", arg);
+		break;
+	case 'L':
+		if (bench_load_parse(arg))
+			argp_error(state, "invalid load: %s", arg);
+		bench_output_set_load(arg);
+		break;
+	case 'w':
+	case 'N': {
+		char *end;
+		unsigned long n = strtoul(arg, &end, 10);
+
+		if (*end || end == arg)
+			argp_error(state, "invalid round count: %s", arg);
+		if (key == 'w')
+			env.warmup_rounds = n;
+		else
+			env.rounds = n;
+		break;
+	}
+	case 'T': {
+		char *end;
+		unsigned long t = strtoul(arg, &end, 10);
+
+		if (end == arg)
+			argp_error(state, "invalid duration: %s", arg);
+		if (*end == 'm')
+			t *= 60, end++;
+		else if (*end == 'h')
+			t *= 3600, end++;
+		else if (*end == 's')
+			end++;
+		if (*end || !t)
+			argp_error(state, "invalid duration: %s", arg);
+		env.budget_s = t;
+		break;
+	}
 	case 'H':
 		argp_state_help(state, stderr, ARGP_HELP_STD_HELP);
 		break;
 	case 'v':
 		env.verbose = true;
 		break;
-	default:
-		return ARGP_ERR_UNKNOWN;
+	default: {
+		const struct bench_desc *b = bench_find_key(key);
+
+		if (!b)
+			return ARGP_ERR_UNKNOWN;
+		if (bench_select(b, arg))
+			argp_error(state, "%s selected more than once", b->name);
+		break;
+	}
 	}
 	return 0;
 }
 // 定义解析参数的处理函数
-static const struct argp argp = {
-    .options = opts,
+static struct argp argp = {
     .parser = parse_arg,
     .doc = argp_program_doc,
 };
 
-static int libbpf_print_fn(enum libbpf_print_level level, const char *format,
-                           va_list args) {
-	if (level == LIBBPF_DEBUG && !env.verbose)
-		return 0;
-	return vfprintf(stderr, format, args);
-}
-
-static volatile bool exiting = false;
-// 设置信号来控制是否打印信息
-static void sig_handler(int sig) { exiting = true; }
-//控制ringbuff次数
-static int event_count = 0;        // 事件计数器
-static volatile bool stop_polling = false; // 控制轮询的标志
-#define MAX_EVENTS 1024
-// 根据 env 设置 EventType
-static int determineEventType(struct env *env) {
-	if (!env) {
-		return 1;
-	}
-	if (env->execute_test_maps) {
-		env->event_type = EXECUTE_TEST_MAPS;
-	} else {
-		env->event_type = NONE_TYPE; // 或者根据需要设置一个默认的事件类型
-	}
-	return 0;
-}
-
-/*通过env->event_type属性来选择需要打印的信息表头*/
-static int print_event_head(struct env *env) {
-	if (!env->event_type) {
-		// 处理无效参数，可以选择抛出错误或返回
-		return 1;
-	}
-	switch (env->event_type) {
-        case EXECUTE_TEST_MAPS:
-            printf("%-12s %-12s %-12s %-12s %-12s %-12s\n", "Map_01_Insert",
-                "Map_01_LookUp", "Map_01_Delete", "Map_02_Insert",
-                "Map_02_LookUp", "Map_02_Delete");
-            break;
-        default:
-            // Handle default case or display an error message
-            break;
-        }
-	return 0;
-}
-
-static void set_disable_load(struct ebpf_performance_bpf *skel) {
-	bpf_program__set_autoload(skel->progs.tp_sys_entry,
-	                          env.execute_test_maps ? true : false);
-}
-void print_map_and_check_error(int (*print_func)(struct ebpf_performance_bpf *),
-                               struct ebpf_performance_bpf *skel,
-                               const char *map_name, int err) {
-	OUTPUT_INTERVAL(10);
-	print_func(skel);
-	if (err < 0 && err != -4) {
-		printf("Error printing %s map: %d\n", map_name, err);
-	}
-}
-
-int attach_probe(struct ebpf_performance_bpf *skel) {
-	return ebpf_performance_bpf__attach(skel);
-}
-struct timespec diff(struct timespec start, struct timespec end) {
-	struct timespec temp;
-	if ((end.tv_nsec - start.tv_nsec) < 0) {
-		temp.tv_sec = end.tv_sec - start.tv_sec - 1;
-		temp.tv_nsec = 1000000000 + end.tv_nsec - start.tv_nsec;
-	} else {
-		temp.tv_sec = end.tv_sec - start.tv_sec;
-		temp.tv_nsec = end.tv_nsec - start.tv_nsec;
-	}
-	return temp;
-}
-#define MAX_ENTRIES 1024
-#define MAX_CPUS 8
-// 信号处理函数，用来终止polling
-void stop_polling_handler(int signum) {
-    stop_polling = true;
-}
-int compare_ebpf_maps(struct ebpf_performance_bpf *skel) {
-	int hash_fd = bpf_map__fd(skel->maps.hash_map);
-	int array_fd = bpf_map__fd(skel->maps.array_map);
-	int per_cpu_array_fd = bpf_map__fd(skel->maps.percpu_array_map);
-	int per_cpu_hash_fd = bpf_map__fd(skel->maps.percpu_hash_map);
-	if (hash_fd < 0 || array_fd < 0 || per_cpu_array_fd < 0) {
-		fprintf(stderr, "Failed to get map file descriptors: %d, %d\n", hash_fd,
-		        array_fd);
-		return 1;
-	}
-
-	struct timespec start, end, elapsed;
-	int key, value;
-	char formatted_time[20];
-	srand(time(0)); // 生成随机数种子
-	int random_number;
-
-	// 查找 HashMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		if (bpf_map_lookup_elem(hash_fd, &random_number, &value) != 0) {
-			fprintf(stderr, "Failed to lookup element in hash_map: %d\n",
-			        errno);
-			return 1;
-		}
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-	// 插入 HashMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		value = random_number * 2;
-		if (bpf_map_update_elem(hash_fd, &random_number, &value, BPF_ANY) !=
-		    0) {
-			fprintf(stderr, "Failed to insert element into hash_map: %d\n",
-			        errno);
-			return 1;
-		}
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-	// 清除 HashMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 0; key < MAX_ENTRIES; key++) {
-		if (bpf_map_delete_elem(hash_fd, &key) != 0) {
-			fprintf(stderr, "Failed to delete element in hash_map: %d\n",
-			        errno);
-			return 1;
-		}
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-	// 操作 ArrayMap
-
-	// 查找 ArrayMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		if (bpf_map_lookup_elem(array_fd, &random_number, &value) != 0) {
-			fprintf(stderr, "Failed to lookup element in array_map: %d\n",
-			        errno);
-			return 1;
-		}
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-	// 插入 ArrayMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		value = key * 2;
-		if (bpf_map_update_elem(array_fd, &random_number, &value, BPF_ANY) !=
-		    0) {
-			fprintf(stderr, "Failed to insert element in array_map: %d\n",
-			        errno);
-			return 1;
+// 每个注册的基准测试对应一个选项(放在 "Benchmarks:" 分组下)，之后是公共选项
+static struct argp_option *build_options(void) {
+	int nr = bench_count();
+	int nr_common = sizeof(common_opts) / sizeof(common_opts[0]);
+	struct argp_option *opts = calloc(nr + 1 + nr_common, sizeof(*opts));
+	const struct bench_desc *b;
+
+	if (!opts)
+		return NULL;
+	opts[0].doc = "Benchmarks (several may be given, run in order):";
+	opts[0].group = 1;
+	for (int i = 0; i < nr; i++) {
+		b = bench_at(i);
+		// 短选项不能与公共选项重复
+		for (int j = 0; j < nr_common; j++) {
+			if (b->key && common_opts[j].key == b->key) {
+				fprintf(stderr, "Benchmark %s: option -%c is already used\n",
+				        b->name, b->key);
+				free(opts);
+				return NULL;
+			}
 		}
+		opts[i + 1].name = b->name;
+		opts[i + 1].key = bench_option_key(b);
+		opts[i + 1].arg = b->arg;
+		opts[i + 1].doc = b->doc;
 	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
+	memcpy(opts + nr + 1, common_opts, sizeof(common_opts));
+	return opts;
+}
 
-	// 清除 ArrayMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		value = 0;
-		if (bpf_map_update_elem(array_fd, &key, &value, BPF_ANY) != 0) {
-			fprintf(stderr, "Failed to reset element in array_map: %d\n",
-			        errno);
-			return 1;
-		}
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
+// compare 子命令的参数
+static struct compare_env {
+	const char *paths[2];
+	int nr_paths;
+	double threshold_pct;
+	double alpha;
+} compare_env = {
+    .threshold_pct = 5.0,
+    .alpha = 0.05,
+};
 
-	// 操作 Per_cpu ArrayMap
-	int num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
-	size_t value_size = sizeof(__u64) * num_cpus;
+static const struct argp_option compare_opts[] = {
+    {"threshold", 't', "PCT", 0,
+     "Median slowdown (percent) that counts as a regression (default 5)"},
+    {"alpha", 'A', "P", 0, "Significance level for the test (default 0.05)"},
+    {},
+};
 
-	// 查找 Per_cpu ArrayMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		__u64 *values = malloc(value_size);
-		if (bpf_map_lookup_elem(per_cpu_array_fd, &random_number, values) !=
-		    0) {
-			fprintf(stderr,
-			        "Failed to lookup element in percpu_array_map: %d\n",
-			        errno);
-			return 1;
-		}
+static error_t parse_compare_arg(int key, char *arg, struct argp_state *state) {
+	char *end;
 
-		// 根据需要处理 CPU 上的值
-		for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
-			if (values[cpu]) {
-			} // 可根据实际需求打印或使用
-		}
-		free(values);
+	switch (key) {
+	case 't':
+		compare_env.threshold_pct = strtod(arg, &end);
+		if (*end || compare_env.threshold_pct < 0)
+			argp_error(state, "invalid threshold: %s", arg);
+		break;
+	case 'A':
+		compare_env.alpha = strtod(arg, &end);
+		if (*end || compare_env.alpha <= 0 || compare_env.alpha >= 1)
+			argp_error(state, "invalid alpha: %s", arg);
+		break;
+	case ARGP_KEY_ARG:
+		if (compare_env.nr_paths >= 2)
+			argp_usage(state);
+		compare_env.paths[compare_env.nr_paths++] = arg;
+		break;
+	case ARGP_KEY_END:
+		if (compare_env.nr_paths != 2)
+			argp_usage(state);
+		break;
+	default:
+		return ARGP_ERR_UNKNOWN;
 	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-	// 插入per_cpu_array_map
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		// 初始化每个CPU的值
-		__u64 *values = malloc(value_size);
-		for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
-			values[cpu] = random_number *
-			              (cpu + 1); // 示例：每个CPU的值为随机数乘以CPU编号
-		}
+	return 0;
+}
 
-		if (bpf_map_update_elem(per_cpu_array_fd, &random_number, values,
-		                        BPF_ANY) != 0) {
-			fprintf(stderr,
-			        "Failed to insert element into percpu_array_map: %d\n",
-			        errno);
-			return 1;
-		}
-		free(values);
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout);
+static const struct argp compare_argp = {
+    .options = compare_opts,
+    .parser = parse_compare_arg,
+    .args_doc = "BASELINE CANDIDATE",
+    .doc = "Compare two result files written with -o.\n"
+           "Exits 1 when some phase is slower than the threshold with "
+           "p < alpha, 2 on bad input, on error, or when a baseline phase is "
+           "missing from the candidate.",
+};
 
-	// 清除 Per_cpu ArrayMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		// 将每个CPU上的值重置为0
-		unsigned long values[MAX_CPUS] = {0}; // 所有CPU初始化为0
+// ebpf_performance compare [-t PCT] [-A P] BASELINE CANDIDATE
+static int run_compare(int argc, char **argv) {
+	int err;
 
-		if (bpf_map_update_elem(per_cpu_array_fd, &key, values, BPF_ANY) != 0) {
-			fprintf(stderr, "Failed to reset element in percpu_array_map: %d\n",
-			        errno);
-			return 1;
-		}
-	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout);
-	// 计算一下malloc和free的耗时
-	//  clock_gettime(CLOCK_MONOTONIC, &start);
-	//  for(int i = 0 ; i < 1024 ; i++){
-	//      __u64 *values = malloc(value_size);
-	//      free(values);
-	//  }
-	//  clock_gettime(CLOCK_MONOTONIC, &end);
-	//  elapsed = diff(start, end);
-	//  snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	//  elapsed.tv_sec, elapsed.tv_nsec); printf("malloc耗时:%-13s\n",
-	//  formatted_time);
+	// 用法错误同样以2退出(argp 默认为64)
+	argp_err_exit_status = 2;
+	err = argp_parse(&compare_argp, argc, argv, 0, NULL, NULL);
+	if (err)
+		return 2;
+	err = bench_compare(compare_env.paths[0], compare_env.paths[1],
+	                    compare_env.threshold_pct, compare_env.alpha);
+	return err < 0 ? 2 : err;
+}
 
-	// 操作per_cpu_hash_map
-	//  查找 Per_cpu HashMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		__u64 *values = malloc(value_size);
-		if (bpf_map_lookup_elem(per_cpu_hash_fd, &random_number, values) != 0) {
-			fprintf(stderr, "Failed to lookup element in percpu_hash_map: %d\n",
-			        errno);
-			return 1;
-		}
+static int libbpf_print_fn(enum libbpf_print_level level, const char *format,
+                           va_list args) {
+	if (level == LIBBPF_DEBUG && !env.verbose)
+		return 0;
+	return vfprintf(stderr, format, args);
+}
 
-		// 根据需要处理 CPU 上的值
-		for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
-			if (values[cpu]) {
-				// 可以根据需要打印或处理每个 CPU 上的值
-			}
-		}
-		free(values);
+// 打印当前内核上每个基准测试能否运行、所有用到的特性的探测结果，
+// 以及各基准测试结构化结果的字段
+static int print_feature_matrix(void) {
+	const struct bench_feature *missing;
+	const struct bench_desc *b;
+	const struct bench_feature extra[] = {
+	    BENCH_MAP(TASK_STORAGE),
+	    {BENCH_FEAT_MAP, BENCH_MAP_TYPE_CGRP_STORAGE, 0, "map:CGRP_STORAGE"},
+	    {BENCH_FEAT_MAP, BENCH_MAP_TYPE_ARENA, 0, "map:ARENA"},
+	};
+
+	printf("%-15s %-12s %s\n", "BENCHMARK", "STATUS", "MISSING");
+	for (int i = 0; i < bench_count(); i++) {
+		b = bench_at(i);
+		missing = bench_features_missing(b->feats, b->nr_feats);
+		printf("%-15s %-12s %s\n", b->name,
+		       missing ? "unsupported" : "supported",
+		       missing ? missing->name : "-");
 	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-	// 插入 Per_cpu HashMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		random_number = (rand() % key);
-		// 初始化每个 CPU 的值
-		__u64 *values = malloc(value_size);
-		for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
-			values[cpu] = random_number *
-			              (cpu + 1); // 示例：每个 CPU 的值为随机数乘以 CPU 编号
-		}
-
-		if (bpf_map_update_elem(per_cpu_hash_fd, &random_number, values,
-		                        BPF_ANY) != 0) {
-			fprintf(stderr,
-			        "Failed to insert element into percpu_hash_map: %d\n",
-			        errno);
-			return 1;
-		}
-		free(values);
+	printf("\n%-36s %s\n", "FEATURE", "SUPPORTED");
+	for (int i = 0; i < bench_count(); i++) {
+		b = bench_at(i);
+		for (int j = 0; j < b->nr_feats; j++)
+			printf("%-36s %s\n", b->feats[j].name,
+			       bench_feature_supported(&b->feats[j]) ? "yes" : "no");
 	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-
-		// 清除 Per_cpu HashMap
-	clock_gettime(CLOCK_MONOTONIC, &start);
-	for (key = 1; key < MAX_ENTRIES; key++) {
-		if (bpf_map_delete_elem(per_cpu_hash_fd, &key) != 0) {
-			fprintf(stderr, "Failed to delete element in percpu_hash_map: %d\n",
-			        errno);
-			return 1;
-		}
+	for (size_t i = 0; i < sizeof(extra) / sizeof(extra[0]); i++)
+		printf("%-36s %s\n", extra[i].name,
+		       bench_feature_supported(&extra[i]) ? "yes" : "no");
+	printf("\n%-15s %s\n", "BENCHMARK", "RESULT FIELDS");
+	for (int i = 0; i < bench_count(); i++) {
+		b = bench_at(i);
+		printf("%-15s %s\n", b->name, b->schema ? b->schema : "-");
 	}
-	clock_gettime(CLOCK_MONOTONIC, &end);
-	elapsed = diff(start, end);
-	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
-	         elapsed.tv_sec, elapsed.tv_nsec);
-	printf("%-13s", formatted_time);
-	fflush(stdout); // 刷新输出缓冲区
-    
-	// 操作ringbuff
-
-	printf("\n");
-	
 	return 0;
 }
-/*环形缓冲区的处理函数，用来打印ringbuff中的数据（最后展示的数据行）*/
-static int handle_event(void *ctx, void *data, size_t data_sz) {
-    printf("进入打印ringbuff函数\n");
-    struct common_event *e = data;
-    
-    switch(env.event_type){
-        case EXECUTE_TEST_MAPS:{
-            printf("打印ringbuff的数据\n");
-            //printf("%-6d %-6llu\n", e->test_ringbuff.key, e->test_ringbuff.value);
-            int key = e->test_ringbuff.key;
-            unsigned long long value = e->test_ringbuff.value;
-            event_count++;
-              // 如果事件计数器达到 MAX_EVENTS，设置标志停止轮询
-            if (event_count >= MAX_EVENTS) {
-                stop_polling = true;
-            }
-            break;
-        }
-        default:
-            // 处理未知事件类型
-            break;
-    }
-    return 0;
-}
+
+static volatile bool exiting = false;
+// 设置信号来控制是否打印信息
+static void sig_handler(int sig) { exiting = true; }
 int main(int argc, char **argv) {
-	struct ebpf_performance_bpf *skel;
-	struct ring_buffer *rb = NULL;
 	int err;
+	/* compare 子命令: 对比两次运行的结果，用于回归门禁 */
+	if (argc > 1 && strcmp(argv[1], "compare") == 0)
+		return run_compare(argc - 1, argv + 1);
 	/*解析命令行参数*/
+	argp.options = build_options();
+	if (!argp.options)
+		return 1;
 	err = argp_parse(&argp, argc, argv, 0, NULL, NULL);
 	if (err)
 		return err;
@@ -481,65 +357,74 @@ int main(int argc, char **argv) {
     signal(SIGINT, sig_handler);
 	signal(SIGTERM, sig_handler);
 	signal(SIGALRM, sig_handler);
-	/* Open BPF application */
-	skel = ebpf_performance_bpf__open();
-	if (!skel) {
-		fprintf(stderr, "Failed to open BPF skeleton\n");
+	/* 长时间运行时发送 SIGUSR1 可随时打印当前的汇总统计 */
+	signal(SIGUSR1, bench_stats_request);
+	if (env.probe_features)
+		return print_feature_matrix();
+	if (!bench_nr_selected()) {
+		fprintf(stderr, "Please specify one or more benchmarks (or -p).\n");
+		argp_help(&argp, stderr, ARGP_HELP_STD_HELP, argv[0]);
 		return 1;
 	}
+	bench_rounds_init(env.warmup_rounds, env.rounds, env.budget_s);
+	/* 在运行任何基准测试之前检查各自的参数(如矩阵配置文件) */
+	err = bench_setup_selected();
+	if (err)
+		goto cleanup_benches;
+	if (env.output_path) {
+		char command[96] = "";
 
-	/* 禁用或加载内核挂钩函数 */
-	set_disable_load(skel);
-
-	/* 加载并验证BPF程序 */
-	err = ebpf_performance_bpf__load(skel);
-	if (err) {
-		fprintf(stderr, "Failed to load and verify BPF skeleton\n");
-		goto cleanup;
+		for (int i = 0; i < argc; i++) {
+			strncat(command, argv[i], sizeof(command) - strlen(command) - 1);
+			strncat(command, " ", sizeof(command) - strlen(command) - 1);
+		}
+		err = bench_record_open(env.output_path, command);
+		if (err) {
+			fprintf(stderr, "Failed to open %s: %d\n", env.output_path, err);
+			goto cleanup_benches;
+		}
 	}
-
-	/* 附加跟踪点处理程序 */
-	err = attach_probe(skel);
+	err = bench_output_open(env.csv_path, env.json_path);
 	if (err) {
-		fprintf(stderr, "Failed to attach BPF skeleton\n");
-		goto cleanup;
+		fprintf(stderr, "Failed to open structured output: %d\n", err);
+		goto cleanup_record;
 	}
-	// 根据 env 设置 EventType
-	err = determineEventType(&env);
-	if (err) {
-		fprintf(stderr, "Invalid env parm\n");
-		goto cleanup;
+	/* 低噪声测量模式: 绑核、实时优先级、锁定并预先触碰内存 */
+	if (env.noise_control) {
+		err = bench_env_control(env.fifo_prio);
+		if (err)
+			goto cleanup_output;
 	}
-	/*打印信息头*/
-	// err = print_event_head(&env);
+	/* 绑核之后校准逐次计时用的周期计数器并测量计时开销 */
+	bench_timer_init();
+	/* 记录并提示调频、C-state、SMT、CPU隔离等噪声来源；在启动背景负载之前
+	 * 检查，避免把 -L 自己的负载线程当作SMT兄弟线程上的噪声 */
+	bench_env_check();
+	/* 启动背景负载，内存负载写满后才开始测量 */
+	err = bench_load_start(&exiting);
 	if (err) {
-		fprintf(stderr, "Please specify an option using %s.\n", OPTIONS_LIST);
-		goto cleanup;
-	}
-	/* 设置环形缓冲区轮询 */
-	rb = ring_buffer__new(bpf_map__fd(skel->maps.rb), handle_event, NULL, NULL);
-	if (!rb) {
-		err = -1;
-		fprintf(stderr, "Failed to create ring buffer\n");
+		fprintf(stderr, "Failed to start background load: %d\n", err);
 		goto cleanup;
 	}
-    //err = ring_buffer__poll(rb, RING_BUFFER_TIMEOUT_MS /* timeout, ms */);
-	while (!exiting) {
-        //err = ring_buffer__poll(rb, RING_BUFFER_TIMEOUT_MS /* timeout, ms */);
-		if (env.execute_test_maps) {
-			print_map_and_check_error(compare_ebpf_maps, skel, "maps", err);
-		}
-		/* Ctrl-C will cause -EINTR */
-		if (err == -EINTR) {
-			err = 0;
-			break;
-		}
-		if (err < 0) {
-			printf("Error polling perf buffer: %d\n", err);
-			break;
-		}
-	}
+	/* 时间预算同样约束一次性的基准测试，到时由 SIGALRM 置 exiting */
+	if (env.budget_s)
+		alarm(env.budget_s);
+	/* 按命令行顺序依次运行所选基准测试 */
+	err = bench_run_selected(&exiting);
 cleanup:
-	ebpf_performance_bpf__destroy(skel);
+	/* 所有基准测试的逐次样本汇总(流式统计，见 bench_stats.h) */
+	bench_stats_print(stdout, BENCH_STATS_TITLE);
+	bench_skel_summary(stdout);
+	bench_rounds_summary(stdout);
+	bench_load_stop();
+	bench_rounds_free();
+	bench_stats_free();
+cleanup_output:
+	bench_output_close();
+cleanup_record:
+	bench_record_close();
+cleanup_benches:
+	bench_teardown_selected();
+	free((void *)argp.options);
 	return -err;
-}
\ No newline at end of file
+}
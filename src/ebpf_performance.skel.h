@@ -1,666 +0,0 @@
-/* SPDX-License-Identifier: (LGPL-2.1 OR BSD-2-Clause) */
-
-/* THIS FILE IS AUTOGENERATED BY BPFTOOL! */
-#ifndef __EBPF_PERFORMANCE_BPF_SKEL_H__
-#define __EBPF_PERFORMANCE_BPF_SKEL_H__
-
-#include <errno.h>
-#include <stdlib.h>
-#include <bpf/libbpf.h>
-
-struct ebpf_performance_bpf {
-	struct bpf_object_skeleton *skeleton;
-	struct bpf_object *obj;
-	struct {
-		struct bpf_map *rb;
-		struct bpf_map *hash_map;
-		struct bpf_map *array_map;
-		struct bpf_map *percpu_array_map;
-		struct bpf_map *percpu_hash_map;
-		struct bpf_map *bss;
-		struct bpf_map *rodata;
-	} maps;
-	struct {
-		struct bpf_program *tp_sys_entry;
-	} progs;
-	struct {
-		struct bpf_link *tp_sys_entry;
-	} links;
-	struct ebpf_performance_bpf__bss {
-		__u64 k;
-		enum EventType event_type;
-	} *bss;
-
-#ifdef __cplusplus
-	static inline struct ebpf_performance_bpf *open(const struct bpf_object_open_opts *opts = nullptr);
-	static inline struct ebpf_performance_bpf *open_and_load();
-	static inline int load(struct ebpf_performance_bpf *skel);
-	static inline int attach(struct ebpf_performance_bpf *skel);
-	static inline void detach(struct ebpf_performance_bpf *skel);
-	static inline void destroy(struct ebpf_performance_bpf *skel);
-	static inline const void *elf_bytes(size_t *sz);
-#endif /* __cplusplus */
-};
-
-static void
-ebpf_performance_bpf__destroy(struct ebpf_performance_bpf *obj)
-{
-	if (!obj)
-		return;
-	if (obj->skeleton)
-		bpf_object__destroy_skeleton(obj->skeleton);
-	free(obj);
-}
-
-static inline int
-ebpf_performance_bpf__create_skeleton(struct ebpf_performance_bpf *obj);
-
-static inline struct ebpf_performance_bpf *
-ebpf_performance_bpf__open_opts(const struct bpf_object_open_opts *opts)
-{
-	struct ebpf_performance_bpf *obj;
-	int err;
-
-	obj = (struct ebpf_performance_bpf *)calloc(1, sizeof(*obj));
-	if (!obj) {
-		errno = ENOMEM;
-		return NULL;
-	}
-
-	err = ebpf_performance_bpf__create_skeleton(obj);
-	if (err)
-		goto err_out;
-
-	err = bpf_object__open_skeleton(obj->skeleton, opts);
-	if (err)
-		goto err_out;
-
-	return obj;
-err_out:
-	ebpf_performance_bpf__destroy(obj);
-	errno = -err;
-	return NULL;
-}
-
-static inline struct ebpf_performance_bpf *
-ebpf_performance_bpf__open(void)
-{
-	return ebpf_performance_bpf__open_opts(NULL);
-}
-
-static inline int
-ebpf_performance_bpf__load(struct ebpf_performance_bpf *obj)
-{
-	return bpf_object__load_skeleton(obj->skeleton);
-}
-
-static inline struct ebpf_performance_bpf *
-ebpf_performance_bpf__open_and_load(void)
-{
-	struct ebpf_performance_bpf *obj;
-	int err;
-
-	obj = ebpf_performance_bpf__open();
-	if (!obj)
-		return NULL;
-	err = ebpf_performance_bpf__load(obj);
-	if (err) {
-		ebpf_performance_bpf__destroy(obj);
-		errno = -err;
-		return NULL;
-	}
-	return obj;
-}
-
-static inline int
-ebpf_performance_bpf__attach(struct ebpf_performance_bpf *obj)
-{
-	return bpf_object__attach_skeleton(obj->skeleton);
-}
-
-static inline void
-ebpf_performance_bpf__detach(struct ebpf_performance_bpf *obj)
-{
-	bpf_object__detach_skeleton(obj->skeleton);
-}
-
-static inline const void *ebpf_performance_bpf__elf_bytes(size_t *sz);
-
-static inline int
-ebpf_performance_bpf__create_skeleton(struct ebpf_performance_bpf *obj)
-{
-	struct bpf_object_skeleton *s;
-	int err;
-
-	s = (struct bpf_object_skeleton *)calloc(1, sizeof(*s));
-	if (!s)	{
-		err = -ENOMEM;
-		goto err;
-	}
-
-	s->sz = sizeof(*s);
-	s->name = "ebpf_performance_bpf";
-	s->obj = &obj->obj;
-
-	/* maps */
-	s->map_cnt = 7;
-	s->map_skel_sz = sizeof(*s->maps);
-	s->maps = (struct bpf_map_skeleton *)calloc(s->map_cnt, s->map_skel_sz);
-	if (!s->maps) {
-		err = -ENOMEM;
-		goto err;
-	}
-
-	s->maps[0].name = "rb";
-	s->maps[0].map = &obj->maps.rb;
-
-	s->maps[1].name = "hash_map";
-	s->maps[1].map = &obj->maps.hash_map;
-
-	s->maps[2].name = "array_map";
-	s->maps[2].map = &obj->maps.array_map;
-
-	s->maps[3].name = "percpu_array_map";
-	s->maps[3].map = &obj->maps.percpu_array_map;
-
-	s->maps[4].name = "percpu_hash_map";
-	s->maps[4].map = &obj->maps.percpu_hash_map;
-
-	s->maps[5].name = "ebpf_per.bss";
-	s->maps[5].map = &obj->maps.bss;
-	s->maps[5].mmaped = (void **)&obj->bss;
-
-	s->maps[6].name = "ebpf_per.rodata";
-	s->maps[6].map = &obj->maps.rodata;
-
-	/* programs */
-	s->prog_cnt = 1;
-	s->prog_skel_sz = sizeof(*s->progs);
-	s->progs = (struct bpf_prog_skeleton *)calloc(s->prog_cnt, s->prog_skel_sz);
-	if (!s->progs) {
-		err = -ENOMEM;
-		goto err;
-	}
-
-	s->progs[0].name = "tp_sys_entry";
-	s->progs[0].prog = &obj->progs.tp_sys_entry;
-	s->progs[0].link = &obj->links.tp_sys_entry;
-
-	s->data = ebpf_performance_bpf__elf_bytes(&s->data_sz);
-
-	obj->skeleton = s;
-	return 0;
-err:
-	bpf_object__destroy_skeleton(s);
-	return err;
-}
-
-static inline const void *ebpf_performance_bpf__elf_bytes(size_t *sz)
-{
-	static const char data[] __attribute__((__aligned__(8))) = "\
-\x7f\x45\x4c\x46\x02\x01\x01\0\0\0\0\0\0\0\0\0\x01\0\xf7\0\x01\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\xd8\x27\0\0\0\0\0\0\0\0\0\0\x40\0\0\0\0\0\x40\0\x18\0\
-\x01\0\x79\x11\x08\0\0\0\0\0\x7b\x1a\xf0\xff\0\0\0\0\xb7\0\0\0\x01\0\0\0\x18\
-\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xdb\x01\0\0\x01\0\0\0\x63\x0a\xfc\xff\0\0\0\0\
-\xbf\x02\0\0\0\0\0\0\x67\x02\0\0\x20\0\0\0\x77\x02\0\0\x20\0\0\0\xb7\x03\0\0\0\
-\x04\0\0\x2d\x23\x06\0\0\0\0\0\x07\0\0\0\x01\0\0\0\x67\0\0\0\x20\0\0\0\x77\0\0\
-\0\x20\0\0\0\xb7\x02\0\0\0\0\0\0\xdb\x21\0\0\xf1\0\0\0\x63\x2a\xfc\xff\0\0\0\0\
-\xbf\xa6\0\0\0\0\0\0\x07\x06\0\0\xfc\xff\xff\xff\xbf\xa7\0\0\0\0\0\0\x07\x07\0\
-\0\xf0\xff\xff\xff\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xbf\x62\0\0\0\0\0\0\xbf\
-\x73\0\0\0\0\0\0\xb7\x04\0\0\0\0\0\0\x85\0\0\0\x02\0\0\0\x18\x01\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\xbf\x62\0\0\0\0\0\0\xbf\x73\0\0\0\0\0\0\xb7\x04\0\0\0\0\0\0\x85\
-\0\0\0\x02\0\0\0\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xbf\x62\0\0\0\0\0\0\xbf\
-\x73\0\0\0\0\0\0\xb7\x04\0\0\0\0\0\0\x85\0\0\0\x02\0\0\0\x18\x01\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\xbf\x62\0\0\0\0\0\0\xbf\x73\0\0\0\0\0\0\xb7\x04\0\0\0\0\0\0\x85\
-\0\0\0\x02\0\0\0\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xbf\x62\0\0\0\0\0\0\xbf\
-\x73\0\0\0\0\0\0\xb7\x04\0\0\0\0\0\0\x85\0\0\0\x02\0\0\0\x18\x01\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\xb7\x02\0\0\x10\0\0\0\xb7\x03\0\0\0\0\0\0\x85\0\0\0\x83\0\0\0\
-\x15\0\x0c\0\0\0\0\0\x61\xa1\xfc\xff\0\0\0\0\x63\x10\0\0\0\0\0\0\x79\xa1\xf0\
-\xff\0\0\0\0\x7b\x10\x08\0\0\0\0\0\xbf\x01\0\0\0\0\0\0\xb7\x02\0\0\0\0\0\0\x85\
-\0\0\0\x84\0\0\0\x79\xa3\xf0\xff\0\0\0\0\x18\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\xb7\x02\0\0\x13\0\0\0\x85\0\0\0\x06\0\0\0\xb7\0\0\0\0\0\0\0\x95\0\0\0\0\0\0\0\
-\x44\x75\x61\x6c\x20\x42\x53\x44\x2f\x47\x50\x4c\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x73\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x20\
-\x3d\x20\x25\x6c\x6c\x75\x0a\0\0\0\0\0\0\0\0\0\x08\0\0\0\0\0\0\0\x01\0\x51\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x08\0\0\0\0\0\0\0\x01\0\x51\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xc8\x01\0\0\0\0\0\0\x02\0\x30\x9f\
-\xc8\x01\0\0\0\0\0\0\x08\x02\0\0\0\0\0\0\x01\0\x50\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\xc8\x01\0\0\0\0\0\0\xd0\x01\0\0\0\0\0\0\x01\0\x50\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\x01\x11\x01\x25\x0e\x13\x05\x03\x0e\x10\x17\x1b\x0e\x11\x01\x12\x06\0\
-\0\x02\x34\0\x03\x0e\x49\x13\x3f\x19\x3a\x0b\x3b\x0b\x02\x18\0\0\x03\x35\0\x49\
-\x13\0\0\x04\x16\0\x49\x13\x03\x0e\x3a\x0b\x3b\x0b\0\0\x05\x24\0\x03\x0e\x3e\
-\x0b\x0b\x0b\0\0\x06\x01\x01\x49\x13\0\0\x07\x21\0\x49\x13\x37\x0b\0\0\x08\x24\
-\0\x03\x0e\x0b\x0b\x3e\x0b\0\0\x09\x04\x01\x49\x13\x03\x0e\x0b\x0b\x3a\x0b\x3b\
-\x0b\0\0\x0a\x28\0\x03\x0e\x1c\x0f\0\0\x0b\x13\x01\x0b\x0b\x3a\x0b\x3b\x0b\0\0\
-\x0c\x0d\0\x03\x0e\x49\x13\x3a\x0b\x3b\x0b\x38\x0b\0\0\x0d\x0f\0\x49\x13\0\0\
-\x0e\x21\0\x49\x13\x37\x05\0\0\x0f\x34\0\x03\x0e\x49\x13\x3a\x0b\x3b\x0b\0\0\
-\x10\x13\x01\x03\x0e\x0b\x0b\x3a\x0b\x3b\x0b\0\0\x11\x0d\0\x49\x13\x3a\x0b\x3b\
-\x0b\x38\x0b\0\0\x12\x17\x01\x0b\x0b\x3a\x0b\x3b\x0b\0\0\x13\x2e\x01\0\0\x14\
-\x34\0\x03\x0e\x49\x13\x3a\x0b\x3b\x0b\x02\x18\0\0\x15\x26\0\x49\x13\0\0\x16\
-\x15\x01\x49\x13\x27\x19\0\0\x17\x05\0\x49\x13\0\0\x18\x0f\0\0\0\x19\x26\0\0\0\
-\x1a\x34\0\x03\x0e\x49\x13\x3a\x0b\x3b\x05\0\0\x1b\x15\x01\x27\x19\0\0\x1c\x18\
-\0\0\0\x1d\x04\x01\x49\x13\x0b\x0b\x3a\x0b\x3b\x05\0\0\x1e\x2e\x01\x03\x0e\x3a\
-\x0b\x3b\x0b\x27\x19\x49\x13\x20\x0b\0\0\x1f\x05\0\x03\x0e\x3a\x0b\x3b\x0b\x49\
-\x13\0\0\x20\x34\0\x03\x0e\x3a\x0b\x3b\x0b\x49\x13\0\0\x21\x0b\x01\0\0\x22\x13\
-\x01\x03\x0e\x0b\x0b\x3a\x0b\x3b\x06\0\0\x23\x0d\0\x03\x0e\x49\x13\x3a\x0b\x3b\
-\x06\x38\x0b\0\0\x24\x13\x01\x03\x0e\x0b\x0b\x3a\x0b\x3b\x05\0\0\x25\x0d\0\x03\
-\x0e\x49\x13\x3a\x0b\x3b\x05\x38\x0b\0\0\x26\x2e\x01\x11\x01\x12\x06\x40\x18\
-\x97\x42\x19\x03\x0e\x3a\x0b\x3b\x0b\x27\x19\x49\x13\x3f\x19\0\0\x27\x05\0\x02\
-\x17\x03\x0e\x3a\x0b\x3b\x0b\x49\x13\0\0\x28\x1d\x01\x31\x13\x11\x01\x12\x06\
-\x58\x0b\x59\x0b\x57\x0b\0\0\x29\x05\0\x02\x17\x31\x13\0\0\x2a\x34\0\x02\x18\
-\x31\x13\0\0\x2b\x0b\x01\x11\x01\x12\x06\0\0\x2c\x34\0\x02\x17\x31\x13\0\0\0\
-\x85\x05\0\0\x04\0\0\0\0\0\x08\x01\0\0\0\0\x1d\0\x2f\0\0\0\0\0\0\0\x4a\0\0\0\0\
-\0\0\0\0\0\0\0\x40\x02\0\0\x02\x8a\0\0\0\x3f\0\0\0\x02\x30\x09\x03\0\0\0\0\0\0\
-\0\0\x03\x44\0\0\0\x04\x4f\0\0\0\x9f\0\0\0\x01\x12\x05\x8c\0\0\0\x07\x08\x02\
-\xa5\0\0\0\x6b\0\0\0\x03\x14\x09\x03\0\0\0\0\0\0\0\0\x06\x77\0\0\0\x07\x7e\0\0\
-\0\x0d\0\x05\xad\0\0\0\x06\x01\x08\xb2\0\0\0\x08\x07\x02\xc6\0\0\0\x9a\0\0\0\
-\x01\x32\x09\x03\0\0\0\0\0\0\0\0\x09\xb3\0\0\0\xfa\0\0\0\x04\x01\x2f\x0a\xde\0\
-\0\0\0\x0a\xe8\0\0\0\x01\0\x05\xd1\0\0\0\x07\x04\x02\x04\x01\0\0\xcf\0\0\0\x02\
-\x1c\x09\x03\0\0\0\0\0\0\0\0\x0b\x20\x02\x17\x0c\x0d\x01\0\0\x04\x01\0\0\x02\
-\x18\0\x0c\x16\x01\0\0\x1c\x01\0\0\x02\x19\x08\x0c\x22\x01\0\0\x2e\x01\0\0\x02\
-\x1a\x10\x0c\x30\x01\0\0\x49\x01\0\0\x02\x1b\x18\0\x0d\x09\x01\0\0\x06\x15\x01\
-\0\0\x07\x7e\0\0\0\x01\0\x05\x12\x01\0\0\x05\x04\x0d\x21\x01\0\0\x06\x15\x01\0\
-\0\x0e\x7e\0\0\0\0\x04\0\x0d\x33\x01\0\0\x04\x3e\x01\0\0\x2c\x01\0\0\x04\x22\
-\x04\xb3\0\0\0\x26\x01\0\0\x04\x12\x0d\x4e\x01\0\0\x04\x59\x01\0\0\x36\x01\0\0\
-\x04\x26\x04\x4f\0\0\0\x9f\0\0\0\x04\x16\x02\x3a\x01\0\0\x79\x01\0\0\x02\x22\
-\x09\x03\0\0\0\0\0\0\0\0\x0b\x20\x02\x1d\x0c\x0d\x01\0\0\xae\x01\0\0\x02\x1e\0\
-\x0c\x16\x01\0\0\x1c\x01\0\0\x02\x1f\x08\x0c\x22\x01\0\0\x2e\x01\0\0\x02\x20\
-\x10\x0c\x30\x01\0\0\x49\x01\0\0\x02\x21\x18\0\x0d\xb3\x01\0\0\x06\x15\x01\0\0\
-\x07\x7e\0\0\0\x02\0\x02\x44\x01\0\0\xd4\x01\0\0\x02\x28\x09\x03\0\0\0\0\0\0\0\
-\0\x0b\x20\x02\x23\x0c\x0d\x01\0\0\x09\x02\0\0\x02\x24\0\x0c\x16\x01\0\0\x1c\
-\x01\0\0\x02\x25\x08\x0c\x22\x01\0\0\x2e\x01\0\0\x02\x26\x10\x0c\x30\x01\0\0\
-\x49\x01\0\0\x02\x27\x18\0\x0d\x0e\x02\0\0\x06\x15\x01\0\0\x07\x7e\0\0\0\x06\0\
-\x02\x55\x01\0\0\x2f\x02\0\0\x02\x2e\x09\x03\0\0\0\0\0\0\0\0\x0b\x20\x02\x29\
-\x0c\x0d\x01\0\0\x64\x02\0\0\x02\x2a\0\x0c\x16\x01\0\0\x1c\x01\0\0\x02\x2b\x08\
-\x0c\x22\x01\0\0\x2e\x01\0\0\x02\x2c\x10\x0c\x30\x01\0\0\x49\x01\0\0\x02\x2d\
-\x18\0\x0d\x69\x02\0\0\x06\x15\x01\0\0\x07\x7e\0\0\0\x05\0\x02\x65\x01\0\0\x8a\
-\x02\0\0\x03\x18\x09\x03\0\0\0\0\0\0\0\0\x0b\x10\x03\x15\x0c\x0d\x01\0\0\xa7\
-\x02\0\0\x03\x16\0\x0c\x16\x01\0\0\x1c\x01\0\0\x03\x17\x08\0\x0d\xac\x02\0\0\
-\x06\x15\x01\0\0\x07\x7e\0\0\0\x1b\0\x0f\x68\x01\0\0\xc3\x02\0\0\x03\x1a\x0d\
-\xc8\x02\0\0\x10\x78\x01\0\0\x10\x01\x34\x11\xd8\x02\0\0\x01\x35\0\x12\x10\x01\
-\x35\x0c\x6a\x01\0\0\xe8\x02\0\0\x01\x39\0\x0b\x10\x01\x36\x0c\x22\x01\0\0\x07\
-\x03\0\0\x01\x37\0\x0c\x30\x01\0\0\x44\0\0\0\x01\x38\x08\0\0\0\x04\xb3\0\0\0\
-\x26\x01\0\0\x01\x11\x13\x14\x85\x01\0\0\x29\x03\0\0\x02\x47\x09\x03\0\0\0\0\0\
-\0\0\0\0\x06\x35\x03\0\0\x07\x7e\0\0\0\x13\0\x15\x77\0\0\0\x0f\x8d\x01\0\0\x45\
-\x03\0\0\x05\x4e\x0d\x4a\x03\0\0\x16\x64\x03\0\0\x17\x6b\x03\0\0\x17\x6c\x03\0\
-\0\x17\x6c\x03\0\0\x17\x59\x01\0\0\0\x05\xa1\x01\0\0\x05\x08\x18\x0d\x71\x03\0\
-\0\x19\x1a\xa6\x01\0\0\x7e\x03\0\0\x05\x60\x0c\x0d\x83\x03\0\0\x16\x6b\x03\0\0\
-\x17\x6b\x03\0\0\x17\x59\x01\0\0\x17\x59\x01\0\0\0\x1a\xba\x01\0\0\xa4\x03\0\0\
-\x05\x72\x0c\x0d\xa9\x03\0\0\x1b\x17\x6b\x03\0\0\x17\x59\x01\0\0\0\x0f\xcd\x01\
-\0\0\xc0\x03\0\0\x05\xb1\x0d\xc5\x03\0\0\x16\x64\x03\0\0\x17\xd6\x03\0\0\x17\
-\x3e\x01\0\0\x1c\0\x0d\x35\x03\0\0\x1d\xb3\0\0\0\x04\x04\x1b\xeb\x0a\xde\x01\0\
-\0\0\x0a\xe6\x01\0\0\x01\x0a\xf2\x01\0\0\x02\x0a\xfc\x01\0\0\x04\0\x1e\x07\x02\
-\0\0\x02\x32\x15\x01\0\0\x01\x1f\x14\x02\0\0\x02\x32\x59\x04\0\0\x1f\x65\x01\0\
-\0\x02\x32\x6b\x03\0\0\x1f\x68\x01\0\0\x02\x33\xc3\x02\0\0\x20\x90\x02\0\0\x02\
-\x35\x4e\x01\0\0\x20\x9b\x02\0\0\x02\x34\x33\x01\0\0\x20\x9f\x02\0\0\x02\x34\
-\x33\x01\0\0\x21\x20\xa6\x02\0\0\x02\x43\xc3\x02\0\0\0\0\x0d\x5e\x04\0\0\x22\
-\x76\x02\0\0\x40\x04\x4c\x88\x01\0\x23\x19\x02\0\0\xa6\x04\0\0\x04\x4d\x88\x01\
-\0\0\x23\x5e\x02\0\0\x64\x03\0\0\x04\x4e\x88\x01\0\x08\x23\x14\x02\0\0\xf2\x04\
-\0\0\x04\x4f\x88\x01\0\x10\x23\x6f\x02\0\0\x05\x05\0\0\x04\x50\x88\x01\0\x40\0\
-\x24\x52\x02\0\0\x08\x04\xce\x17\x25\x0d\x01\0\0\xe4\x04\0\0\x04\xcf\x17\0\x25\
-\x2c\x02\0\0\xeb\x04\0\0\x04\xd0\x17\x02\x25\x40\x02\0\0\xeb\x04\0\0\x04\xd1\
-\x17\x03\x25\x4e\x02\0\0\x15\x01\0\0\x04\xd2\x17\x04\0\x05\x1d\x02\0\0\x07\x02\
-\x05\x32\x02\0\0\x08\x01\x06\xfe\x04\0\0\x07\x7e\0\0\0\x06\0\x05\x61\x02\0\0\
-\x07\x08\x06\x77\0\0\0\x07\x7e\0\0\0\0\0\x26\0\0\0\0\0\0\0\0\x40\x02\0\0\x01\
-\x5a\xab\x02\0\0\x03\x1d\x15\x01\0\0\x27\0\0\0\0\x14\x02\0\0\x03\x1d\x59\x04\0\
-\0\x28\xfd\x03\0\0\0\0\0\0\0\0\0\0\x30\x02\0\0\x03\x1e\x09\x29\x23\0\0\0\x09\
-\x04\0\0\x29\x46\0\0\0\x1f\x04\0\0\x2a\x02\x91\0\x2a\x04\0\0\x2a\x02\x91\x0c\
-\x35\x04\0\0\x2b\xa0\x01\0\0\0\0\0\0\x30\0\0\0\x2c\x7d\0\0\0\x4c\x04\0\0\0\0\0\
-\0\x63\x6c\x61\x6e\x67\x20\x76\x65\x72\x73\x69\x6f\x6e\x20\x31\x37\x2e\x30\x2e\
-\x36\x20\x28\x61\x6e\x6f\x6c\x69\x73\x20\x6f\x73\x20\x31\x37\x2e\x30\x2e\x36\
-\x2d\x34\x2e\x61\x6e\x32\x33\x29\0\x73\x72\x63\x2f\x65\x62\x70\x66\x5f\x70\x65\
-\x72\x66\x6f\x72\x6d\x61\x6e\x63\x65\x2e\x62\x70\x66\x2e\x63\0\x2f\x68\x6f\x6d\
-\x65\x2f\x62\x65\x65\x2f\x70\x72\x6f\x6a\x65\x63\x74\x2f\x4d\x75\x6c\x74\x69\
-\x64\x69\x6d\x65\x6e\x73\x69\x6f\x6e\x61\x6c\x5f\x50\x65\x72\x66\x6f\x72\x6d\
-\x61\x6e\x63\x65\x5f\x41\x6e\x61\x6c\x79\x73\x69\x73\x5f\x6f\x66\x5f\x65\x42\
-\x50\x46\0\x6b\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x6c\x6f\x6e\x67\x20\x6c\
-\x6f\x6e\x67\0\x5f\x5f\x75\x36\x34\0\x4c\x49\x43\x45\x4e\x53\x45\0\x63\x68\x61\
-\x72\0\x5f\x5f\x41\x52\x52\x41\x59\x5f\x53\x49\x5a\x45\x5f\x54\x59\x50\x45\x5f\
-\x5f\0\x65\x76\x65\x6e\x74\x5f\x74\x79\x70\x65\0\x75\x6e\x73\x69\x67\x6e\x65\
-\x64\x20\x69\x6e\x74\0\x4e\x4f\x4e\x45\x5f\x54\x59\x50\x45\0\x45\x58\x45\x43\
-\x55\x54\x45\x5f\x54\x45\x53\x54\x5f\x4d\x41\x50\x53\0\x45\x76\x65\x6e\x74\x54\
-\x79\x70\x65\0\x68\x61\x73\x68\x5f\x6d\x61\x70\0\x74\x79\x70\x65\0\x69\x6e\x74\
-\0\x6d\x61\x78\x5f\x65\x6e\x74\x72\x69\x65\x73\0\x6b\x65\x79\0\x5f\x5f\x75\x33\
-\x32\0\x75\x33\x32\0\x76\x61\x6c\x75\x65\0\x75\x36\x34\0\x61\x72\x72\x61\x79\
-\x5f\x6d\x61\x70\0\x70\x65\x72\x63\x70\x75\x5f\x61\x72\x72\x61\x79\x5f\x6d\x61\
-\x70\0\x70\x65\x72\x63\x70\x75\x5f\x68\x61\x73\x68\x5f\x6d\x61\x70\0\x72\x62\0\
-\x65\0\x74\x65\x73\x74\x5f\x72\x69\x6e\x67\x62\x75\x66\x66\0\x63\x6f\x6d\x6d\
-\x6f\x6e\x5f\x65\x76\x65\x6e\x74\0\x5f\x5f\x5f\x5f\x66\x6d\x74\0\x62\x70\x66\
-\x5f\x6d\x61\x70\x5f\x75\x70\x64\x61\x74\x65\x5f\x65\x6c\x65\x6d\0\x6c\x6f\x6e\
-\x67\0\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\x75\x66\x5f\x72\x65\x73\x65\x72\x76\
-\x65\0\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\x75\x66\x5f\x73\x75\x62\x6d\x69\x74\
-\0\x62\x70\x66\x5f\x74\x72\x61\x63\x65\x5f\x70\x72\x69\x6e\x74\x6b\0\x42\x50\
-\x46\x5f\x41\x4e\x59\0\x42\x50\x46\x5f\x4e\x4f\x45\x58\x49\x53\x54\0\x42\x50\
-\x46\x5f\x45\x58\x49\x53\x54\0\x42\x50\x46\x5f\x46\x5f\x4c\x4f\x43\x4b\0\x61\
-\x6e\x61\x6c\x79\x7a\x65\x5f\x6d\x61\x70\x73\0\x61\x72\x67\x73\0\x65\x6e\x74\0\
-\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x73\x68\x6f\x72\x74\0\x66\x6c\x61\x67\x73\
-\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x63\x68\x61\x72\0\x70\x72\x65\x65\x6d\
-\x70\x74\x5f\x63\x6f\x75\x6e\x74\0\x70\x69\x64\0\x74\x72\x61\x63\x65\x5f\x65\
-\x6e\x74\x72\x79\0\x69\x64\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x6c\x6f\x6e\
-\x67\0\x5f\x5f\x64\x61\x74\x61\0\x74\x72\x61\x63\x65\x5f\x65\x76\x65\x6e\x74\
-\x5f\x72\x61\x77\x5f\x73\x79\x73\x5f\x65\x6e\x74\x65\x72\0\x73\x79\x73\x63\x61\
-\x6c\x6c\x5f\x69\x64\0\x69\x64\x78\0\x63\x6f\x75\x6e\x74\x73\0\x5f\x74\x6d\x70\
-\0\x74\x70\x5f\x73\x79\x73\x5f\x65\x6e\x74\x72\x79\0\x9f\xeb\x01\0\x18\0\0\0\0\
-\0\0\0\x34\x05\0\0\x34\x05\0\0\x13\x05\0\0\0\0\0\0\0\0\0\x02\x03\0\0\0\x01\0\0\
-\0\0\0\0\x01\x04\0\0\0\x20\0\0\x01\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\0\x04\0\0\
-\0\x1b\0\0\0\x05\0\0\0\0\0\0\x01\x04\0\0\0\x20\0\0\0\0\0\0\0\0\0\0\x02\x06\0\0\
-\0\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\0\x04\0\0\0\0\x04\0\0\0\0\0\0\x02\0\0\x04\
-\x10\0\0\0\x19\0\0\0\x01\0\0\0\0\0\0\0\x1e\0\0\0\x05\0\0\0\x40\0\0\0\x2a\0\0\0\
-\0\0\0\x0e\x07\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x0a\0\0\0\0\0\0\0\0\0\0\x03\0\
-\0\0\0\x02\0\0\0\x04\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x0c\0\0\0\x2d\0\0\0\0\0\
-\0\x08\x0d\0\0\0\x31\0\0\0\0\0\0\x08\x0e\0\0\0\x37\0\0\0\0\0\0\x01\x04\0\0\0\
-\x20\0\0\0\0\0\0\0\0\0\0\x02\x10\0\0\0\x44\0\0\0\0\0\0\x08\x11\0\0\0\x48\0\0\0\
-\0\0\0\x08\x12\0\0\0\x4e\0\0\0\0\0\0\x01\x08\0\0\0\x40\0\0\0\0\0\0\0\x04\0\0\
-\x04\x20\0\0\0\x19\0\0\0\x09\0\0\0\0\0\0\0\x1e\0\0\0\x05\0\0\0\x40\0\0\0\x61\0\
-\0\0\x0b\0\0\0\x80\0\0\0\x65\0\0\0\x0f\0\0\0\xc0\0\0\0\x6b\0\0\0\0\0\0\x0e\x13\
-\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x16\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\
-\0\x04\0\0\0\x02\0\0\0\0\0\0\0\x04\0\0\x04\x20\0\0\0\x19\0\0\0\x15\0\0\0\0\0\0\
-\0\x1e\0\0\0\x05\0\0\0\x40\0\0\0\x61\0\0\0\x0b\0\0\0\x80\0\0\0\x65\0\0\0\x0f\0\
-\0\0\xc0\0\0\0\x74\0\0\0\0\0\0\x0e\x17\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x1a\0\
-\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\0\x04\0\0\0\x06\0\0\0\0\0\0\0\x04\0\0\
-\x04\x20\0\0\0\x19\0\0\0\x19\0\0\0\0\0\0\0\x1e\0\0\0\x05\0\0\0\x40\0\0\0\x61\0\
-\0\0\x0b\0\0\0\x80\0\0\0\x65\0\0\0\x0f\0\0\0\xc0\0\0\0\x7e\0\0\0\0\0\0\x0e\x1b\
-\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x1e\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x02\0\0\
-\0\x04\0\0\0\x05\0\0\0\0\0\0\0\x04\0\0\x04\x20\0\0\0\x19\0\0\0\x1d\0\0\0\0\0\0\
-\0\x1e\0\0\0\x05\0\0\0\x40\0\0\0\x61\0\0\0\x0b\0\0\0\x80\0\0\0\x65\0\0\0\x0f\0\
-\0\0\xc0\0\0\0\x8f\0\0\0\0\0\0\x0e\x1f\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x02\x22\0\
-\0\0\x9f\0\0\0\x04\0\0\x04\x40\0\0\0\xb9\0\0\0\x23\0\0\0\0\0\0\0\xbd\0\0\0\x26\
-\0\0\0\x40\0\0\0\xc0\0\0\0\x28\0\0\0\x80\0\0\0\xc5\0\0\0\x2a\0\0\0\0\x02\0\0\
-\xcc\0\0\0\x04\0\0\x04\x08\0\0\0\x19\0\0\0\x24\0\0\0\0\0\0\0\xd8\0\0\0\x25\0\0\
-\0\x10\0\0\0\xde\0\0\0\x25\0\0\0\x18\0\0\0\xec\0\0\0\x02\0\0\0\x20\0\0\0\xf0\0\
-\0\0\0\0\0\x01\x02\0\0\0\x10\0\0\0\xff\0\0\0\0\0\0\x01\x01\0\0\0\x08\0\0\0\x0d\
-\x01\0\0\0\0\0\x01\x08\0\0\0\x40\0\0\x01\x12\x01\0\0\0\0\0\x01\x08\0\0\0\x40\0\
-\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x27\0\0\0\x04\0\0\0\x06\0\0\0\x20\x01\0\0\0\0\0\
-\x01\x01\0\0\0\x08\0\0\x01\0\0\0\0\0\0\0\x03\0\0\0\0\x29\0\0\0\x04\0\0\0\0\0\0\
-\0\0\0\0\0\x01\0\0\x0d\x02\0\0\0\xc0\0\0\0\x21\0\0\0\x25\x01\0\0\x01\0\0\x0c\
-\x2b\0\0\0\0\0\0\0\0\0\0\x09\x2e\0\0\0\x48\0\0\0\0\0\0\x08\x12\0\0\0\xa8\x04\0\
-\0\0\0\0\x0e\x2d\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x29\0\0\0\x04\0\0\0\
-\x0d\0\0\0\xaa\x04\0\0\0\0\0\x0e\x30\0\0\0\x01\0\0\0\xb2\x04\0\0\x02\0\0\x06\
-\x04\0\0\0\xbc\x04\0\0\0\0\0\0\xc6\x04\0\0\x01\0\0\0\xd8\x04\0\0\0\0\0\x0e\x32\
-\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x0a\x29\0\0\0\0\0\0\0\0\0\0\x03\0\0\0\0\x34\0\0\
-\0\x04\0\0\0\x13\0\0\0\xe3\x04\0\0\0\0\0\x0e\x35\0\0\0\0\0\0\0\xf8\x04\0\0\x02\
-\0\0\x0f\0\0\0\0\x2f\0\0\0\0\0\0\0\x08\0\0\0\x33\0\0\0\0\0\0\0\x04\0\0\0\xfd\
-\x04\0\0\x05\0\0\x0f\0\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\x14\0\0\0\0\0\0\0\x20\
-\0\0\0\x18\0\0\0\0\0\0\0\x20\0\0\0\x1c\0\0\0\0\0\0\0\x20\0\0\0\x20\0\0\0\0\0\0\
-\0\x20\0\0\0\x03\x05\0\0\x01\0\0\x0f\0\0\0\0\x36\0\0\0\0\0\0\0\x13\0\0\0\x0b\
-\x05\0\0\x01\0\0\x0f\0\0\0\0\x31\0\0\0\0\0\0\0\x0d\0\0\0\0\x69\x6e\x74\0\x5f\
-\x5f\x41\x52\x52\x41\x59\x5f\x53\x49\x5a\x45\x5f\x54\x59\x50\x45\x5f\x5f\0\x74\
-\x79\x70\x65\0\x6d\x61\x78\x5f\x65\x6e\x74\x72\x69\x65\x73\0\x72\x62\0\x75\x33\
-\x32\0\x5f\x5f\x75\x33\x32\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x69\x6e\x74\0\
-\x75\x36\x34\0\x5f\x5f\x75\x36\x34\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x6c\
-\x6f\x6e\x67\x20\x6c\x6f\x6e\x67\0\x6b\x65\x79\0\x76\x61\x6c\x75\x65\0\x68\x61\
-\x73\x68\x5f\x6d\x61\x70\0\x61\x72\x72\x61\x79\x5f\x6d\x61\x70\0\x70\x65\x72\
-\x63\x70\x75\x5f\x61\x72\x72\x61\x79\x5f\x6d\x61\x70\0\x70\x65\x72\x63\x70\x75\
-\x5f\x68\x61\x73\x68\x5f\x6d\x61\x70\0\x74\x72\x61\x63\x65\x5f\x65\x76\x65\x6e\
-\x74\x5f\x72\x61\x77\x5f\x73\x79\x73\x5f\x65\x6e\x74\x65\x72\0\x65\x6e\x74\0\
-\x69\x64\0\x61\x72\x67\x73\0\x5f\x5f\x64\x61\x74\x61\0\x74\x72\x61\x63\x65\x5f\
-\x65\x6e\x74\x72\x79\0\x66\x6c\x61\x67\x73\0\x70\x72\x65\x65\x6d\x70\x74\x5f\
-\x63\x6f\x75\x6e\x74\0\x70\x69\x64\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x73\
-\x68\x6f\x72\x74\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x63\x68\x61\x72\0\x6c\
-\x6f\x6e\x67\0\x75\x6e\x73\x69\x67\x6e\x65\x64\x20\x6c\x6f\x6e\x67\0\x63\x68\
-\x61\x72\0\x74\x70\x5f\x73\x79\x73\x5f\x65\x6e\x74\x72\x79\0\x74\x72\x61\x63\
-\x65\x70\x6f\x69\x6e\x74\x2f\x72\x61\x77\x5f\x73\x79\x73\x63\x61\x6c\x6c\x73\
-\x2f\x73\x79\x73\x5f\x65\x6e\x74\x65\x72\0\x30\x3a\x31\0\x2f\x68\x6f\x6d\x65\
-\x2f\x62\x65\x65\x2f\x70\x72\x6f\x6a\x65\x63\x74\x2f\x4d\x75\x6c\x74\x69\x64\
-\x69\x6d\x65\x6e\x73\x69\x6f\x6e\x61\x6c\x5f\x50\x65\x72\x66\x6f\x72\x6d\x61\
-\x6e\x63\x65\x5f\x41\x6e\x61\x6c\x79\x73\x69\x73\x5f\x6f\x66\x5f\x65\x42\x50\
-\x46\x2f\x2e\x2f\x69\x6e\x63\x6c\x75\x64\x65\x2f\x62\x70\x66\x2f\x61\x6e\x61\
-\x6c\x79\x7a\x65\x5f\x6d\x61\x70\x2e\x68\0\x20\x20\x20\x20\x75\x36\x34\x20\x73\
-\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x20\x3d\x20\x28\x75\x36\x34\x29\x61\x72\
-\x67\x73\x2d\x3e\x69\x64\x3b\0\x20\x20\x20\x20\x69\x64\x78\x20\x3d\x20\x5f\x5f\
-\x73\x79\x6e\x63\x5f\x66\x65\x74\x63\x68\x5f\x61\x6e\x64\x5f\x61\x64\x64\x28\
-\x26\x6b\x2c\x20\x31\x29\x3b\x20\0\x20\x20\x20\x20\x69\x66\x20\x28\x69\x64\x78\
-\x20\x3e\x3d\x20\x4d\x41\x58\x5f\x45\x4e\x54\x52\x49\x45\x53\x29\x20\x7b\0\x20\
-\x20\x20\x20\x20\x20\x20\x20\x5f\x5f\x73\x79\x6e\x63\x5f\x62\x6f\x6f\x6c\x5f\
-\x63\x6f\x6d\x70\x61\x72\x65\x5f\x61\x6e\x64\x5f\x73\x77\x61\x70\x28\x26\x6b\
-\x2c\x20\x69\x64\x78\x20\x2b\x20\x31\x2c\x20\x30\x29\x3b\0\x20\x20\x20\x20\x20\
-\x20\x20\x20\x69\x64\x78\x20\x3d\x20\x30\x3b\0\x20\x20\x20\x20\x62\x70\x66\x5f\
-\x6d\x61\x70\x5f\x75\x70\x64\x61\x74\x65\x5f\x65\x6c\x65\x6d\x28\x26\x68\x61\
-\x73\x68\x5f\x6d\x61\x70\x2c\x20\x26\x69\x64\x78\x2c\x20\x26\x73\x79\x73\x63\
-\x61\x6c\x6c\x5f\x69\x64\x2c\x20\x42\x50\x46\x5f\x41\x4e\x59\x29\x3b\0\x20\x20\
-\x20\x20\x62\x70\x66\x5f\x6d\x61\x70\x5f\x75\x70\x64\x61\x74\x65\x5f\x65\x6c\
-\x65\x6d\x28\x26\x61\x72\x72\x61\x79\x5f\x6d\x61\x70\x2c\x20\x26\x69\x64\x78\
-\x2c\x20\x26\x73\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x2c\x20\x42\x50\x46\x5f\
-\x41\x4e\x59\x29\x3b\0\x20\x20\x20\x20\x62\x70\x66\x5f\x6d\x61\x70\x5f\x75\x70\
-\x64\x61\x74\x65\x5f\x65\x6c\x65\x6d\x28\x26\x70\x65\x72\x63\x70\x75\x5f\x61\
-\x72\x72\x61\x79\x5f\x6d\x61\x70\x2c\x26\x69\x64\x78\x2c\x26\x73\x79\x73\x63\
-\x61\x6c\x6c\x5f\x69\x64\x2c\x42\x50\x46\x5f\x41\x4e\x59\x29\x3b\0\x20\x20\x20\
-\x20\x62\x70\x66\x5f\x6d\x61\x70\x5f\x75\x70\x64\x61\x74\x65\x5f\x65\x6c\x65\
-\x6d\x28\x26\x70\x65\x72\x63\x70\x75\x5f\x68\x61\x73\x68\x5f\x6d\x61\x70\x2c\
-\x26\x69\x64\x78\x2c\x26\x73\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x2c\x42\x50\
-\x46\x5f\x41\x4e\x59\x29\x3b\0\x20\x20\x20\x20\x52\x45\x53\x45\x52\x56\x45\x5f\
-\x52\x49\x4e\x47\x42\x55\x46\x5f\x45\x4e\x54\x52\x59\x28\x72\x62\x2c\x20\x65\
-\x29\x3b\0\x20\x20\x20\x20\x65\x2d\x3e\x74\x65\x73\x74\x5f\x72\x69\x6e\x67\x62\
-\x75\x66\x66\x2e\x6b\x65\x79\x20\x3d\x20\x69\x64\x78\x3b\0\x20\x20\x20\x20\x65\
-\x2d\x3e\x74\x65\x73\x74\x5f\x72\x69\x6e\x67\x62\x75\x66\x66\x2e\x76\x61\x6c\
-\x75\x65\x20\x3d\x20\x73\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x3b\0\x20\x20\x20\
-\x20\x62\x70\x66\x5f\x72\x69\x6e\x67\x62\x75\x66\x5f\x73\x75\x62\x6d\x69\x74\
-\x28\x65\x2c\x20\x30\x29\x3b\0\x20\x20\x20\x20\x62\x70\x66\x5f\x70\x72\x69\x6e\
-\x74\x6b\x28\x22\x73\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x20\x3d\x20\x25\x6c\
-\x6c\x75\x5c\x6e\x22\x2c\x20\x73\x79\x73\x63\x61\x6c\x6c\x5f\x69\x64\x29\x3b\0\
-\x2f\x68\x6f\x6d\x65\x2f\x62\x65\x65\x2f\x70\x72\x6f\x6a\x65\x63\x74\x2f\x4d\
-\x75\x6c\x74\x69\x64\x69\x6d\x65\x6e\x73\x69\x6f\x6e\x61\x6c\x5f\x50\x65\x72\
-\x66\x6f\x72\x6d\x61\x6e\x63\x65\x5f\x41\x6e\x61\x6c\x79\x73\x69\x73\x5f\x6f\
-\x66\x5f\x65\x42\x50\x46\x2f\x73\x72\x63\x2f\x65\x62\x70\x66\x5f\x70\x65\x72\
-\x66\x6f\x72\x6d\x61\x6e\x63\x65\x2e\x62\x70\x66\x2e\x63\0\x09\x72\x65\x74\x75\
-\x72\x6e\x20\x61\x6e\x61\x6c\x79\x7a\x65\x5f\x6d\x61\x70\x73\x28\x61\x72\x67\
-\x73\x2c\x26\x72\x62\x2c\x65\x29\x3b\0\x6b\0\x4c\x49\x43\x45\x4e\x53\x45\0\x45\
-\x76\x65\x6e\x74\x54\x79\x70\x65\0\x4e\x4f\x4e\x45\x5f\x54\x59\x50\x45\0\x45\
-\x58\x45\x43\x55\x54\x45\x5f\x54\x45\x53\x54\x5f\x4d\x41\x50\x53\0\x65\x76\x65\
-\x6e\x74\x5f\x74\x79\x70\x65\0\x61\x6e\x61\x6c\x79\x7a\x65\x5f\x6d\x61\x70\x73\
-\x2e\x5f\x5f\x5f\x5f\x66\x6d\x74\0\x2e\x62\x73\x73\0\x2e\x6d\x61\x70\x73\0\x2e\
-\x72\x6f\x64\x61\x74\x61\0\x6c\x69\x63\x65\x6e\x73\x65\0\0\x9f\xeb\x01\0\x20\0\
-\0\0\0\0\0\0\x14\0\0\0\x14\0\0\0\x7c\x01\0\0\x90\x01\0\0\x1c\0\0\0\x08\0\0\0\
-\x32\x01\0\0\x01\0\0\0\0\0\0\0\x2c\0\0\0\x10\0\0\0\x32\x01\0\0\x17\0\0\0\0\0\0\
-\0\x58\x01\0\0\xb4\x01\0\0\x21\xd4\0\0\x08\0\0\0\x58\x01\0\0\xb4\x01\0\0\x09\
-\xd4\0\0\x18\0\0\0\x58\x01\0\0\xd8\x01\0\0\x0b\xdc\0\0\x30\0\0\0\x58\x01\0\0\
-\xd8\x01\0\0\x09\xdc\0\0\x38\0\0\0\x58\x01\0\0\xd8\x01\0\0\x0b\xdc\0\0\x58\0\0\
-\0\x58\x01\0\0\0\x02\0\0\x09\xe4\0\0\x60\0\0\0\x58\x01\0\0\x1e\x02\0\0\x2e\xe8\
-\0\0\x68\0\0\0\x58\x01\0\0\x1e\x02\0\0\x2a\xe8\0\0\x80\0\0\0\x58\x01\0\0\x1e\
-\x02\0\0\x09\xe8\0\0\x88\0\0\0\x58\x01\0\0\x54\x02\0\0\x0d\xec\0\0\x98\0\0\0\
-\x58\x01\0\0\x65\x02\0\0\x05\xf8\0\0\xe0\0\0\0\x58\x01\0\0\xa5\x02\0\0\x05\xfc\
-\0\0\x10\x01\0\0\x58\x01\0\0\xe6\x02\0\0\x05\0\x01\0\x40\x01\0\0\x58\x01\0\0\
-\x2b\x03\0\0\x05\x04\x01\0\x70\x01\0\0\x58\x01\0\0\x2b\x03\0\0\x05\x08\x01\0\
-\xa0\x01\0\0\x58\x01\0\0\x6f\x03\0\0\x05\x0c\x01\0\xd0\x01\0\0\x58\x01\0\0\x91\
-\x03\0\0\x1c\x10\x01\0\xd8\x01\0\0\x58\x01\0\0\x91\x03\0\0\x1a\x10\x01\0\xe0\
-\x01\0\0\x58\x01\0\0\xb1\x03\0\0\x1e\x14\x01\0\xe8\x01\0\0\x58\x01\0\0\xb1\x03\
-\0\0\x1c\x14\x01\0\xf0\x01\0\0\x58\x01\0\0\xda\x03\0\0\x05\x18\x01\0\x08\x02\0\
-\0\x58\x01\0\0\xf8\x03\0\0\x05\x1c\x01\0\x30\x02\0\0\x2b\x04\0\0\x86\x04\0\0\
-\x02\x78\0\0\x10\0\0\0\x32\x01\0\0\x01\0\0\0\0\0\0\0\x22\0\0\0\x54\x01\0\0\0\0\
-\0\0\0\0\0\0\x0c\0\0\0\xff\xff\xff\xff\x04\0\x08\0\x08\x7c\x0b\0\x14\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x40\x02\0\0\0\0\0\0\x0c\x01\0\0\x04\0\x9a\0\0\0\x08\x01\
-\x01\xfb\x0e\x0d\0\x01\x01\x01\x01\0\0\0\x01\0\0\x01\x2e\x2f\x69\x6e\x63\x6c\
-\x75\x64\x65\0\x2e\x2f\x69\x6e\x63\x6c\x75\x64\x65\x2f\x62\x70\x66\0\x73\x72\
-\x63\0\x2f\x75\x73\x72\x2f\x69\x6e\x63\x6c\x75\x64\x65\x2f\x62\x70\x66\0\0\x63\
-\x6f\x6d\x6d\x6f\x6e\x2e\x68\0\x01\0\0\x61\x6e\x61\x6c\x79\x7a\x65\x5f\x6d\x61\
-\x70\x2e\x68\0\x02\0\0\x65\x62\x70\x66\x5f\x70\x65\x72\x66\x6f\x72\x6d\x61\x6e\
-\x63\x65\x2e\x62\x70\x66\x2e\x63\0\x03\0\0\x76\x6d\x6c\x69\x6e\x75\x78\x2e\x68\
-\0\x01\0\0\x62\x70\x66\x5f\x68\x65\x6c\x70\x65\x72\x5f\x64\x65\x66\x73\x2e\x68\
-\0\x04\0\0\0\x04\x02\x05\x21\x0a\0\x09\x02\0\0\0\0\0\0\0\0\x03\x34\x01\x05\x09\
-\x06\x20\x05\x0b\x06\x30\x05\x09\x06\x3c\x05\x0b\x20\x05\x09\x06\x4c\x05\x2e\
-\x21\x05\x2a\x06\x20\x05\x09\x3c\x05\x0d\x06\x21\x06\x03\x45\x20\x05\x05\x06\
-\x03\x3e\x20\x91\x67\x67\x67\x67\x06\x03\xbd\x7f\x58\x05\x1c\x06\x03\xc4\0\x20\
-\x05\x1a\x06\x20\x05\x1e\x06\x21\x05\x1c\x06\x20\x05\x05\x06\x21\x3d\x04\x03\
-\x05\x02\x03\x57\x58\x02\x02\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\x01\0\0\x04\0\xf1\xff\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\
-\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x4a\x01\0\0\0\0\x03\0\x90\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\x43\x01\0\0\0\0\x03\0\x30\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x2f\
-\0\0\0\x01\0\x08\0\0\0\0\0\0\0\0\0\x13\0\0\0\0\0\0\0\0\0\0\0\x03\0\x08\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\x09\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\x03\0\x0a\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\x0d\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x03\0\x12\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\x03\0\x14\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\x12\0\x03\0\0\0\
-\0\0\0\0\0\0\x40\x02\0\0\0\0\0\0\xb1\0\0\0\x11\0\x05\0\0\0\0\0\0\0\0\0\x08\0\0\
-\0\0\0\0\0\x98\0\0\0\x11\0\x07\0\x10\0\0\0\0\0\0\0\x20\0\0\0\0\0\0\0\x87\0\0\0\
-\x11\0\x07\0\x30\0\0\0\0\0\0\0\x20\0\0\0\0\0\0\0\x80\0\0\0\x11\0\x07\0\x50\0\0\
-\0\0\0\0\0\x20\0\0\0\0\0\0\0\x91\0\0\0\x11\0\x07\0\x70\0\0\0\0\0\0\0\x20\0\0\0\
-\0\0\0\0\x17\x01\0\0\x11\0\x07\0\0\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\x3b\x01\0\0\
-\x11\0\x06\0\0\0\0\0\0\0\0\0\x0d\0\0\0\0\0\0\0\xc9\0\0\0\x11\0\x05\0\x08\0\0\0\
-\0\0\0\0\x04\0\0\0\0\0\0\0\x18\0\0\0\0\0\0\0\x01\0\0\0\x0d\0\0\0\xb0\0\0\0\0\0\
-\0\0\x01\0\0\0\x0e\0\0\0\xe0\0\0\0\0\0\0\0\x01\0\0\0\x0f\0\0\0\x10\x01\0\0\0\0\
-\0\0\x01\0\0\0\x10\0\0\0\x40\x01\0\0\0\0\0\0\x01\0\0\0\x11\0\0\0\x70\x01\0\0\0\
-\0\0\0\x01\0\0\0\x11\0\0\0\xa0\x01\0\0\0\0\0\0\x01\0\0\0\x12\0\0\0\x10\x02\0\0\
-\0\0\0\0\x01\0\0\0\x06\0\0\0\x06\0\0\0\0\0\0\0\x03\0\0\0\x08\0\0\0\x0c\0\0\0\0\
-\0\0\0\x03\0\0\0\x09\0\0\0\x12\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x16\0\0\0\0\0\
-\0\0\x03\0\0\0\x0b\0\0\0\x1a\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x1e\0\0\0\0\0\0\
-\0\x02\0\0\0\x02\0\0\0\x2b\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x37\0\0\0\0\0\0\0\
-\x02\0\0\0\x0d\0\0\0\x49\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x50\0\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\x57\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x63\0\0\0\0\0\0\0\
-\x02\0\0\0\x13\0\0\0\x78\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x7f\0\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\x86\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x92\0\0\0\0\0\0\0\
-\x02\0\0\0\x14\0\0\0\x9f\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xa7\0\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\xad\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xb4\0\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\xbb\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xc7\0\0\0\0\0\0\0\
-\x02\0\0\0\x0e\0\0\0\xd4\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xe0\0\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\xec\0\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xf8\0\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\x16\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x38\x01\0\0\0\0\0\
-\0\x03\0\0\0\x09\0\0\0\x43\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x53\x01\0\0\0\0\
-\0\0\x03\0\0\0\x09\0\0\0\x5e\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x65\x01\0\0\0\
-\0\0\0\x03\0\0\0\x09\0\0\0\x71\x01\0\0\0\0\0\0\x02\0\0\0\x0f\0\0\0\x7e\x01\0\0\
-\0\0\0\0\x03\0\0\0\x09\0\0\0\x8a\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x96\x01\0\
-\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xa2\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xc0\x01\
-\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xcc\x01\0\0\0\0\0\0\x02\0\0\0\x10\0\0\0\xd9\
-\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xe5\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\
-\xf1\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xfd\x01\0\0\0\0\0\0\x03\0\0\0\x09\0\0\
-\0\x1b\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x27\x02\0\0\0\0\0\0\x02\0\0\0\x11\0\
-\0\0\x34\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x40\x02\0\0\0\0\0\0\x03\0\0\0\x09\
-\0\0\0\x4c\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x58\x02\0\0\0\0\0\0\x03\0\0\0\
-\x09\0\0\0\x76\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x82\x02\0\0\0\0\0\0\x02\0\0\
-\0\x12\0\0\0\x8f\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x9b\x02\0\0\0\0\0\0\x03\0\
-\0\0\x09\0\0\0\xb9\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xc9\x02\0\0\0\0\0\0\x03\
-\0\0\0\x09\0\0\0\xdd\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xed\x02\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\xf9\x02\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x0c\x03\0\0\0\0\0\
-\0\x03\0\0\0\x09\0\0\0\x14\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x20\x03\0\0\0\0\
-\0\0\x02\0\0\0\x06\0\0\0\x3b\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x65\x03\0\0\0\
-\0\0\0\x03\0\0\0\x09\0\0\0\x73\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x99\x03\0\0\
-\0\0\0\0\x03\0\0\0\x09\0\0\0\xb6\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xe5\x03\0\
-\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xeb\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xf1\x03\
-\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xf7\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xfe\
-\x03\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x0a\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\
-\x15\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x20\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\
-\0\x2b\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x36\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\
-\0\0\x41\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x4d\x04\0\0\0\0\0\0\x03\0\0\0\x09\
-\0\0\0\x5f\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x6a\x04\0\0\0\0\0\0\x03\0\0\0\
-\x09\0\0\0\x79\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x88\x04\0\0\0\0\0\0\x03\0\0\
-\0\x09\0\0\0\x97\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xa7\x04\0\0\0\0\0\0\x03\0\
-\0\0\x09\0\0\0\xb0\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xbd\x04\0\0\0\0\0\0\x03\
-\0\0\0\x09\0\0\0\xca\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xd7\x04\0\0\0\0\0\0\
-\x03\0\0\0\x09\0\0\0\xe5\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\xec\x04\0\0\0\0\0\
-\0\x03\0\0\0\x09\0\0\0\xff\x04\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x12\x05\0\0\0\0\
-\0\0\x02\0\0\0\x02\0\0\0\x20\x05\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x2b\x05\0\0\0\
-\0\0\0\x03\0\0\0\x07\0\0\0\x2f\x05\0\0\0\0\0\0\x03\0\0\0\x09\0\0\0\x3e\x05\0\0\
-\0\0\0\0\x02\0\0\0\x02\0\0\0\x4e\x05\0\0\0\0\0\0\x03\0\0\0\x07\0\0\0\x57\x05\0\
-\0\0\0\0\0\x03\0\0\0\x07\0\0\0\x70\x05\0\0\0\0\0\0\x02\0\0\0\x02\0\0\0\x7d\x05\
-\0\0\0\0\0\0\x03\0\0\0\x07\0\0\0\xc0\x04\0\0\0\0\0\0\x04\0\0\0\x0d\0\0\0\xcc\
-\x04\0\0\0\0\0\0\x04\0\0\0\x14\0\0\0\xe4\x04\0\0\0\0\0\0\x04\0\0\0\x12\0\0\0\
-\xf0\x04\0\0\0\0\0\0\x04\0\0\0\x0e\0\0\0\xfc\x04\0\0\0\0\0\0\x04\0\0\0\x0f\0\0\
-\0\x08\x05\0\0\0\0\0\0\x04\0\0\0\x10\0\0\0\x14\x05\0\0\0\0\0\0\x04\0\0\0\x11\0\
-\0\0\x2c\x05\0\0\0\0\0\0\x03\0\0\0\x06\0\0\0\x44\x05\0\0\0\0\0\0\x04\0\0\0\x13\
-\0\0\0\x2c\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x40\0\0\0\0\0\0\0\x04\0\0\0\x02\0\
-\0\0\x50\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x60\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\
-\0\x70\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x80\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\
-\x90\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xa0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\
-\xb0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xc0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\
-\xd0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xe0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\
-\xf0\0\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\0\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\
-\x10\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x20\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\
-\0\x30\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x40\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\
-\0\0\x50\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x60\x01\0\0\0\0\0\0\x04\0\0\0\x02\
-\0\0\0\x70\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x80\x01\0\0\0\0\0\0\x04\0\0\0\
-\x02\0\0\0\x90\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\xa0\x01\0\0\0\0\0\0\x04\0\0\
-\0\x02\0\0\0\xbc\x01\0\0\0\0\0\0\x04\0\0\0\x02\0\0\0\x14\0\0\0\0\0\0\0\x03\0\0\
-\0\x0a\0\0\0\x18\0\0\0\0\0\0\0\x02\0\0\0\x02\0\0\0\xac\0\0\0\0\0\0\0\x02\0\0\0\
-\x02\0\0\0\x0c\x0d\x13\x12\x0e\x0f\x10\x11\x05\0\x74\x70\x5f\x73\x79\x73\x5f\
-\x65\x6e\x74\x72\x79\0\x2e\x64\x65\x62\x75\x67\x5f\x61\x62\x62\x72\x65\x76\0\
-\x2e\x74\x65\x78\x74\0\x2e\x72\x65\x6c\x2e\x42\x54\x46\x2e\x65\x78\x74\0\x61\
-\x6e\x61\x6c\x79\x7a\x65\x5f\x6d\x61\x70\x73\x2e\x5f\x5f\x5f\x5f\x66\x6d\x74\0\
-\x2e\x62\x73\x73\0\x2e\x6d\x61\x70\x73\0\x2e\x64\x65\x62\x75\x67\x5f\x73\x74\
-\x72\0\x2e\x72\x65\x6c\x74\x72\x61\x63\x65\x70\x6f\x69\x6e\x74\x2f\x72\x61\x77\
-\x5f\x73\x79\x73\x63\x61\x6c\x6c\x73\x2f\x73\x79\x73\x5f\x65\x6e\x74\x65\x72\0\
-\x70\x65\x72\x63\x70\x75\x5f\x61\x72\x72\x61\x79\x5f\x6d\x61\x70\0\x70\x65\x72\
-\x63\x70\x75\x5f\x68\x61\x73\x68\x5f\x6d\x61\x70\0\x2e\x72\x65\x6c\x2e\x64\x65\
-\x62\x75\x67\x5f\x69\x6e\x66\x6f\0\x6b\0\x2e\x6c\x6c\x76\x6d\x5f\x61\x64\x64\
-\x72\x73\x69\x67\0\x6c\x69\x63\x65\x6e\x73\x65\0\x65\x76\x65\x6e\x74\x5f\x74\
-\x79\x70\x65\0\x2e\x72\x65\x6c\x2e\x64\x65\x62\x75\x67\x5f\x6c\x69\x6e\x65\0\
-\x2e\x72\x65\x6c\x2e\x64\x65\x62\x75\x67\x5f\x66\x72\x61\x6d\x65\0\x2e\x64\x65\
-\x62\x75\x67\x5f\x6c\x6f\x63\0\x65\x62\x70\x66\x5f\x70\x65\x72\x66\x6f\x72\x6d\
-\x61\x6e\x63\x65\x2e\x62\x70\x66\x2e\x63\0\x72\x62\0\x2e\x73\x74\x72\x74\x61\
-\x62\0\x2e\x73\x79\x6d\x74\x61\x62\0\x2e\x72\x6f\x64\x61\x74\x61\0\x2e\x72\x65\
-\x6c\x2e\x42\x54\x46\0\x4c\x49\x43\x45\x4e\x53\x45\0\x4c\x42\x42\x30\x5f\x34\0\
-\x4c\x42\x42\x30\x5f\x32\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\x1a\x01\0\0\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x81\x26\0\0\0\
-\0\0\0\x51\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x1c\0\0\0\x01\0\0\0\x06\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x5e\0\0\0\x01\0\0\
-\0\x06\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x40\0\0\0\0\0\0\0\x40\x02\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x5a\0\0\0\x09\0\0\0\x40\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\x68\x1d\0\0\0\0\0\0\x80\0\0\0\0\0\0\0\x17\0\0\0\x03\0\0\
-\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\x44\0\0\0\x08\0\0\0\x03\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\x80\x02\0\0\0\0\0\0\x0c\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x08\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\xc1\0\0\0\x01\0\0\0\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x80\x02\0\0\0\0\0\0\x0d\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\x49\0\0\0\x01\0\0\0\x03\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x90\x02\0\0\0\
-\0\0\0\x90\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x08\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x2a\
-\x01\0\0\x01\0\0\0\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x20\x03\0\0\0\0\0\0\x13\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xf5\0\0\0\x01\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x33\x03\0\0\0\0\0\0\xa0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x0e\0\0\0\x01\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\xd3\x03\0\0\0\0\0\0\xf4\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xa5\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\xc7\x05\0\0\0\0\0\0\x89\x05\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\xa1\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xe8\
-\x1d\0\0\0\0\0\0\x40\x06\0\0\0\0\0\0\x17\0\0\0\x0b\0\0\0\x08\0\0\0\0\0\0\0\x10\
-\0\0\0\0\0\0\0\x4f\0\0\0\x01\0\0\0\x30\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x50\x0b\0\
-\0\0\0\0\0\xb8\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\x01\0\0\0\0\0\
-\0\0\x36\x01\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x08\x0e\0\0\0\0\0\0\
-\x5f\x0a\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x32\x01\
-\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x28\x24\0\0\0\0\0\0\x90\0\0\0\
-\0\0\0\0\x17\0\0\0\x0e\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\x26\0\0\0\x01\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x68\x18\0\0\0\0\0\0\xcc\x01\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\x04\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x22\0\0\0\x09\0\0\0\x40\0\0\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\xb8\x24\0\0\0\0\0\0\x90\x01\0\0\0\0\0\0\x17\0\0\0\
-\x10\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\xe8\0\0\0\x01\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\0\0\0\0\0\0\x38\x1a\0\0\0\0\0\0\x28\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x08\
-\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xe4\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\x48\x26\0\0\0\0\0\0\x20\0\0\0\0\0\0\0\x17\0\0\0\x12\0\0\0\x08\0\0\0\0\0\
-\0\0\x10\0\0\0\0\0\0\0\xd8\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x60\
-\x1a\0\0\0\0\0\0\x10\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\
-\0\0\0\0\xd4\0\0\0\x09\0\0\0\x40\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x68\x26\0\0\0\0\
-\0\0\x10\0\0\0\0\0\0\0\x17\0\0\0\x14\0\0\0\x08\0\0\0\0\0\0\0\x10\0\0\0\0\0\0\0\
-\xb3\0\0\0\x03\x4c\xff\x6f\0\0\0\x80\0\0\0\0\0\0\0\0\0\0\0\0\x78\x26\0\0\0\0\0\
-\0\x09\0\0\0\0\0\0\0\x17\0\0\0\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x22\
-\x01\0\0\x02\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x70\x1b\0\0\0\0\0\0\xf8\x01\
-\0\0\0\0\0\0\x01\0\0\0\x0c\0\0\0\x08\0\0\0\0\0\0\0\x18\0\0\0\0\0\0\0";
-
-	*sz = sizeof(data) - 1;
-	return (const void *)data;
-}
-
-#ifdef __cplusplus
-struct ebpf_performance_bpf *ebpf_performance_bpf::open(const struct bpf_object_open_opts *opts) { return ebpf_performance_bpf__open_opts(opts); }
-struct ebpf_performance_bpf *ebpf_performance_bpf::open_and_load() { return ebpf_performance_bpf__open_and_load(); }
-int ebpf_performance_bpf::load(struct ebpf_performance_bpf *skel) { return ebpf_performance_bpf__load(skel); }
-int ebpf_performance_bpf::attach(struct ebpf_performance_bpf *skel) { return ebpf_performance_bpf__attach(skel); }
-void ebpf_performance_bpf::detach(struct ebpf_performance_bpf *skel) { ebpf_performance_bpf__detach(skel); }
-void ebpf_performance_bpf::destroy(struct ebpf_performance_bpf *skel) { ebpf_performance_bpf__destroy(skel); }
-const void *ebpf_performance_bpf::elf_bytes(size_t *sz) { return ebpf_performance_bpf__elf_bytes(sz); }
-#endif /* __cplusplus */
-
-__attribute__((unused)) static void
-ebpf_performance_bpf__assert(struct ebpf_performance_bpf *s __attribute__((unused)))
-{
-#ifdef __cplusplus
-#define _Static_assert static_assert
-#endif
-	_Static_assert(sizeof(s->bss->k) == 8, "unexpected size of 'k'");
-	_Static_assert(sizeof(s->bss->event_type) == 4, "unexpected size of 'event_type'");
-#ifdef __cplusplus
-#undef _Static_assert
-#endif
-}
-
-#endif /* __EBPF_PERFORMANCE_BPF_SKEL_H__ */
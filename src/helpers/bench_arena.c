@@ -0,0 +1,278 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// BPF arena benchmark.
+#include "bench_arena.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_util.h"
+#include "common.h"
+#include "arena.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const __u32 arena_sizes[] = {1024, 16384, 262144, 1048576};
+
+// arena 相关的map与程序只在 clang 支持地址空间转换时生成，按名字查找
+// 以便在没有它们的骨架上也能编译
+struct arena_bench {
+	struct arena_bpf *skel;
+	struct bpf_map *arena;
+	struct bpf_program *alloc;
+	struct bpf_program *insert;
+	struct bpf_program *lookup;
+	struct arena_slot *table;
+	__u32 nr_keys;
+	__u32 nr_slots;
+	__u32 nr_pages;
+	__u64 nop_ns;
+};
+
+static void arena_print(__u32 size, bool kernel, const char *structure,
+                        const char *op, __u32 ops, double avg, double hit_pct,
+                        long long mem) {
+	printf("%-8u %-6s %-6s %-7s %-8u %-10.1f %-7.1f %-10lld\n", size,
+	       kernel ? "kernel" : "user", structure, op, ops, avg, hit_pct,
+	       mem >= 0 ? mem / 1024 : -1);
+	fflush(stdout);
+	BENCH_OUTPUT("arena", BF_U64("keys", size),
+	             BF_STR("side", kernel ? "kernel" : "user"),
+	             BF_STR("struct", structure), BF_STR("op", op),
+	             BF_U64("ops", ops), BF_F64("avg_ns", avg),
+	             BF_F64("hit_pct", hit_pct >= 0 ? hit_pct : NAN),
+	             BF_I64("mem_bytes", mem));
+}
+
+static void arena_user_insert(struct arena_slot *table, __u32 nr_slots,
+                              __u64 key) {
+	__u32 mask = nr_slots - 1, idx = arena_slot_hash(key, mask);
+
+	for (int i = 0; i < ARENA_MAX_PROBES; i++) {
+		struct arena_slot *slot = &table[(idx + i) & mask];
+
+		if (slot->key == 0) {
+			slot->value = key;
+			slot->key = key;
+			return;
+		}
+	}
+}
+
+static bool arena_user_lookup(struct arena_slot *table, __u32 nr_slots,
+                              __u64 key) {
+	__u32 mask = nr_slots - 1, idx = arena_slot_hash(key, mask);
+
+	for (int i = 0; i < ARENA_MAX_PROBES; i++) {
+		struct arena_slot *slot = &table[(idx + i) & mask];
+
+		if (slot->key == key)
+			return true;
+		if (slot->key == 0)
+			return false;
+	}
+	return false;
+}
+
+// 内核态执行 repeat 次，从 seq 开始生成key，扣除空程序开销
+static int arena_kernel_run(struct arena_bench *b, struct bpf_program *prog,
+                            __u64 seq, __u32 repeat, double *avg) {
+	__u64 avg_ns;
+	int err;
+
+	b->skel->bss->arena_seq = seq;
+	b->skel->bss->arena_hits = 0;
+	err = bench_prog_run(bpf_program__fd(prog), repeat, &avg_ns);
+	if (err) {
+		fprintf(stderr, "Failed to run %s: %d\n", bpf_program__name(prog),
+		        err);
+		return err;
+	}
+	*avg = avg_ns > b->nop_ns ? avg_ns - b->nop_ns : 0;
+	return 0;
+}
+
+static int arena_open(struct arena_bench *b, __u32 nr_keys) {
+	static const char *const progs[] = {
+	    "bench_nop",    "arena_alloc",       "arena_insert",
+	    "arena_lookup", "arena_hash_insert", "arena_hash_lookup",
+	};
+	long page_size = sysconf(_SC_PAGESIZE);
+	LIBBPF_OPTS(bpf_test_run_opts, opts);
+	size_t mmap_size;
+	int err;
+
+	memset(b, 0, sizeof(*b));
+	b->nr_keys = nr_keys;
+	// 负载因子不超过0.5，且整个表至少占一页
+	b->nr_slots = 1;
+	while (b->nr_slots < nr_keys * 2 ||
+	       b->nr_slots * sizeof(struct arena_slot) < (size_t)page_size)
+		b->nr_slots <<= 1;
+	b->nr_pages = b->nr_slots * sizeof(struct arena_slot) / page_size;
+
+	b->skel = BENCH_SKEL_OPEN(arena);
+	if (!b->skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return -errno;
+	}
+	bench_autoload_only(b->skel->obj, progs, sizeof(progs) / sizeof(progs[0]));
+	b->arena = bpf_object__find_map_by_name(b->skel->obj, "arena");
+	b->alloc = bpf_object__find_program_by_name(b->skel->obj, "arena_alloc");
+	b->insert = bpf_object__find_program_by_name(b->skel->obj, "arena_insert");
+	b->lookup = bpf_object__find_program_by_name(b->skel->obj, "arena_lookup");
+	if (!b->arena || !b->alloc || !b->insert || !b->lookup) {
+		printf("arena: skipped, BPF object built without arena support "
+		       "(needs clang >= 18)\n");
+		return 1;
+	}
+	if (!bpf_map__autocreate(b->arena)) {
+		printf("arena: skipped, BPF_MAP_TYPE_ARENA not supported by the "
+		       "running kernel or libbpf\n");
+		return 1;
+	}
+	bpf_map__set_max_entries(b->arena, b->nr_pages);
+	bpf_map__set_max_entries(b->skel->maps.arena_hash_map, nr_keys);
+	b->skel->bss->arena_nr_slots = b->nr_slots;
+	b->skel->bss->arena_nr_pages = b->nr_pages;
+	b->skel->bss->arena_nr_keys = nr_keys;
+	err = BENCH_SKEL_LOAD(arena, b->skel);
+	if (err) {
+		fprintf(stderr, "Failed to load arena programs: %d\n", err);
+		return err;
+	}
+
+	// 分配哈希表所在的页，第一次分配位于 arena 起始处
+	err = bpf_prog_test_run_opts(bpf_program__fd(b->alloc), &opts);
+	if (err || opts.retval) {
+		fprintf(stderr, "Failed to allocate arena pages: %d/%u\n", err,
+		        opts.retval);
+		return err ? err : -ENOMEM;
+	}
+	b->table = bpf_map__initial_value(b->arena, &mmap_size);
+	// 较旧的 libbpf 不把 arena 映射到用户态，与缺少其他特性时一样跳过
+	if (!b->table || mmap_size < (size_t)b->nr_pages * page_size) {
+		printf("arena: skipped, libbpf does not map the arena into user "
+		       "space\n");
+		return 1;
+	}
+	err = bench_prog_run(bpf_program__fd(b->skel->progs.bench_nop), nr_keys,
+	                     &b->nop_ns);
+	if (err) {
+		fprintf(stderr, "Failed to run bench_nop: %d\n", err);
+		return err;
+	}
+	return 0;
+}
+
+// 一种容量下的全部测量: 用户态写入前一半key、内核态写入后一半，再双方全量查找
+static int arena_run_one(struct arena_bench *b) {
+	int hash_fd = bpf_map__fd(b->skel->maps.arena_hash_map);
+	__u32 nr = b->nr_keys, half = nr / 2, hits;
+	long long arena_mem = (long long)b->nr_pages * sysconf(_SC_PAGESIZE);
+	__u64 start, key, val;
+	double avg;
+	int err;
+
+	start = bench_now_ns();
+	for (key = 1; key <= half; key++)
+		arena_user_insert(b->table, b->nr_slots, key);
+	arena_print(nr, false, "arena", "insert", half,
+	            (double)(bench_now_ns() - start) / half, -1, arena_mem);
+	start = bench_now_ns();
+	for (key = 1; key <= half; key++) {
+		if (bpf_map_update_elem(hash_fd, &key, &key, BPF_NOEXIST)) {
+			fprintf(stderr, "Failed to fill arena_hash_map: %d\n", errno);
+			return -errno;
+		}
+	}
+	arena_print(nr, false, "hash", "insert", half,
+	            (double)(bench_now_ns() - start) / half, -1, -1);
+
+	err = arena_kernel_run(b, b->insert, half, nr - half, &avg);
+	if (err)
+		return err;
+	arena_print(nr, true, "arena", "insert", nr - half, avg, -1, arena_mem);
+	err = arena_kernel_run(b, b->skel->progs.arena_hash_insert, half, nr - half,
+	                       &avg);
+	if (err)
+		return err;
+	arena_print(nr, true, "hash", "insert", nr - half, avg, -1,
+	            bench_map_memlock(hash_fd));
+
+	hits = 0;
+	start = bench_now_ns();
+	for (key = 1; key <= nr; key++)
+		hits += arena_user_lookup(b->table, b->nr_slots, key);
+	arena_print(nr, false, "arena", "lookup", nr,
+	            (double)(bench_now_ns() - start) / nr, 100.0 * hits / nr,
+	            arena_mem);
+	hits = 0;
+	start = bench_now_ns();
+	for (key = 1; key <= nr; key++)
+		hits += bpf_map_lookup_elem(hash_fd, &key, &val) == 0;
+	arena_print(nr, false, "hash", "lookup", nr,
+	            (double)(bench_now_ns() - start) / nr, 100.0 * hits / nr, -1);
+
+	err = arena_kernel_run(b, b->lookup, 0, nr, &avg);
+	if (err)
+		return err;
+	arena_print(nr, true, "arena", "lookup", nr, avg,
+	            100.0 * b->skel->bss->arena_hits / nr, arena_mem);
+	err = arena_kernel_run(b, b->skel->progs.arena_hash_lookup, 0, nr, &avg);
+	if (err)
+		return err;
+	arena_print(nr, true, "hash", "lookup", nr, avg,
+	            100.0 * b->skel->bss->arena_hits / nr,
+	            bench_map_memlock(hash_fd));
+	return 0;
+}
+
+int bench_arena(volatile bool *exiting) {
+	struct arena_bench b;
+	int err = 0;
+
+	printf("%-8s %-6s %-6s %-7s %-8s %-10s %-7s %-10s\n", "SIZE", "SIDE",
+	       "STRUCT", "OP", "OPS", "AVG(ns)", "HIT%", "MEM(KB)");
+	for (size_t s = 0; s < sizeof(arena_sizes) / sizeof(__u32) && !*exiting;
+	     s++) {
+		err = arena_open(&b, arena_sizes[s]);
+		if (!err)
+			err = arena_run_one(&b);
+		arena_bpf__destroy(b.skel);
+		// 不支持 arena 时整体跳过，不视为失败
+		if (err > 0)
+			return 0;
+		if (err)
+			return err;
+	}
+	return 0;
+}
+
+// arena map不支持时由基准测试自身跳过
+static const struct bench_feature arena_feats[] = {
+    BENCH_PROG(SCHED_CLS), BENCH_PROG(SYSCALL), BENCH_MAP(HASH),
+};
+
+BENCH_REGISTER(arena) = {
+    .name = "arena",
+    .key = 'r',
+    .doc = "Benchmark a hash table in a BPF arena against a hash map",
+    .feats = arena_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(arena_feats),
+    .schema = "keys,side,struct,op,ops,avg_ns,hit_pct,mem_bytes",
+    .run = bench_arena,
+};
@@ -0,0 +1,283 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Bloom filter map benchmark.
+#include "bench_bloom.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_timer.h"
+#include "bench_util.h"
+#include "bloom.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOOM_MAX_HASH_FUNCS 10
+// 误判率统计时查询的不存在key个数
+#define BLOOM_FP_QUERIES 65536
+
+static const __u32 bloom_sizes[] = {1024, 16384, 262144};
+static const __u32 bloom_hit_pcts[] = {0, 10, 50, 90, 100};
+
+// 打印一行结果，hit_pct/hash_hit_pct/fp_rate 小于0表示不适用
+static void bloom_print(__u32 size, __u32 nr_hash, bool kernel, const char *op,
+                        int hit_pct, __u32 ops, const struct bench_lat *lat,
+                        double hash_hit_pct, double fp_rate) {
+	char hit[8] = "-", hash_hit[16] = "-", fp[16] = "-";
+
+	if (hit_pct >= 0)
+		snprintf(hit, sizeof(hit), "%d", hit_pct);
+	if (hash_hit_pct >= 0)
+		snprintf(hash_hit, sizeof(hash_hit), "%.1f", hash_hit_pct);
+	if (fp_rate >= 0)
+		snprintf(fp, sizeof(fp), "%.6f", fp_rate);
+	printf("%-8u %-8u %-6s %-12s %-5s %-8u %-10.1f ", size, nr_hash,
+	       kernel ? "kernel" : "user", op, hit, ops, lat->avg);
+	if (kernel)
+		printf("%-10s %-10s ", "-", "-");
+	else
+		printf("%-10.0f %-10.0f ", lat->p50, lat->p99);
+	printf("%-9s %-10s\n", hash_hit, fp);
+	fflush(stdout);
+	BENCH_OUTPUT("bloom", BF_U64("max_entries", size),
+	             BF_U64("nr_hash_funcs", nr_hash),
+	             BF_STR("side", kernel ? "kernel" : "user"), BF_STR("op", op),
+	             BF_F64("hit_pct", hit_pct >= 0 ? hit_pct : NAN),
+	             BF_U64("ops", ops), BF_F64("avg_ns", lat->avg),
+	             BF_F64("p50_ns", kernel ? NAN : lat->p50),
+	             BF_F64("p99_ns", kernel ? NAN : lat->p99),
+	             BF_F64("hash_hit_pct", hash_hit_pct >= 0 ? hash_hit_pct : NAN),
+	             BF_F64("fp_rate", fp_rate >= 0 ? fp_rate : NAN));
+}
+
+// 内核态测量: 从 seq 开始执行 repeat 次，扣除空程序开销
+static int bloom_kernel_run(struct bloom_bpf *skel, struct bpf_program *prog,
+                            __u64 seq, __u32 repeat, __u64 nop_ns,
+                            struct bench_lat *lat) {
+	__u64 avg_ns;
+	int err;
+
+	skel->bss->bloom_seq = seq;
+	err = bench_prog_run(bpf_program__fd(prog), repeat, &avg_ns);
+	if (err) {
+		fprintf(stderr, "Failed to run %s: %d\n", bpf_program__name(prog),
+		        err);
+		return err;
+	}
+	memset(lat, 0, sizeof(*lat));
+	lat->avg = avg_ns > nop_ns ? avg_ns - nop_ns : 0;
+	return 0;
+}
+
+// 用户态 push [first, first + nr) 或查询这些key，返回查询命中次数
+static int bloom_user_run(int fd, bool push, __u64 first, __u32 nr,
+                          __u64 *samples, __u32 *hits) {
+	__u64 start, key;
+	int err;
+
+	*hits = 0;
+	for (__u32 i = 0; i < nr; i++) {
+		key = first + i;
+		start = bench_timer_start();
+		if (push)
+			err = bpf_map_update_elem(fd, NULL, &key, BPF_ANY);
+		else
+			err = bpf_map_lookup_elem(fd, NULL, &key);
+		samples[i] = bench_timer_ns(start, bench_timer_stop());
+		if (!err) {
+			(*hits)++;
+		} else if (push || err != -ENOENT) {
+			fprintf(stderr, "bloom %s failed: %d\n", push ? "push" : "peek",
+			        err);
+			return err;
+		}
+	}
+	return 0;
+}
+
+// 端到端查找 size 次并输出一行: HASH_HIT% 为实测的 hash 命中比例，
+// 先查过滤器时 FP_RATE 为不存在的key中通过过滤器(仍去查 hash)的比例
+static int bloom_e2e_run(struct bloom_bpf *skel, struct bpf_program *prog,
+                         __u32 size, __u32 nr_hash, const char *op,
+                         __u32 hit_pct, __u64 nop_ns) {
+	bool filtered = prog == skel->progs.bloom_then_hash;
+	__u64 hits, misses, passed;
+	struct bench_lat lat;
+	int err;
+
+	skel->bss->bloom_hash_hits = 0;
+	skel->bss->bloom_hash_lookups = 0;
+	err = bloom_kernel_run(skel, prog, 0, size, nop_ns, &lat);
+	if (err)
+		return err;
+	hits = skel->bss->bloom_hash_hits;
+	misses = size > hits ? size - hits : 0;
+	passed = skel->bss->bloom_hash_lookups - hits;
+	bloom_print(size, nr_hash, true, op, hit_pct, size, &lat,
+	            100.0 * hits / size,
+	            filtered && misses ? (double)passed / misses : -1);
+	return 0;
+}
+
+static struct bloom_bpf *bloom_open(__u32 size, __u32 nr_hash) {
+	static const char *const progs[] = {
+	    "bench_nop",       "bloom_kern_push", "bloom_kern_peek",
+	    "bloom_then_hash", "hash_only",
+	};
+	struct bloom_bpf *skel;
+	int err;
+
+	skel = BENCH_SKEL_OPEN(bloom);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return NULL;
+	}
+	bench_autoload_only(skel->obj, progs, sizeof(progs) / sizeof(progs[0]));
+	bpf_map__set_max_entries(skel->maps.bloom_map, size);
+	bpf_map__set_map_extra(skel->maps.bloom_map, nr_hash);
+	bpf_map__set_max_entries(skel->maps.bloom_hash_map, size);
+	err = BENCH_SKEL_LOAD(bloom, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load bloom filter programs: %d\n", err);
+		bloom_bpf__destroy(skel);
+		// 与 libbpf 一致: 返回NULL时错误码在 errno 中
+		errno = -err;
+		return NULL;
+	}
+	return skel;
+}
+
+// 一组(容量, 哈希函数个数)下的全部测量
+static int bloom_run_one(struct bloom_bpf *skel, __u32 size, __u32 nr_hash,
+                         __u64 *samples) {
+	int bloom_fd = bpf_map__fd(skel->maps.bloom_map);
+	int hash_fd = bpf_map__fd(skel->maps.bloom_hash_map);
+	__u32 half = size / 2, hits;
+	struct bench_lat lat;
+	char phase[64];
+	__u64 nop_ns, key;
+	int err;
+
+	err = bench_prog_run(bpf_program__fd(skel->progs.bench_nop), size, &nop_ns);
+	if (err) {
+		fprintf(stderr, "Failed to run bench_nop: %d\n", err);
+		return err;
+	}
+
+	// push: 用户态写入前一半key，内核态写入后一半key
+	err = bloom_user_run(bloom_fd, true, 0, half, samples, &hits);
+	if (err)
+		return err;
+	snprintf(phase, sizeof(phase), "bloom/%u/%u/push", size, nr_hash);
+	bench_lat_summarize(phase, samples, half, &lat);
+	bloom_print(size, nr_hash, false, "push", -1, half, &lat, -1, -1);
+	err = bloom_kernel_run(skel, skel->progs.bloom_kern_push, half,
+	                       size - half, nop_ns, &lat);
+	if (err)
+		return err;
+	bloom_print(size, nr_hash, true, "push", -1, size - half, &lat, -1, -1);
+
+	// peek: 命中的key需要计算全部哈希，不存在的key通常提前返回
+	err = bloom_user_run(bloom_fd, false, 0, size, samples, &hits);
+	if (err)
+		return err;
+	snprintf(phase, sizeof(phase), "bloom/%u/%u/peek_hit", size, nr_hash);
+	bench_lat_summarize(phase, samples, size, &lat);
+	bloom_print(size, nr_hash, false, "peek_hit", -1, size, &lat, -1, -1);
+	err = bloom_kernel_run(skel, skel->progs.bloom_kern_peek, 0, size, nop_ns,
+	                       &lat);
+	if (err)
+		return err;
+	bloom_print(size, nr_hash, true, "peek_hit", -1, size, &lat, -1, -1);
+
+	// 查询从未写入的key，返回"可能存在"的比例即误判率
+	err = bloom_user_run(bloom_fd, false, size, BLOOM_FP_QUERIES, samples,
+	                     &hits);
+	if (err)
+		return err;
+	snprintf(phase, sizeof(phase), "bloom/%u/%u/peek_miss", size, nr_hash);
+	bench_lat_summarize(phase, samples, BLOOM_FP_QUERIES, &lat);
+	bloom_print(size, nr_hash, false, "peek_miss", -1, BLOOM_FP_QUERIES, &lat,
+	            -1, (double)hits / BLOOM_FP_QUERIES);
+	err = bloom_kernel_run(skel, skel->progs.bloom_kern_peek, size,
+	                       BLOOM_FP_QUERIES, nop_ns, &lat);
+	if (err)
+		return err;
+	bloom_print(size, nr_hash, true, "peek_miss", -1, BLOOM_FP_QUERIES, &lat,
+	            -1, -1);
+
+	// 端到端: 先查布隆过滤器再查 hash 与只查 hash 的对比
+	for (key = 0; key < size; key++) {
+		if (bpf_map_update_elem(hash_fd, &key, &key, BPF_ANY)) {
+			fprintf(stderr, "Failed to fill bloom_hash_map: %d\n", errno);
+			return -errno;
+		}
+	}
+	skel->bss->bloom_nr_keys = size;
+	for (size_t h = 0; h < sizeof(bloom_hit_pcts) / sizeof(__u32); h++) {
+		skel->bss->bloom_hit_pct = bloom_hit_pcts[h];
+		err = bloom_e2e_run(skel, skel->progs.bloom_then_hash, size, nr_hash,
+		                    "bloom+hash", bloom_hit_pcts[h], nop_ns);
+		if (!err)
+			err = bloom_e2e_run(skel, skel->progs.hash_only, size, nr_hash,
+			                    "hash_only", bloom_hit_pcts[h], nop_ns);
+		if (err)
+			return err;
+	}
+	return 0;
+}
+
+int bench_bloom(volatile bool *exiting) {
+	struct bloom_bpf *skel;
+	__u32 max_size = bloom_sizes[sizeof(bloom_sizes) / sizeof(__u32) - 1];
+	__u64 *samples;
+	int err = 0;
+
+	samples = calloc(max_size > BLOOM_FP_QUERIES ? max_size : BLOOM_FP_QUERIES,
+	                 sizeof(*samples));
+	if (!samples)
+		return -ENOMEM;
+	printf("%-8s %-8s %-6s %-12s %-5s %-8s %-10s %-10s %-10s %-9s %-10s\n",
+	       "SIZE", "NR_HASH", "SIDE", "OP", "HIT%", "OPS", "AVG(ns)", "P50(ns)",
+	       "P99(ns)", "HASH_HIT%", "FP_RATE");
+	for (size_t s = 0; !err && s < sizeof(bloom_sizes) / sizeof(__u32); s++) {
+		for (__u32 k = 1; !err && k <= BLOOM_MAX_HASH_FUNCS && !*exiting; k++) {
+			skel = bloom_open(bloom_sizes[s], k);
+			if (!skel) {
+				err = -errno;
+				break;
+			}
+			err = bloom_run_one(skel, bloom_sizes[s], k, samples);
+			bloom_bpf__destroy(skel);
+		}
+	}
+	free(samples);
+	return err;
+}
+
+static const struct bench_feature bloom_feats[] = {
+    BENCH_PROG(SCHED_CLS), BENCH_MAP(BLOOM_FILTER), BENCH_MAP(HASH),
+};
+
+BENCH_REGISTER(bloom) = {
+    .name = "bloom",
+    .key = 'b',
+    .doc = "Benchmark bloom filter cost, false positives and pre-filtering",
+    .feats = bloom_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(bloom_feats),
+    .schema = "max_entries,nr_hash_funcs,side,op,hit_pct,ops,avg_ns,p50_ns,p99_ns,"
+              "hash_hit_pct,fp_rate",
+    .run = bench_bloom,
+};
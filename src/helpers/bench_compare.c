@@ -0,0 +1,351 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Baseline vs candidate regression comparison.
+#include "bench_compare.h"
+#include "bench_record.h"
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// bootstrap 重采样次数，95% 置信区间每侧尾部约25次
+#define CMP_BOOTSTRAP 1000
+// 固定种子，保证同样的输入得到同样的置信区间
+#define CMP_SEED 0x9E3779B97F4A7C15ULL
+// 每个阶段最多保留的样本数，超过后用蓄水池抽样均匀保留，
+// 长时间运行的结果文件也只占用固定内存
+#define CMP_MAX_SAMPLES 65536
+
+struct cmp_phase {
+	char name[112];
+	// 保留的样本(最多 CMP_MAX_SAMPLES 个)
+	__u64 *v;
+	size_t n;
+	size_t cap;
+	// 文件中该阶段的样本总数
+	__u64 seen;
+	// 蓄水池抽样的随机数状态
+	__u64 state;
+};
+
+struct cmp_set {
+	struct cmp_phase *phases;
+	int nr;
+};
+
+static struct cmp_phase *cmp_find(struct cmp_set *set, const char *name,
+                                  bool create) {
+	struct cmp_phase *grown;
+
+	for (int i = 0; i < set->nr; i++) {
+		if (strcmp(set->phases[i].name, name) == 0)
+			return &set->phases[i];
+	}
+	if (!create)
+		return NULL;
+	grown = realloc(set->phases, (set->nr + 1) * sizeof(*grown));
+	if (!grown)
+		return NULL;
+	set->phases = grown;
+	memset(&set->phases[set->nr], 0, sizeof(*grown));
+	snprintf(set->phases[set->nr].name, sizeof(grown->name), "%s", name);
+	set->phases[set->nr].state = CMP_SEED;
+	return &set->phases[set->nr++];
+}
+
+static __u64 cmp_rand(__u64 *state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+// 逐个读入样本: 未满时追加，满了之后第 seen 个样本以 cap/seen 的概率
+// 替换一个已保留的样本(蓄水池抽样)
+static int cmp_append(struct cmp_phase *p, const __u64 *v, size_t n) {
+	size_t take;
+
+	if (p->n < CMP_MAX_SAMPLES) {
+		take = CMP_MAX_SAMPLES - p->n < n ? CMP_MAX_SAMPLES - p->n : n;
+		if (p->n + take > p->cap) {
+			size_t cap = p->cap ? p->cap : 1024;
+			__u64 *grown;
+
+			while (cap < p->n + take)
+				cap *= 2;
+			if (cap > CMP_MAX_SAMPLES)
+				cap = CMP_MAX_SAMPLES;
+			grown = realloc(p->v, cap * sizeof(*grown));
+			if (!grown)
+				return -ENOMEM;
+			p->v = grown;
+			p->cap = cap;
+		}
+		memcpy(p->v + p->n, v, take * sizeof(*v));
+		p->n += take;
+		p->seen += take;
+		v += take;
+		n -= take;
+	}
+	for (size_t i = 0; i < n; i++) {
+		__u64 j = cmp_rand(&p->state) % ++p->seen;
+
+		if (j < CMP_MAX_SAMPLES)
+			p->v[j] = v[i];
+	}
+	return 0;
+}
+
+// 按阶段名汇总一个结果文件中的全部样本
+static int cmp_load(const char *path, struct cmp_set *set) {
+	const struct bench_rec_phase *ph;
+	const struct bench_rec_samples *s;
+	const struct bench_rec_hdr *rec;
+	struct bench_rec_reader r;
+	// 文件内的阶段id -> set->phases 下标，数组扩容后指针会失效所以存下标
+	int *by_id = NULL, *grown, idx;
+	__u32 nr_ids = 0;
+	int err;
+
+	err = bench_rec_reader_open(&r, path);
+	if (err) {
+		fprintf(stderr, "Failed to read %s: %d\n", path, err);
+		return err;
+	}
+	while ((rec = bench_rec_next(&r))) {
+		switch (rec->type) {
+		case BENCH_REC_PHASE:
+			ph = (const void *)rec;
+			if (ph->id >= nr_ids) {
+				grown = realloc(by_id, (ph->id + 1) * sizeof(*grown));
+				if (!grown) {
+					err = -ENOMEM;
+					goto out;
+				}
+				for (__u32 i = nr_ids; i <= ph->id; i++)
+					grown[i] = -1;
+				by_id = grown;
+				nr_ids = ph->id + 1;
+			}
+			if (!cmp_find(set, ph->name, true)) {
+				err = -ENOMEM;
+				goto out;
+			}
+			by_id[ph->id] = cmp_find(set, ph->name, false) - set->phases;
+			break;
+		case BENCH_REC_SAMPLES:
+			s = (const void *)rec;
+			if (s->phase >= nr_ids || by_id[s->phase] < 0 ||
+			    sizeof(*s) + (size_t)s->nr * sizeof(__u64) > rec->size)
+				break;
+			idx = by_id[s->phase];
+			err = cmp_append(&set->phases[idx], s->values, s->nr);
+			if (err)
+				goto out;
+			break;
+		}
+	}
+out:
+	free(by_id);
+	bench_rec_reader_close(&r);
+	return err;
+}
+
+static void cmp_free(struct cmp_set *set) {
+	for (int i = 0; i < set->nr; i++)
+		free(set->phases[i].v);
+	free(set->phases);
+}
+
+static int cmp_u64(const void *a, const void *b) {
+	__u64 x = *(const __u64 *)a, y = *(const __u64 *)b;
+	return x < y ? -1 : x > y;
+}
+
+// 原地选出第k小的元素(quickselect)
+static __u64 cmp_select(__u64 *v, size_t n, size_t k) {
+	long lo = 0, hi = n - 1;
+
+	while (lo < hi) {
+		__u64 pivot = v[lo + (hi - lo) / 2], t;
+		long i = lo, j = hi;
+
+		while (i <= j) {
+			while (v[i] < pivot)
+				i++;
+			while (v[j] > pivot)
+				j--;
+			if (i <= j) {
+				t = v[i];
+				v[i++] = v[j];
+				v[j--] = t;
+			}
+		}
+		if ((long)k <= j)
+			hi = j;
+		else if ((long)k >= i)
+			lo = i;
+		else
+			break;
+	}
+	return v[k];
+}
+
+static double cmp_median_sorted(const __u64 *v, size_t n) {
+	return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0;
+}
+
+// 有放回地抽取 n 个样本并返回其中位数
+static double cmp_resample_median(const __u64 *v, size_t n, __u64 *tmp,
+                                  __u64 *state) {
+	for (size_t i = 0; i < n; i++)
+		tmp[i] = v[cmp_rand(state) % n];
+	return cmp_select(tmp, n, n / 2);
+}
+
+// 中位数相对变化(%)的 bootstrap 95% 置信区间
+static int cmp_bootstrap(const struct cmp_phase *a, const struct cmp_phase *b,
+                         double *lo, double *hi) {
+	double deltas[CMP_BOOTSTRAP], ma, mb;
+	__u64 state = CMP_SEED, *tmp;
+
+	tmp = malloc((a->n > b->n ? a->n : b->n) * sizeof(*tmp));
+	if (!tmp)
+		return -ENOMEM;
+	for (int i = 0; i < CMP_BOOTSTRAP; i++) {
+		ma = cmp_resample_median(a->v, a->n, tmp, &state);
+		mb = cmp_resample_median(b->v, b->n, tmp, &state);
+		deltas[i] = ma ? (mb - ma) / ma * 100 : 0;
+	}
+	free(tmp);
+	for (int i = 1; i < CMP_BOOTSTRAP; i++) {
+		double d = deltas[i];
+		int j = i - 1;
+
+		for (; j >= 0 && deltas[j] > d; j--)
+			deltas[j + 1] = deltas[j];
+		deltas[j + 1] = d;
+	}
+	*lo = deltas[(int)(CMP_BOOTSTRAP * 0.025)];
+	*hi = deltas[(int)(CMP_BOOTSTRAP * 0.975) - 1];
+	return 0;
+}
+
+// 双侧 Mann-Whitney U 检验(正态近似，含并列修正)，a、b 须已排序
+static double cmp_mann_whitney(const __u64 *a, size_t na, const __u64 *b,
+                               size_t nb) {
+	double rank_sum_a = 0, tie_sum = 0, n = na + nb, u, mu, sigma, z;
+	size_t i = 0, j = 0, pos = 0;
+
+	while (i < na || j < nb) {
+		__u64 v = i < na && (j >= nb || a[i] <= b[j]) ? a[i] : b[j];
+		size_t ca = 0, cb = 0, t;
+
+		while (i < na && a[i] == v) {
+			i++;
+			ca++;
+		}
+		while (j < nb && b[j] == v) {
+			j++;
+			cb++;
+		}
+		t = ca + cb;
+		// 并列值取平均秩
+		rank_sum_a += ca * (pos + (t + 1) / 2.0);
+		tie_sum += (double)t * t * t - t;
+		pos += t;
+	}
+	u = rank_sum_a - (double)na * (na + 1) / 2;
+	mu = (double)na * nb / 2;
+	sigma = sqrt((double)na * nb / 12 * ((n + 1) - tie_sum / (n * (n - 1))));
+	if (sigma == 0)
+		return 1;
+	z = (fabs(u - mu) - 0.5) / sigma;
+	return z > 0 ? erfc(z / sqrt(2)) : 1;
+}
+
+int bench_compare(const char *base_path, const char *cand_path,
+                  double threshold_pct, double alpha) {
+	struct cmp_set base = {0}, cand = {0};
+	int regressions = 0, compared = 0, missing = 0, err;
+
+	err = cmp_load(base_path, &base);
+	if (!err)
+		err = cmp_load(cand_path, &cand);
+	if (err)
+		goto out;
+
+	printf("%-44s %-8s %-8s %-10s %-10s %-8s %-18s %-9s %s\n", "PHASE",
+	       "N_BASE", "N_CAND", "BASE_P50", "CAND_P50", "DELTA%", "CI95%",
+	       "P_VALUE", "VERDICT");
+	for (int i = 0; i < base.nr; i++) {
+		struct cmp_phase *a = &base.phases[i];
+		struct cmp_phase *b = cmp_find(&cand, a->name, false);
+		double ma, mb, delta, lo, hi, p;
+		const char *verdict;
+		char ci[32];
+
+		// 候选结果缺少基线中的阶段(运行崩溃、跳过了基准测试或阶段改名)
+		if (!b) {
+			fprintf(stderr, "missing in candidate: %s\n", a->name);
+			missing++;
+			continue;
+		}
+		if (a->n < 2 || b->n < 2)
+			continue;
+		qsort(a->v, a->n, sizeof(*a->v), cmp_u64);
+		qsort(b->v, b->n, sizeof(*b->v), cmp_u64);
+		ma = cmp_median_sorted(a->v, a->n);
+		mb = cmp_median_sorted(b->v, b->n);
+		delta = ma ? (mb - ma) / ma * 100 : 0;
+		err = cmp_bootstrap(a, b, &lo, &hi);
+		if (err)
+			goto out;
+		p = cmp_mann_whitney(a->v, a->n, b->v, b->n);
+
+		// 延迟变大为回归；p 不显著或中位数变化的置信区间包含0时视为噪声，
+		// 判定方向也须与置信区间一致
+		if (p >= alpha || (lo <= 0 && hi >= 0))
+			verdict = "noise";
+		else if (delta > threshold_pct && lo > 0)
+			verdict = "REGRESSION";
+		else if (delta < -threshold_pct && hi < 0)
+			verdict = "improvement";
+		else
+			verdict = "ok";
+		if (strcmp(verdict, "REGRESSION") == 0)
+			regressions++;
+		compared++;
+		snprintf(ci, sizeof(ci), "[%+.1f,%+.1f]", lo, hi);
+		printf("%-44s %-8llu %-8llu %-10.0f %-10.0f %-+8.1f %-18s %-9.2g %s\n",
+		       a->name, (unsigned long long)a->seen,
+		       (unsigned long long)b->seen, ma, mb, delta, ci, p, verdict);
+	}
+	printf("\n%d phases compared, %d regressions (threshold %.1f%%, alpha "
+	       "%.3g, CI95 excluding 0, at most %d samples per phase)\n",
+	       compared, regressions, threshold_pct, alpha, CMP_MAX_SAMPLES);
+	if (missing)
+		fprintf(stderr, "error: %d baseline phases missing in candidate\n",
+		        missing);
+	if (!compared)
+		fprintf(stderr, "error: no phase with >= 2 samples in both runs\n");
+out:
+	cmp_free(&base);
+	cmp_free(&cand);
+	if (err)
+		return err;
+	if (missing || !compared)
+		return 2;
+	return regressions ? 1 : 0;
+}
@@ -0,0 +1,478 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Shared counter benchmark: bpf_spin_lock vs atomics vs per-CPU values.
+#include "bench_counter.h"
+#include "bench_features.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_timer.h"
+#include "bench_util.h"
+#include "counter.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 吞吐测量中每个线程执行程序的次数
+#define CNT_REPEAT 200000
+// 一致性测量中写线程每次 test_run 的次数，直到读线程完成
+#define CNT_CHUNK 10000
+// 一致性测量中用户态每种操作的次数
+#define CNT_USER_OPS 20000
+
+// value 中u64的个数，与 analyze_counter.h 中的 CNT_DEFINE 对应
+static const __u32 cnt_words[] = {1, 4, 16, 64};
+
+enum cnt_strategy {
+	CNT_LOCK,
+	CNT_ATOMIC,
+	CNT_PERCPU,
+	CNT_PLAIN,
+	CNT_NR_STRATEGIES,
+};
+
+static const struct cnt_strategy_desc {
+	// 程序名 cnt_<prog>_<n> 与 map 名 cnt_<map>_map_<n>
+	const char *name;
+	const char *prog;
+	const char *map;
+	// 并发更新与读取时提供的保证
+	const char *guarantee;
+} cnt_strategies[] = {
+    [CNT_LOCK] = {"spin_lock", "lock", "lock",
+                  "exact; whole value consistent when read with BPF_F_LOCK"},
+    [CNT_ATOMIC] = {"atomic", "atomic", "shared",
+                    "exact per word; no snapshot across words"},
+    [CNT_PERCPU] = {"percpu", "percpu", "percpu",
+                    "exact after summing CPUs; no snapshot across CPUs"},
+    [CNT_PLAIN] = {"plain", "plain", "shared",
+                   "none; concurrent increments are lost"},
+};
+
+// 用户态对共享 value 的操作，BPF_F_LOCK 只适用于带锁的 value
+enum cnt_user_op {
+	CNT_LOOKUP_LOCK,
+	CNT_LOOKUP,
+	CNT_UPDATE_LOCK,
+	CNT_UPDATE,
+	CNT_NR_USER_OPS,
+};
+
+static const char *const cnt_user_ops[] = {
+    [CNT_LOOKUP_LOCK] = "lookup_f_lock",
+    [CNT_LOOKUP] = "lookup",
+    [CNT_UPDATE_LOCK] = "update_f_lock",
+    [CNT_UPDATE] = "update",
+};
+
+// 一种方式与value大小下的程序和map
+struct cnt_target {
+	enum cnt_strategy strategy;
+	__u32 words;
+	int prog_fd;
+	int map_fd;
+	// 带锁的 value 中计数从第8字节开始
+	size_t offset;
+	size_t value_size;
+	// 每CPU map的 value 每个可能的CPU一份
+	int slots;
+};
+
+struct cnt_worker {
+	const struct cnt_target *t;
+	// 非NULL时为一致性测量中的读线程，执行 [first_op, last_op) 的操作
+	__u64 *samples;
+	__u64 torn[CNT_NR_USER_OPS];
+	int first_op;
+	int last_op;
+	void *buf;
+	volatile bool *stop;
+	__u64 ops;
+	__u64 kern_ns;
+	// 写线程自己记录起止时间，线程多于CPU时也能得到准确的墙钟耗时
+	__u64 start_ns;
+	__u64 end_ns;
+	int err;
+};
+
+static int cnt_possible_cpus;
+
+static const __u64 *cnt_words_at(const struct cnt_target *t, const void *buf,
+                                 int slot) {
+	return (const __u64 *)((const char *)buf + slot * t->value_size +
+	                       t->offset);
+}
+
+// value 中各个u64应当始终相等，否则读到了更新到一半的 value
+static bool cnt_torn(const struct cnt_target *t, const void *buf) {
+	const __u64 *w;
+
+	for (int s = 0; s < t->slots; s++) {
+		w = cnt_words_at(t, buf, s);
+		for (__u32 i = 1; i < t->words; i++) {
+			if (w[i] != w[0])
+				return true;
+		}
+	}
+	return false;
+}
+
+static void *cnt_writer(struct cnt_worker *w) {
+	__u64 ns;
+
+	w->start_ns = bench_now_ns();
+	do {
+		w->err = bench_prog_run(w->t->prog_fd,
+		                        w->stop ? CNT_CHUNK : CNT_REPEAT, &ns);
+		if (w->err)
+			break;
+		w->ops += w->stop ? CNT_CHUNK : CNT_REPEAT;
+		w->kern_ns += ns * (w->stop ? CNT_CHUNK : CNT_REPEAT);
+	} while (w->stop && !*w->stop);
+	w->end_ns = bench_now_ns();
+	return NULL;
+}
+
+// 读线程依次执行各种用户态操作，每次读取都检查 value 是否完整；
+// 更新写入各字相等的 value，之后用 BPF_F_LOCK 读取检查是否被写线程撕裂，
+// 撕裂后再用 BPF_F_LOCK 更新恢复
+static void *cnt_reader(struct cnt_worker *w) {
+	const struct cnt_target *t = w->t;
+	size_t size = t->value_size * t->slots;
+	__u64 start, *samples;
+	void *buf = w->buf;
+	__u32 zero = 0;
+	int op, err = 0;
+
+	for (op = w->first_op; op < w->last_op && !err; op++) {
+		samples = w->samples + op * CNT_USER_OPS;
+		for (int i = 0; i < CNT_USER_OPS && !err; i++) {
+			start = bench_timer_start();
+			switch (op) {
+			case CNT_LOOKUP_LOCK:
+				err = bpf_map_lookup_elem_flags(t->map_fd, &zero, buf,
+				                                BPF_F_LOCK);
+				break;
+			case CNT_LOOKUP:
+				err = bpf_map_lookup_elem(t->map_fd, &zero, buf);
+				break;
+			case CNT_UPDATE_LOCK:
+			case CNT_UPDATE:
+				memset(buf, 0, size);
+				err = bpf_map_update_elem(
+				    t->map_fd, &zero, buf,
+				    op == CNT_UPDATE_LOCK ? BPF_F_LOCK : BPF_ANY);
+				break;
+			}
+			samples[i] = bench_timer_ns(start, bench_timer_stop());
+			if (err)
+				break;
+			if (op >= CNT_UPDATE_LOCK)
+				err = bpf_map_lookup_elem_flags(t->map_fd, &zero, buf,
+				                                BPF_F_LOCK);
+			if (!err && cnt_torn(t, buf)) {
+				w->torn[op]++;
+				if (op >= CNT_UPDATE_LOCK) {
+					memset(buf, 0, size);
+					err = bpf_map_update_elem(t->map_fd, &zero, buf,
+					                          BPF_F_LOCK);
+				}
+			}
+		}
+	}
+	w->err = err;
+	*w->stop = true;
+	return NULL;
+}
+
+static void *cnt_worker_fn(void *arg) {
+	struct cnt_worker *w = arg;
+
+	return w->samples ? cnt_reader(w) : cnt_writer(w);
+}
+
+static int cnt_reset(const struct cnt_target *t) {
+	size_t size = t->value_size * t->slots;
+	__u32 zero = 0;
+	void *buf;
+	int err;
+
+	buf = calloc(1, size);
+	if (!buf)
+		return -ENOMEM;
+	err = bpf_map_update_elem(t->map_fd, &zero, buf, BPF_ANY);
+	free(buf);
+	return err;
+}
+
+// 读回第一个u64(每CPU map为各CPU之和)
+static int cnt_read_total(const struct cnt_target *t, __u64 *total,
+                          bool *torn) {
+	size_t size = t->value_size * t->slots;
+	__u32 zero = 0;
+	void *buf;
+	int err;
+
+	buf = malloc(size);
+	if (!buf)
+		return -ENOMEM;
+	err = bpf_map_lookup_elem_flags(t->map_fd, &zero, buf,
+	                                t->strategy == CNT_LOCK ? BPF_F_LOCK : 0);
+	*total = 0;
+	for (int s = 0; !err && s < t->slots; s++)
+		*total += cnt_words_at(t, buf, s)[0];
+	*torn = !err && cnt_torn(t, buf);
+	free(buf);
+	return err;
+}
+
+// 所有线程同时在各自CPU上执行更新程序，测量吞吐并检查丢失的更新
+static int cnt_measure(const struct cnt_target *t, int threads,
+                       __u64 nop_ns) {
+	const struct cnt_strategy_desc *d = &cnt_strategies[t->strategy];
+	struct cnt_worker *workers;
+	__u64 wall_ns, ops = 0, kern_ns = 0, total, start = -1ULL, end = 0;
+	double mops, op_ns;
+	long long lost;
+	bool torn;
+	int err;
+
+	workers = calloc(threads, sizeof(*workers));
+	if (!workers)
+		return -ENOMEM;
+	for (int i = 0; i < threads; i++)
+		workers[i].t = t;
+	err = cnt_reset(t);
+	if (!err)
+		err = bench_run_threads(threads, cnt_worker_fn, workers,
+		                        sizeof(workers[0]), &wall_ns);
+	for (int i = 0; !err && i < threads; i++) {
+		err = workers[i].err;
+		ops += workers[i].ops;
+		kern_ns += workers[i].kern_ns;
+		if (workers[i].start_ns < start)
+			start = workers[i].start_ns;
+		if (workers[i].end_ns > end)
+			end = workers[i].end_ns;
+	}
+	wall_ns = end > start ? end - start : 0;
+	free(workers);
+	if (!err)
+		err = cnt_read_total(t, &total, &torn);
+	if (err) {
+		fprintf(stderr, "%s %u words with %d threads failed: %d\n", d->name,
+		        t->words, threads, err);
+		return err;
+	}
+
+	// 单次耗时扣除 test_run 自身的开销
+	op_ns = ops ? (double)kern_ns / ops : 0;
+	op_ns = op_ns > nop_ns ? op_ns - nop_ns : 0;
+	mops = wall_ns ? ops * 1000.0 / wall_ns : 0;
+	lost = (long long)ops - (long long)total;
+	printf("%-9zu %-10s %-8d %-10.3f %-9.1f %-12lld %s\n", t->value_size,
+	       d->name, threads, mops, op_ns, lost, torn ? "torn" : "intact");
+	fflush(stdout);
+	BENCH_OUTPUT("counter", BF_STR("phase", "update"),
+	             BF_STR("strategy", d->name),
+	             BF_U64("value_size", t->value_size),
+	             BF_U64("words", t->words), BF_I64("threads", threads),
+	             BF_U64("ops", ops), BF_F64("mops", mops),
+	             BF_F64("avg_ns", op_ns), BF_I64("lost_updates", lost),
+	             BF_STR("final_value", torn ? "torn" : "intact"),
+	             BF_STR("guarantee", d->guarantee));
+	return 0;
+}
+
+// 写线程在其余CPU上持续更新的同时，读线程执行用户态查找与更新，
+// 统计读到不完整 value 的次数
+static int cnt_measure_user(const struct cnt_target *t, int writers) {
+	const struct cnt_strategy_desc *d = &cnt_strategies[t->strategy];
+	struct cnt_worker *workers, *reader;
+	volatile bool stop = false;
+	struct bench_lat lat;
+	char phase[96];
+	__u64 wall_ns;
+	int err, op;
+
+	workers = calloc(writers + 1, sizeof(*workers));
+	if (!workers)
+		return -ENOMEM;
+	reader = &workers[writers];
+	// 不带锁的 value 不支持 BPF_F_LOCK，其余方式只做普通查找；
+	// 普通更新会清零计数，只对带锁的 value 测量
+	reader->first_op = CNT_LOOKUP;
+	reader->last_op = CNT_LOOKUP + 1;
+	if (t->strategy == CNT_LOCK) {
+		reader->first_op = CNT_LOOKUP_LOCK;
+		reader->last_op = CNT_NR_USER_OPS;
+	}
+	reader->samples = calloc((size_t)CNT_NR_USER_OPS * CNT_USER_OPS,
+	                         sizeof(__u64));
+	reader->buf = malloc(t->value_size * t->slots);
+	if (!reader->samples || !reader->buf) {
+		err = -ENOMEM;
+		goto out;
+	}
+	for (int i = 0; i <= writers; i++) {
+		workers[i].t = t;
+		workers[i].stop = &stop;
+	}
+	err = cnt_reset(t);
+	if (!err)
+		err = bench_run_threads(writers + 1, cnt_worker_fn, workers,
+		                        sizeof(workers[0]), &wall_ns);
+	for (int i = 0; !err && i <= writers; i++)
+		err = workers[i].err;
+	if (err) {
+		fprintf(stderr, "%s %u words user access failed: %d\n", d->name,
+		        t->words, err);
+		goto out;
+	}
+	for (op = reader->first_op; op < reader->last_op; op++) {
+		snprintf(phase, sizeof(phase), "counter/%s/%zu/%s", d->name,
+		         t->value_size, cnt_user_ops[op]);
+		bench_lat_summarize(phase, reader->samples + op * CNT_USER_OPS,
+		                    CNT_USER_OPS, &lat);
+		printf("%-9zu %-10s %-8d %-14s %-9.0f %-9.0f %-9.0f %llu/%d\n",
+		       t->value_size, d->name, writers, cnt_user_ops[op], lat.avg,
+		       lat.p50, lat.p99, (unsigned long long)reader->torn[op],
+		       CNT_USER_OPS);
+		BENCH_OUTPUT("counter", BF_STR("phase", "user"),
+		             BF_STR("strategy", d->name),
+		             BF_U64("value_size", t->value_size),
+		             BF_U64("words", t->words), BF_I64("threads", writers),
+		             BF_STR("op", cnt_user_ops[op]),
+		             BF_U64("ops", CNT_USER_OPS),
+		             BF_F64("avg_ns", lat.avg), BF_F64("p50_ns", lat.p50),
+		             BF_F64("p99_ns", lat.p99),
+		             BF_U64("torn_reads", reader->torn[op]),
+		             BF_STR("guarantee", d->guarantee));
+	}
+	fflush(stdout);
+out:
+	free(reader->samples);
+	free(reader->buf);
+	free(workers);
+	return err;
+}
+
+static int cnt_target_init(struct counter_bpf *skel, enum cnt_strategy s,
+                           __u32 words, struct cnt_target *t) {
+	const struct cnt_strategy_desc *d = &cnt_strategies[s];
+	struct bpf_program *prog;
+	struct bpf_map *map;
+	char name[32];
+
+	snprintf(name, sizeof(name), "cnt_%s_%u", d->prog, words);
+	prog = bpf_object__find_program_by_name(skel->obj, name);
+	snprintf(name, sizeof(name), "cnt_%s_map_%u", d->map, words);
+	map = bpf_object__find_map_by_name(skel->obj, name);
+	if (!prog || !map) {
+		fprintf(stderr, "Failed to find %s\n", name);
+		return -ENOENT;
+	}
+	t->strategy = s;
+	t->words = words;
+	t->prog_fd = bpf_program__fd(prog);
+	t->map_fd = bpf_map__fd(map);
+	t->offset = s == CNT_LOCK ? sizeof(__u64) : 0;
+	t->value_size = bpf_map__value_size(map);
+	t->slots = s == CNT_PERCPU ? cnt_possible_cpus : 1;
+	return 0;
+}
+
+int bench_counter(volatile bool *exiting) {
+	int online = sysconf(_SC_NPROCESSORS_ONLN);
+	int thread_counts[] = {1, online};
+	struct counter_bpf *skel;
+	struct cnt_target t;
+	__u64 nop_ns;
+	int err;
+
+	cnt_possible_cpus = libbpf_num_possible_cpus();
+	if (cnt_possible_cpus < 0) {
+		fprintf(stderr, "Failed to get possible CPUs: %d\n",
+		        cnt_possible_cpus);
+		return cnt_possible_cpus;
+	}
+	skel = BENCH_SKEL_OPEN(counter);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return -errno;
+	}
+	bench_skip_unsupported(skel->obj);
+	err = BENCH_SKEL_LOAD(counter, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load counter programs: %d\n", err);
+		goto out;
+	}
+	err = bench_prog_run(bpf_program__fd(skel->progs.bench_nop), CNT_REPEAT,
+	                     &nop_ns);
+	if (err)
+		goto out;
+
+	for (int s = 0; s < CNT_NR_STRATEGIES; s++)
+		printf("%-10s %s\n", cnt_strategies[s].name,
+		       cnt_strategies[s].guarantee);
+	printf("\n%-9s %-10s %-8s %-10s %-9s %-12s %s\n", "VALUE(B)", "STRATEGY",
+	       "THREADS", "MOPS/S", "NS/OP", "LOST", "FINAL");
+	for (int w = 0; !err && !*exiting && w < BENCH_ARRAY_SIZE(cnt_words); w++) {
+		for (int s = 0; !err && !*exiting && s < CNT_NR_STRATEGIES; s++) {
+			err = cnt_target_init(skel, s, cnt_words[w], &t);
+			for (int i = 0; !err && i < BENCH_ARRAY_SIZE(thread_counts); i++) {
+				if (i && thread_counts[i] == thread_counts[i - 1])
+					continue;
+				err = cnt_measure(&t, thread_counts[i], nop_ns);
+			}
+		}
+	}
+
+	// 读线程占用一个CPU，其余CPU上运行写线程
+	printf("\n%-9s %-10s %-8s %-14s %-9s %-9s %-9s %s\n", "VALUE(B)",
+	       "STRATEGY", "WRITERS", "USER OP", "AVG(ns)", "P50(ns)", "P99(ns)",
+	       "TORN");
+	for (int w = 0; !err && !*exiting && w < BENCH_ARRAY_SIZE(cnt_words); w++) {
+		for (int s = 0; !err && !*exiting && s < CNT_NR_STRATEGIES; s++) {
+			err = cnt_target_init(skel, s, cnt_words[w], &t);
+			if (!err)
+				err = cnt_measure_user(&t, online > 1 ? online - 1 : 1);
+		}
+	}
+out:
+	counter_bpf__destroy(skel);
+	return err;
+}
+
+static const struct bench_feature counter_feats[] = {
+    BENCH_PROG(SCHED_CLS),
+    BENCH_MAP(ARRAY),
+    BENCH_MAP(PERCPU_ARRAY),
+    BENCH_HELPER(SCHED_CLS, spin_lock),
+};
+
+BENCH_REGISTER(counter) = {
+    .name = "counter",
+    .key = 'U',
+    .doc = "Compare bpf_spin_lock, atomic and per-CPU shared counters on all "
+           "CPUs, plus BPF_F_LOCK user access",
+    .feats = counter_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(counter_feats),
+    .schema = "phase,strategy,value_size,words,threads,op,ops,mops,avg_ns,"
+              "p50_ns,p99_ns,lost_updates,final_value,torn_reads,guarantee",
+    .run = bench_counter,
+};
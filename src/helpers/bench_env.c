@@ -0,0 +1,312 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Measurement environment control and noise checks.
+#define _GNU_SOURCE
+#include "bench_env.h"
+#include "bench_load.h"
+#include "bench_output.h"
+#include <errno.h>
+#include <malloc.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// 预先触碰的栈与堆大小
+#define ENV_STACK_PREFAULT (512 * 1024)
+#define ENV_HEAP_PREFAULT (64 * 1024 * 1024)
+// 采样SMT兄弟线程忙碌程度的时长，以及判定为繁忙的阈值
+#define ENV_SMT_SAMPLE_US 200000
+#define ENV_SMT_BUSY_PCT 5.0
+// 退出延迟超过该值(us)的 C-state 视为深度 C-state
+#define ENV_DEEP_CSTATE_US 10
+
+static int measure_cpu;
+static bool mlocked;
+// 绑核前的CPU亲和性
+static cpu_set_t allowed;
+static bool allowed_saved;
+
+void bench_env_set_cpu(int cpu) { measure_cpu = cpu; }
+int bench_env_cpu(void) { return measure_cpu; }
+
+static void env_save_allowed(void) {
+	if (allowed_saved)
+		return;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed))
+		CPU_SET(measure_cpu, &allowed);
+	allowed_saved = true;
+}
+
+bool bench_env_cpu_allowed(int cpu) {
+	env_save_allowed();
+	return cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed);
+}
+
+/* ---------------- 低噪声测量模式 ---------------- */
+
+static void env_prefault_stack(void) {
+	volatile char stack[ENV_STACK_PREFAULT];
+
+	for (size_t i = 0; i < sizeof(stack); i += 4096)
+		stack[i] = 0;
+}
+
+// 禁止 malloc 归还内存或改用 mmap，之后的分配都落在已触碰过的堆上
+static void env_prefault_heap(void) {
+	char *p;
+
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+	p = malloc(ENV_HEAP_PREFAULT);
+	if (!p)
+		return;
+	for (size_t i = 0; i < ENV_HEAP_PREFAULT; i += 4096)
+		p[i] = 0;
+	free(p);
+}
+
+int bench_env_control(int fifo_prio) {
+	cpu_set_t set;
+	int err;
+
+	env_save_allowed();
+	CPU_ZERO(&set);
+	CPU_SET(measure_cpu, &set);
+	if (sched_setaffinity(0, sizeof(set), &set)) {
+		err = -errno;
+		fprintf(stderr, "Failed to pin to CPU %d: %d\n", measure_cpu, err);
+		return err;
+	}
+	if (fifo_prio > 0) {
+		struct sched_param param = {.sched_priority = fifo_prio};
+
+		if (sched_setscheduler(0, SCHED_FIFO, &param)) {
+			err = -errno;
+			fprintf(stderr, "Failed to set SCHED_FIFO %d: %d\n", fifo_prio,
+			        err);
+			return err;
+		}
+	}
+	// 锁定失败(如 RLIMIT_MEMLOCK 过小)不影响测量本身，只提示
+	if (mlockall(MCL_CURRENT | MCL_FUTURE))
+		fprintf(stderr, "Warning: mlockall failed: %d\n", -errno);
+	else
+		mlocked = true;
+	env_prefault_stack();
+	env_prefault_heap();
+	return 0;
+}
+
+/* ---------------- 噪声来源检查 ---------------- */
+
+static bool env_read(const char *path, char *buf, size_t size) {
+	FILE *f = fopen(path, "r");
+	bool ok;
+
+	buf[0] = '\0';
+	if (!f)
+		return false;
+	ok = fgets(buf, size, f) != NULL;
+	buf[strcspn(buf, "\n")] = '\0';
+	fclose(f);
+	return ok;
+}
+
+// 解析 0-3,8,10-11 形式的CPU列表
+static bool env_cpu_in_list(const char *list, int cpu) {
+	const char *p = list;
+	char *end;
+	long lo, hi;
+
+	while (*p) {
+		lo = strtol(p, &end, 10);
+		if (end == p)
+			return false;
+		hi = lo;
+		if (*end == '-')
+			hi = strtol(end + 1, &end, 10);
+		if (cpu >= lo && cpu <= hi)
+			return true;
+		if (*end != ',')
+			break;
+		p = end + 1;
+	}
+	return false;
+}
+
+// 返回已启用的最深 C-state 名称与退出延迟，没有 cpuidle 时为 "-"
+static int env_deepest_cstate(char *name, size_t size) {
+	char path[128], buf[64];
+	int latency = -1;
+
+	snprintf(name, size, "-");
+	for (int i = 0;; i++) {
+		snprintf(path, sizeof(path),
+		         "/sys/devices/system/cpu/cpu%d/cpuidle/state%d/disable",
+		         measure_cpu, i);
+		if (!env_read(path, buf, sizeof(buf)))
+			break;
+		if (atoi(buf))
+			continue;
+		snprintf(path, sizeof(path),
+		         "/sys/devices/system/cpu/cpu%d/cpuidle/state%d/latency",
+		         measure_cpu, i);
+		if (!env_read(path, buf, sizeof(buf)) || atoi(buf) < latency)
+			continue;
+		latency = atoi(buf);
+		snprintf(path, sizeof(path),
+		         "/sys/devices/system/cpu/cpu%d/cpuidle/state%d/name",
+		         measure_cpu, i);
+		env_read(path, name, size);
+	}
+	return latency;
+}
+
+static void env_cpu_times(int cpu, unsigned long long *busy,
+                          unsigned long long *total) {
+	unsigned long long v[8];
+	char line[512];
+	FILE *f;
+	int n;
+
+	*busy = *total = 0;
+	f = fopen("/proc/stat", "r");
+	if (!f)
+		return;
+	while (fgets(line, sizeof(line), f)) {
+		if (sscanf(line, "cpu%d %llu %llu %llu %llu %llu %llu %llu %llu", &n,
+		           &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6],
+		           &v[7]) != 9 ||
+		    n != cpu)
+			continue;
+		*total = v[0] + v[1] + v[2] + v[3] + v[4] + v[5] + v[6] + v[7];
+		*busy = *total - v[3] - v[4];
+		break;
+	}
+	fclose(f);
+}
+
+// 测量CPU的SMT兄弟线程中最繁忙者在采样期间的忙碌比例，没有兄弟线程时为-1
+static double env_smt_busy_pct(char *siblings, size_t size) {
+	int nr_conf = sysconf(_SC_NPROCESSORS_CONF), cpus[64], nr = 0;
+	unsigned long long b0[64], t0[64], b1, t1;
+	double max = -1;
+	char path[128];
+
+	snprintf(path, sizeof(path),
+	         "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list",
+	         measure_cpu);
+	if (!env_read(path, siblings, size))
+		snprintf(siblings, size, "%d", measure_cpu);
+	for (int cpu = 0; cpu < nr_conf && nr < 64; cpu++) {
+		if (cpu != measure_cpu && env_cpu_in_list(siblings, cpu))
+			cpus[nr++] = cpu;
+	}
+	if (!nr)
+		return -1;
+	for (int i = 0; i < nr; i++)
+		env_cpu_times(cpus[i], &b0[i], &t0[i]);
+	usleep(ENV_SMT_SAMPLE_US);
+	for (int i = 0; i < nr; i++) {
+		env_cpu_times(cpus[i], &b1, &t1);
+		if (t1 > t0[i] && 100.0 * (b1 - b0[i]) / (t1 - t0[i]) > max)
+			max = 100.0 * (b1 - b0[i]) / (t1 - t0[i]);
+	}
+	return max < 0 ? 0 : max;
+}
+
+// 打印一条警告，并把标签追加到以逗号分隔的警告列表
+static void env_warn(char *tags, size_t size, const char *tag,
+                     const char *fmt, ...) {
+	size_t len = strlen(tags);
+	va_list ap;
+
+	fprintf(stderr, "Warning: ");
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fprintf(stderr, "\n");
+	snprintf(tags + len, size - len, "%s%s", len ? "," : "", tag);
+}
+
+void bench_env_check(void) {
+	char path[128], governor[32], cstate[32], siblings[64], isolated[256];
+	char nohz[256], sched[16], warnings[256] = "";
+	struct sched_param param;
+	int cstate_latency, policy;
+	bool pinned, is_isolated, is_nohz;
+	double smt_busy;
+	cpu_set_t set;
+
+	// 检查在启动背景负载之前进行，-L 启动负载时才把测量线程绑定到测量CPU
+	CPU_ZERO(&set);
+	pinned = bench_load_enabled() ||
+	         (!sched_getaffinity(0, sizeof(set), &set) &&
+	          CPU_COUNT(&set) == 1 && CPU_ISSET(measure_cpu, &set));
+	policy = sched_getscheduler(0);
+	sched_getparam(0, &param);
+	if (policy == SCHED_FIFO)
+		snprintf(sched, sizeof(sched), "fifo:%d", param.sched_priority);
+	else
+		snprintf(sched, sizeof(sched), "other");
+
+	snprintf(path, sizeof(path),
+	         "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor",
+	         measure_cpu);
+	if (!env_read(path, governor, sizeof(governor)))
+		snprintf(governor, sizeof(governor), "unknown");
+	cstate_latency = env_deepest_cstate(cstate, sizeof(cstate));
+	smt_busy = env_smt_busy_pct(siblings, sizeof(siblings));
+	env_read("/sys/devices/system/cpu/isolated", isolated, sizeof(isolated));
+	env_read("/sys/devices/system/cpu/nohz_full", nohz, sizeof(nohz));
+	is_isolated = env_cpu_in_list(isolated, measure_cpu);
+	is_nohz = env_cpu_in_list(nohz, measure_cpu);
+
+	if (!pinned)
+		env_warn(warnings, sizeof(warnings), "unpinned",
+		         "benchmark thread is not pinned to CPU %d (use -n)",
+		         measure_cpu);
+	if (strcmp(governor, "performance") && strcmp(governor, "unknown"))
+		env_warn(warnings, sizeof(warnings), "governor",
+		         "CPU %d governor is %s, not performance", measure_cpu,
+		         governor);
+	if (cstate_latency > ENV_DEEP_CSTATE_US)
+		env_warn(warnings, sizeof(warnings), "cstate",
+		         "deep C-state %s (%d us exit latency) enabled on CPU %d",
+		         cstate, cstate_latency, measure_cpu);
+	if (smt_busy > ENV_SMT_BUSY_PCT)
+		env_warn(warnings, sizeof(warnings), "smt_busy",
+		         "SMT siblings of CPU %d (%s) are %.0f%% busy", measure_cpu,
+		         siblings, smt_busy);
+	if (!is_isolated)
+		env_warn(warnings, sizeof(warnings), "not_isolated",
+		         "CPU %d is not isolated (isolcpus=)", measure_cpu);
+
+	BENCH_OUTPUT("env", BF_I64("measure_cpu", measure_cpu),
+	             BF_STR("pinned", pinned ? "yes" : "no"),
+	             BF_STR("sched", sched),
+	             BF_STR("mlocked", mlocked ? "yes" : "no"),
+	             BF_STR("governor", governor),
+	             BF_STR("deepest_cstate", cstate),
+	             BF_I64("deepest_cstate_latency_us", cstate_latency),
+	             BF_STR("smt_siblings", siblings),
+	             BF_F64("smt_busy_pct", smt_busy < 0 ? NAN : smt_busy),
+	             BF_STR("isolated", is_isolated ? "yes" : "no"),
+	             BF_STR("nohz_full", is_nohz ? "yes" : "no"),
+	             BF_STR("warnings", warnings));
+}
@@ -0,0 +1,191 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Process startup benchmark: libbpf skeleton vs light skeleton.
+#include "bench_exec_startup.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_util.h"
+#include <errno.h>
+#include <libgen.h>
+#include <limits.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// 每个变体计时启动的次数，两个变体交替启动，另各有一次预热
+#define ES_RUNS 20
+
+extern char **environ;
+
+// 同一BPF对象的两种骨架，探针程序见 src/startup_probe.c
+static const struct es_variant {
+	const char *name;
+	const char *binary;
+} es_variants[] = {
+    {"skeleton", "startup_probe"},
+    {"light", "startup_probe_lskel"},
+};
+#define ES_NR_VARIANTS BENCH_ARRAY_SIZE(es_variants)
+
+struct es_result {
+	char path[PATH_MAX];
+	// exec 到进入 main、到附加完成的耗时
+	__u64 main_ns[ES_RUNS];
+	__u64 attach_ns[ES_RUNS];
+	int nr;
+	// 最后一次启动时探针报告的内存与共享库
+	long rss_kb;
+	long hwm_kb;
+	int nr_libs;
+	long long lib_bytes;
+	int err;
+};
+
+// 启动一次探针并读取它输出的一行结果
+static int es_run_once(struct es_result *r, bool record) {
+	unsigned long long main_ns, attach_ns;
+	char *argv[] = {r->path, NULL};
+	posix_spawn_file_actions_t fa;
+	int pipefd[2], status, err;
+	size_t total = 0;
+	char buf[256];
+	__u64 start;
+	ssize_t len;
+	pid_t pid;
+
+	if (pipe(pipefd))
+		return -errno;
+	posix_spawn_file_actions_init(&fa);
+	posix_spawn_file_actions_adddup2(&fa, pipefd[1], STDOUT_FILENO);
+	posix_spawn_file_actions_addclose(&fa, pipefd[0]);
+	posix_spawn_file_actions_addclose(&fa, pipefd[1]);
+	start = bench_now_ns();
+	err = posix_spawn(&pid, r->path, &fa, NULL, argv, environ);
+	posix_spawn_file_actions_destroy(&fa);
+	close(pipefd[1]);
+	if (err) {
+		close(pipefd[0]);
+		return -err;
+	}
+	while ((len = read(pipefd[0], buf + total, sizeof(buf) - 1 - total)) > 0)
+		total += len;
+	buf[total] = '\0';
+	close(pipefd[0]);
+	if (waitpid(pid, &status, 0) < 0)
+		return -errno;
+	if (!WIFEXITED(status) || WEXITSTATUS(status))
+		return -ECHILD;
+	if (sscanf(buf, "%llu %llu %ld %ld %d %lld", &main_ns, &attach_ns,
+	           &r->rss_kb, &r->hwm_kb, &r->nr_libs, &r->lib_bytes) != 6)
+		return -EINVAL;
+	if (record) {
+		r->main_ns[r->nr] = main_ns - start;
+		r->attach_ns[r->nr++] = attach_ns - start;
+	}
+	return 0;
+}
+
+static void es_print(const struct es_variant *v, struct es_result *r) {
+	struct bench_lat main_lat, attach_lat;
+	char phase[64];
+	struct stat st;
+	long long size;
+
+	size = stat(r->path, &st) ? -1 : st.st_size;
+	if (r->err) {
+		printf("%-9s failed: %s\n", v->name,
+		       r->err == -ENOENT   ? "not built (make startup_probe)"
+		       : r->err == -ECHILD ? "probe exited with an error"
+		                           : strerror(-r->err));
+		BENCH_OUTPUT("exec_startup", BF_STR("variant", v->name),
+		             BF_STR("status", "failed"), BF_I64("binary_bytes", size));
+		return;
+	}
+	snprintf(phase, sizeof(phase), "exec_startup/%s/main", v->name);
+	bench_lat_summarize(phase, r->main_ns, r->nr, &main_lat);
+	snprintf(phase, sizeof(phase), "exec_startup/%s/attach", v->name);
+	bench_lat_summarize(phase, r->attach_ns, r->nr, &attach_lat);
+	printf("%-9s %-11lld %-5d %-9lld %-9.1f %-11.1f %-11.1f %-8ld %-8ld\n",
+	       v->name, size / 1024, r->nr_libs, r->lib_bytes / 1024,
+	       main_lat.p50 / 1e3, attach_lat.p50 / 1e3, attach_lat.p99 / 1e3,
+	       r->rss_kb, r->hwm_kb);
+	fflush(stdout);
+	BENCH_OUTPUT("exec_startup", BF_STR("variant", v->name),
+	             BF_STR("status", "ok"), BF_I64("binary_bytes", size),
+	             BF_U64("libs", r->nr_libs), BF_I64("lib_bytes", r->lib_bytes),
+	             BF_U64("runs", r->nr), BF_F64("main_us", main_lat.p50 / 1e3),
+	             BF_F64("attach_us", attach_lat.p50 / 1e3),
+	             BF_F64("attach_p99_us", attach_lat.p99 / 1e3),
+	             BF_I64("rss_kb", r->rss_kb), BF_I64("hwm_kb", r->hwm_kb));
+}
+
+int bench_exec_startup(volatile bool *exiting) {
+	struct es_result *res;
+	char self[PATH_MAX], *dir;
+	ssize_t len;
+
+	// 探针与本程序由同一个 Makefile 生成在同一目录
+	len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+	if (len < 0) {
+		fprintf(stderr, "Failed to resolve /proc/self/exe: %d\n", -errno);
+		return -errno;
+	}
+	self[len] = '\0';
+	dir = dirname(self);
+	res = calloc(ES_NR_VARIANTS, sizeof(*res));
+	if (!res)
+		return -ENOMEM;
+	for (int v = 0; v < ES_NR_VARIANTS; v++) {
+		snprintf(res[v].path, sizeof(res[v].path), "%s/%s", dir,
+		         es_variants[v].binary);
+		if (access(res[v].path, X_OK))
+			res[v].err = -ENOENT;
+		else
+			res[v].err = es_run_once(&res[v], false);
+	}
+	for (int i = 0; i < ES_RUNS && !*exiting; i++) {
+		for (int v = 0; v < ES_NR_VARIANTS; v++) {
+			if (!res[v].err)
+				res[v].err = es_run_once(&res[v], true);
+		}
+	}
+
+	printf("%-9s %-11s %-5s %-9s %-9s %-11s %-11s %-8s %-8s\n", "VARIANT",
+	       "BINARY(KB)", "LIBS", "LIBS(KB)", "MAIN(us)", "ATTACH(us)",
+	       "P99(us)", "RSS(KB)", "HWM(KB)");
+	for (int v = 0; v < ES_NR_VARIANTS; v++)
+		es_print(&es_variants[v], &res[v]);
+	free(res);
+	return 0;
+}
+
+static const struct bench_feature exec_startup_feats[] = {
+    BENCH_PROG(TRACEPOINT),
+    BENCH_MAP(RINGBUF),
+};
+
+BENCH_REGISTER(exec_startup) = {
+    .name = "exec_startup",
+    .key = 'S',
+    .doc = "Compare exec-to-attach time, size and RSS of the libbpf skeleton "
+           "and the light skeleton",
+    .feats = exec_startup_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(exec_startup_feats),
+    .schema = "variant,status,binary_bytes,libs,lib_bytes,runs,main_us,"
+              "attach_us,attach_p99_us,rss_kb,hwm_kb",
+    .run = bench_exec_startup,
+};
@@ -0,0 +1,91 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Kernel feature probing for the benchmark matrix.
+#include "bench_features.h"
+#include <sys/resource.h>
+
+#define PROBE_MAX_TYPES 64
+#define PROBE_MAX_HELPERS 256
+
+// 0: 未探测, 1: 支持, -1: 不支持
+static signed char map_cache[PROBE_MAX_TYPES];
+static signed char prog_cache[PROBE_MAX_TYPES];
+static signed char helper_cache[PROBE_MAX_TYPES][PROBE_MAX_HELPERS];
+
+// 5.11 之前的内核按 RLIMIT_MEMLOCK 计费，探测前先放开限制，
+// 否则探测用的map会因 EPERM 被误判为不支持
+static void probe_prepare(void) {
+	static bool done;
+	struct rlimit rlim = {RLIM_INFINITY, RLIM_INFINITY};
+
+	if (done)
+		return;
+	done = true;
+	setrlimit(RLIMIT_MEMLOCK, &rlim);
+}
+
+bool bench_map_type_supported(int type) {
+	if (type < 0 || type >= PROBE_MAX_TYPES)
+		return false;
+	probe_prepare();
+	// libbpf 不认识的类型也返回错误，按不支持处理
+	if (!map_cache[type])
+		map_cache[type] =
+		    libbpf_probe_bpf_map_type(type, NULL) == 1 ? 1 : -1;
+	return map_cache[type] > 0;
+}
+
+bool bench_prog_type_supported(int type) {
+	if (type < 0 || type >= PROBE_MAX_TYPES)
+		return false;
+	probe_prepare();
+	if (!prog_cache[type])
+		prog_cache[type] =
+		    libbpf_probe_bpf_prog_type(type, NULL) == 1 ? 1 : -1;
+	return prog_cache[type] > 0;
+}
+
+static bool helper_supported(int prog_type, int helper) {
+	signed char *c;
+
+	if (prog_type < 0 || prog_type >= PROBE_MAX_TYPES || helper < 0 ||
+	    helper >= PROBE_MAX_HELPERS)
+		return false;
+	if (!bench_prog_type_supported(prog_type))
+		return false;
+	c = &helper_cache[prog_type][helper];
+	if (!*c)
+		*c = libbpf_probe_bpf_helper(prog_type, helper, NULL) == 1 ? 1 : -1;
+	return *c > 0;
+}
+
+bool bench_feature_supported(const struct bench_feature *f) {
+	switch (f->kind) {
+	case BENCH_FEAT_MAP:
+		return bench_map_type_supported(f->type);
+	case BENCH_FEAT_PROG:
+		return bench_prog_type_supported(f->type);
+	case BENCH_FEAT_HELPER:
+		return helper_supported(f->type, f->helper);
+	}
+	return false;
+}
+
+const struct bench_feature *
+bench_features_missing(const struct bench_feature *feats, int nr) {
+	for (int i = 0; i < nr; i++) {
+		if (!bench_feature_supported(&feats[i]))
+			return &feats[i];
+	}
+	return NULL;
+}
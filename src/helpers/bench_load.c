@@ -0,0 +1,590 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Built-in background load generators.
+#define _GNU_SOURCE
+#include "bench_load.h"
+#include "bench_env.h"
+#include "bench_output.h"
+#include "bench_util.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// CPU 空转线程的占空比周期
+#define LOAD_CPU_PERIOD_NS 10000000ULL
+// 内存负载写满后每轮重新触碰全部页面的间隔
+#define LOAD_MEM_RETOUCH_US 100000
+#define LOAD_CACHE_LINE 64
+#define LOAD_CACHE_DEFAULT (64ULL << 20)
+
+enum load_kind { LOAD_CPU, LOAD_MEM, LOAD_SYSCALL, LOAD_CACHE };
+
+struct load_thread {
+	pthread_t tid;
+	int kind;
+	int cpu;
+	// cache 负载的缓冲区，启动线程前分配，分配失败时启动失败
+	volatile char *buf;
+	// 线程退出时填写: 线程CPU时间、墙钟时间，以及系统调用次数或写入字节数
+	__u64 cpu_ns;
+	__u64 wall_ns;
+	__u64 count;
+};
+
+static struct {
+	char spec[128];
+	int cpu_pct;
+	int cpu_threads;
+	__u64 mem_bytes;
+	int mem_pct;
+	int syscall_threads;
+	int cache_threads;
+	__u64 cache_bytes;
+
+	struct load_thread *threads;
+	int nr_threads;
+	volatile bool stop;
+	volatile bool mem_ready;
+	char *mem;
+	size_t mem_len;
+	// 各CPU在 /proc/stat 中的忙碌与总时间(jiffies)，启动时采样
+	unsigned long long *stat_busy;
+	unsigned long long *stat_total;
+	int nr_stat;
+	bool *load_cpu;
+} load;
+
+/* ---------------- 参数解析 ---------------- */
+
+static int load_parse_size(const char *s, __u64 *out) {
+	unsigned long long v;
+	char *end;
+
+	v = strtoull(s, &end, 0);
+	if (end == s || *s == '-')
+		return -EINVAL;
+	switch (*end) {
+	case 'g':
+	case 'G':
+		v <<= 10;
+		/* fall through */
+	case 'm':
+	case 'M':
+		v <<= 10;
+		/* fall through */
+	case 'k':
+	case 'K':
+		v <<= 10;
+		end++;
+		break;
+	}
+	if (*end || !v)
+		return -EINVAL;
+	*out = v;
+	return 0;
+}
+
+static int load_parse_int(const char *s, int min, int max, int *out) {
+	char *end;
+	long v;
+
+	v = strtol(s, &end, 10);
+	if (end == s || v < min || v > max)
+		return -EINVAL;
+	*out = v;
+	return *end ? -EINVAL : 0;
+}
+
+int bench_load_parse(const char *spec) {
+	char buf[128], *item, *save, *val, *extra;
+	int err = 0;
+
+	snprintf(load.spec, sizeof(load.spec), "%s", spec);
+	snprintf(buf, sizeof(buf), "%s", spec);
+	for (item = strtok_r(buf, ",", &save); item && !err;
+	     item = strtok_r(NULL, ",", &save)) {
+		val = strchr(item, '=');
+		if (!val)
+			return -EINVAL;
+		*val++ = '\0';
+		extra = strchr(val, ':');
+		if (extra)
+			*extra++ = '\0';
+		if (strcmp(item, "cpu") == 0) {
+			err = load_parse_int(val, 1, 100, &load.cpu_pct);
+			if (!err && extra)
+				err = load_parse_int(extra, 1, 4096, &load.cpu_threads);
+		} else if (strcmp(item, "mem") == 0 && !extra) {
+			size_t len = strlen(val);
+
+			if (len && val[len - 1] == '%') {
+				val[len - 1] = '\0';
+				err = load_parse_int(val, 1, 99, &load.mem_pct);
+			} else {
+				err = load_parse_size(val, &load.mem_bytes);
+			}
+		} else if (strcmp(item, "syscall") == 0 && !extra) {
+			err = load_parse_int(val, 1, 4096, &load.syscall_threads);
+		} else if (strcmp(item, "cache") == 0) {
+			err = load_parse_int(val, 1, 4096, &load.cache_threads);
+			if (!err && extra)
+				err = load_parse_size(extra, &load.cache_bytes);
+		} else {
+			err = -EINVAL;
+		}
+	}
+	return err;
+}
+
+bool bench_load_enabled(void) {
+	return load.cpu_pct || load.mem_bytes || load.mem_pct ||
+	       load.syscall_threads || load.cache_threads;
+}
+
+/* ---------------- 负载线程 ---------------- */
+
+static __u64 load_thread_cpu_ns(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 每个周期内先空转 cpu_pct%，其余时间睡眠到下一个周期开始
+static void load_cpu(struct load_thread *t) {
+	__u64 busy = LOAD_CPU_PERIOD_NS * load.cpu_pct / 100;
+	struct timespec next;
+	__u64 start;
+
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	while (!load.stop) {
+		start = bench_now_ns();
+		while (bench_now_ns() - start < busy)
+			;
+		next.tv_nsec += LOAD_CPU_PERIOD_NS;
+		while (next.tv_nsec >= 1000000000L) {
+			next.tv_nsec -= 1000000000L;
+			next.tv_sec++;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+	}
+}
+
+// 先逐页写满，之后周期性地重新触碰全部页面，使其保持常驻
+static void load_mem(struct load_thread *t) {
+	long page = sysconf(_SC_PAGESIZE);
+
+	while (!load.stop) {
+		for (size_t off = 0; off < load.mem_len && !load.stop; off += page)
+			load.mem[off]++;
+		load.mem_ready = true;
+		t->count++;
+		usleep(LOAD_MEM_RETOUCH_US);
+	}
+}
+
+static void load_syscall(struct load_thread *t) {
+	while (!load.stop) {
+		syscall(SYS_getppid);
+		t->count++;
+	}
+}
+
+// 以缓存行为步长读改写超过末级缓存容量的缓冲区，持续占用内存带宽
+static void load_cache(struct load_thread *t) {
+	while (!load.stop) {
+		for (__u64 off = 0; off < load.cache_bytes; off += LOAD_CACHE_LINE)
+			t->buf[off]++;
+		t->count += load.cache_bytes;
+	}
+}
+
+static void *load_thread_fn(void *arg) {
+	struct load_thread *t = arg;
+	__u64 start = bench_now_ns();
+
+	switch (t->kind) {
+	case LOAD_CPU:
+		load_cpu(t);
+		break;
+	case LOAD_MEM:
+		load_mem(t);
+		break;
+	case LOAD_SYSCALL:
+		load_syscall(t);
+		break;
+	case LOAD_CACHE:
+		load_cache(t);
+		break;
+	}
+	t->wall_ns = bench_now_ns() - start;
+	t->cpu_ns = load_thread_cpu_ns();
+	return NULL;
+}
+
+/* ---------------- 系统负载采样 ---------------- */
+
+static long long load_meminfo(const char *key) {
+	char line[256];
+	long long kb = -1;
+	FILE *f;
+
+	f = fopen("/proc/meminfo", "r");
+	if (!f)
+		return -1;
+	while (fgets(line, sizeof(line), f)) {
+		if (strncmp(line, key, strlen(key)) == 0 &&
+		    line[strlen(key)] == ':') {
+			sscanf(line + strlen(key) + 1, "%lld", &kb);
+			break;
+		}
+	}
+	fclose(f);
+	return kb < 0 ? -1 : kb * 1024;
+}
+
+// 读取 /proc/stat 中每个CPU的忙碌时间与总时间
+static void load_read_stat(unsigned long long *busy,
+                           unsigned long long *total, int nr) {
+	unsigned long long v[8];
+	char line[512];
+	FILE *f;
+	int cpu;
+
+	memset(busy, 0, nr * sizeof(*busy));
+	memset(total, 0, nr * sizeof(*total));
+	f = fopen("/proc/stat", "r");
+	if (!f)
+		return;
+	while (fgets(line, sizeof(line), f)) {
+		if (sscanf(line, "cpu%d %llu %llu %llu %llu %llu %llu %llu %llu", &cpu,
+		           &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6],
+		           &v[7]) != 9 ||
+		    cpu < 0 || cpu >= nr)
+			continue;
+		total[cpu] = v[0] + v[1] + v[2] + v[3] + v[4] + v[5] + v[6] + v[7];
+		// idle 与 iowait 之外的时间都算忙碌
+		busy[cpu] = total[cpu] - v[3] - v[4];
+	}
+	fclose(f);
+}
+
+// 负载CPU在运行期间的平均忙碌比例(%)
+static double load_cpu_busy_pct(void) {
+	unsigned long long *busy, *total, b = 0, t = 0;
+
+	busy = calloc(load.nr_stat, sizeof(*busy));
+	total = calloc(load.nr_stat, sizeof(*total));
+	if (!busy || !total) {
+		free(busy);
+		free(total);
+		return NAN;
+	}
+	load_read_stat(busy, total, load.nr_stat);
+	for (int i = 0; i < load.nr_stat; i++) {
+		if (!load.load_cpu[i])
+			continue;
+		b += busy[i] - load.stat_busy[i];
+		t += total[i] - load.stat_total[i];
+	}
+	free(busy);
+	free(total);
+	return t ? 100.0 * b / t : NAN;
+}
+
+// 统计内存负载区域中实际常驻的字节数
+static __u64 load_mem_resident(void) {
+	long page = sysconf(_SC_PAGESIZE);
+	size_t nr_pages = (load.mem_len + page - 1) / page;
+	unsigned char *vec;
+	__u64 resident = 0;
+
+	vec = malloc(nr_pages);
+	if (!vec || mincore(load.mem, load.mem_len, vec)) {
+		free(vec);
+		return 0;
+	}
+	for (size_t i = 0; i < nr_pages; i++)
+		resident += (vec[i] & 1) ? page : 0;
+	free(vec);
+	return resident;
+}
+
+// 末级缓存容量，读取失败时使用默认值
+static __u64 load_llc_bytes(void) {
+	__u64 size = 0, v;
+	char path[96], buf[32];
+	FILE *f;
+
+	for (int i = 0; i < 8; i++) {
+		snprintf(path, sizeof(path),
+		         "/sys/devices/system/cpu/cpu0/cache/index%d/size", i);
+		f = fopen(path, "r");
+		if (!f)
+			break;
+		if (fgets(buf, sizeof(buf), f)) {
+			buf[strcspn(buf, "\n")] = '\0';
+			if (!load_parse_size(buf, &v) && v > size)
+				size = v;
+		}
+		fclose(f);
+	}
+	return size ? size : LOAD_CACHE_DEFAULT / 2;
+}
+
+/* ---------------- 启动与停止 ---------------- */
+
+static int load_spawn(int kind, int cpu) {
+	struct load_thread *t = &load.threads[load.nr_threads];
+	pthread_attr_t attr;
+	cpu_set_t cpus;
+	int err;
+
+	t->kind = kind;
+	t->cpu = cpu;
+	if (kind == LOAD_CACHE) {
+		t->buf = malloc(load.cache_bytes);
+		if (!t->buf) {
+			fprintf(stderr, "Failed to allocate %llu bytes for cache load\n",
+			        (unsigned long long)load.cache_bytes);
+			return -ENOMEM;
+		}
+	}
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	pthread_attr_init(&attr);
+	pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+	// 负载线程不继承测量线程的 SCHED_FIFO
+	bench_attr_sched_other(&attr);
+	err = pthread_create(&t->tid, &attr, load_thread_fn, t);
+	pthread_attr_destroy(&attr);
+	if (err) {
+		free((void *)t->buf);
+		t->buf = NULL;
+		return -err;
+	}
+	load.nr_threads++;
+	return 0;
+}
+
+static void load_join(void) {
+	load.stop = true;
+	for (int i = 0; i < load.nr_threads; i++)
+		pthread_join(load.threads[i].tid, NULL);
+}
+
+static void load_free(void) {
+	if (load.mem)
+		munmap(load.mem, load.mem_len);
+	for (int i = 0; i < load.nr_threads; i++)
+		free((void *)load.threads[i].buf);
+	free(load.threads);
+	free(load.load_cpu);
+	free(load.stat_busy);
+	free(load.stat_total);
+	load.threads = NULL;
+	load.nr_threads = 0;
+	load.mem = NULL;
+	load.load_cpu = NULL;
+	load.stat_busy = NULL;
+	load.stat_total = NULL;
+	load.nr_stat = 0;
+}
+
+bool bench_load_on_cpu(int cpu) {
+	return load.load_cpu && cpu >= 0 && cpu < load.nr_stat &&
+	       load.load_cpu[cpu];
+}
+
+int bench_load_start(volatile bool *exiting) {
+	int nr_online = sysconf(_SC_NPROCESSORS_ONLN), nr_cpus = 0, next = 0;
+	int nr_conf = sysconf(_SC_NPROCESSORS_CONF), *cpus, total, err = 0;
+	int measure_cpu = bench_env_cpu();
+	cpu_set_t set;
+
+	if (!bench_load_enabled())
+		return 0;
+	cpus = calloc(nr_conf, sizeof(*cpus));
+	load.load_cpu = calloc(nr_conf, sizeof(*load.load_cpu));
+	load.stat_busy = calloc(nr_conf, sizeof(*load.stat_busy));
+	load.stat_total = calloc(nr_conf, sizeof(*load.stat_total));
+	if (!cpus || !load.load_cpu || !load.stat_busy || !load.stat_total) {
+		free(cpus);
+		load_free();
+		return -ENOMEM;
+	}
+	load.nr_stat = nr_conf;
+
+	// 测量线程固定在测量CPU上，负载线程轮流分布到其余允许运行的CPU
+	// (按绑核前的亲和性，-n 已把调用线程绑定到测量CPU)
+	for (int i = 0; i < nr_conf; i++) {
+		if (i != measure_cpu && bench_env_cpu_allowed(i))
+			cpus[nr_cpus++] = i;
+	}
+	if (!nr_cpus) {
+		fprintf(stderr, "Warning: only one CPU, load shares the "
+		                "measurement CPU\n");
+		cpus[nr_cpus++] = measure_cpu;
+	}
+	for (int i = 0; i < nr_cpus; i++)
+		load.load_cpu[cpus[i]] = true;
+	CPU_ZERO(&set);
+	CPU_SET(measure_cpu, &set);
+	sched_setaffinity(0, sizeof(set), &set);
+
+	if (load.cpu_pct && !load.cpu_threads)
+		load.cpu_threads = nr_online > 1 ? nr_online - 1 : 1;
+	if (load.cache_threads && !load.cache_bytes)
+		load.cache_bytes = 2 * load_llc_bytes();
+	if (load.mem_pct) {
+		long long mem_total = load_meminfo("MemTotal");
+		long long used = mem_total - load_meminfo("MemAvailable");
+		long long target = mem_total / 100 * load.mem_pct - used;
+
+		load.mem_bytes = target > 0 ? target : 0;
+		if (!load.mem_bytes)
+			fprintf(stderr, "Warning: memory use already above %d%%\n",
+			        load.mem_pct);
+	}
+	if (load.mem_bytes) {
+		load.mem_len = load.mem_bytes;
+		load.mem = mmap(NULL, load.mem_len, PROT_READ | PROT_WRITE,
+		                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (load.mem == MAP_FAILED) {
+			err = -errno;
+			load.mem = NULL;
+			fprintf(stderr, "Failed to map %llu bytes for memory load: %d\n",
+			        (unsigned long long)load.mem_len, err);
+			free(cpus);
+			load_free();
+			return err;
+		}
+		// -n 的 mlockall(MCL_FUTURE) 会锁定新映射，负载内存应当和普通进程
+		// 一样可以被回收或换出
+		munlock(load.mem, load.mem_len);
+	}
+
+	total = (load.mem ? 1 : 0) + load.cpu_threads + load.syscall_threads +
+	        load.cache_threads;
+	load.threads = calloc(total, sizeof(*load.threads));
+	if (!load.threads) {
+		free(cpus);
+		load_free();
+		return -ENOMEM;
+	}
+	load_read_stat(load.stat_busy, load.stat_total, load.nr_stat);
+	if (load.mem)
+		err = load_spawn(LOAD_MEM, cpus[next++ % nr_cpus]);
+	for (int i = 0; !err && i < load.cpu_threads; i++)
+		err = load_spawn(LOAD_CPU, cpus[next++ % nr_cpus]);
+	for (int i = 0; !err && i < load.syscall_threads; i++)
+		err = load_spawn(LOAD_SYSCALL, cpus[next++ % nr_cpus]);
+	for (int i = 0; !err && i < load.cache_threads; i++)
+		err = load_spawn(LOAD_CACHE, cpus[next++ % nr_cpus]);
+	free(cpus);
+	if (err) {
+		fprintf(stderr, "Failed to start load thread: %d\n", err);
+		load_join();
+		load_free();
+		return err;
+	}
+	if (load.mem) {
+		fprintf(stderr, "Touching %llu MiB of memory load...\n",
+		        (unsigned long long)(load.mem_len >> 20));
+		while (!load.mem_ready && !*exiting)
+			usleep(10000);
+	}
+	fprintf(stderr, "Background load running: %s\n", load.spec);
+	return 0;
+}
+
+void bench_load_stop(void) {
+	int nr_cpu = 0, nr_sys = 0, nr_cache = 0;
+	double cpu_ns = 0, cpu_wall = 0, sys_rate = 0, cache_rate = 0;
+	double busy_pct, cpu_pct = NAN, mem_pct = NAN;
+	long long mem_total, mem_avail;
+	__u64 resident = 0;
+
+	if (!load.threads)
+		return;
+	// 线程退出前先采样，避免把停止过程计入
+	busy_pct = load_cpu_busy_pct();
+	if (load.mem)
+		resident = load_mem_resident();
+	mem_total = load_meminfo("MemTotal");
+	mem_avail = load_meminfo("MemAvailable");
+	if (mem_total > 0 && mem_avail >= 0)
+		mem_pct = 100.0 * (mem_total - mem_avail) / mem_total;
+
+	load_join();
+	for (int i = 0; i < load.nr_threads; i++) {
+		struct load_thread *t = &load.threads[i];
+
+		switch (t->kind) {
+		case LOAD_CPU:
+			nr_cpu++;
+			cpu_ns += t->cpu_ns;
+			cpu_wall += t->wall_ns;
+			break;
+		case LOAD_SYSCALL:
+			nr_sys++;
+			sys_rate += t->wall_ns ? t->count * 1e9 / t->wall_ns : 0;
+			break;
+		case LOAD_CACHE:
+			nr_cache++;
+			cache_rate += t->wall_ns ? t->count * 1e9 / t->wall_ns : 0;
+			break;
+		}
+	}
+	if (cpu_wall)
+		cpu_pct = 100.0 * cpu_ns / cpu_wall;
+
+	printf("\nBackground load (%s):\n", load.spec);
+	if (nr_cpu)
+		printf("  cpu      %d threads, target %d%%, achieved %.1f%% per "
+		       "thread\n",
+		       nr_cpu, load.cpu_pct, cpu_pct);
+	printf("  cpus     load CPUs %.1f%% busy\n", busy_pct);
+	if (load.mem)
+		printf("  mem      %llu MiB resident of %llu MiB, system memory "
+		       "%.1f%% used\n",
+		       (unsigned long long)(resident >> 20),
+		       (unsigned long long)(load.mem_len >> 20), mem_pct);
+	if (nr_sys)
+		printf("  syscall  %d threads, %.2f M calls/s\n", nr_sys,
+		       sys_rate / 1e6);
+	if (nr_cache)
+		printf("  cache    %d threads x %llu MiB, %.2f GB/s\n", nr_cache,
+		       (unsigned long long)(load.cache_bytes >> 20),
+		       cache_rate / 1e9);
+	BENCH_OUTPUT("load", BF_STR("spec", load.spec),
+	             BF_U64("cpu_threads", nr_cpu),
+	             BF_F64("cpu_target_pct", nr_cpu ? load.cpu_pct : NAN),
+	             BF_F64("cpu_achieved_pct", cpu_pct),
+	             BF_F64("load_cpus_busy_pct", busy_pct),
+	             BF_U64("mem_target_bytes", load.mem_len),
+	             BF_U64("mem_resident_bytes", resident),
+	             BF_F64("mem_used_pct", mem_pct),
+	             BF_U64("syscall_threads", nr_sys),
+	             BF_F64("syscalls_per_sec", nr_sys ? sys_rate : NAN),
+	             BF_U64("cache_threads", nr_cache),
+	             BF_U64("cache_buffer_bytes", nr_cache ? load.cache_bytes : 0),
+	             BF_F64("cache_bytes_per_sec", nr_cache ? cache_rate : NAN));
+	load_free();
+}
@@ -0,0 +1,317 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Local storage vs pid-keyed hash benchmark.
+#include "bench_local_storage.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_util.h"
+#include "common.h"
+#include "local_storage.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// 每轮负载创建的任务数，超过 hash 容量(8192)以暴露未清理时的残留
+#define LS_NR_TASKS 20000
+// 同时存活的子进程数
+#define LS_INFLIGHT 8
+// 每个子进程退出前执行的系统调用次数
+#define LS_CHILD_SYSCALLS 16
+// 每个变体最多附加的程序数
+#define LS_MAX_PROGS 2
+
+struct ls_variant {
+	const char *name;
+	const char *progs[LS_MAX_PROGS];
+	int nr_progs;
+	// 返回该变体使用的map
+	struct bpf_map *(*map)(struct local_storage_bpf *skel);
+	// 按pid索引的map可在用户态遍历统计残留条目；其余为本地存储，
+	// 元素随所属任务/cgroup分配与释放，fdinfo 的 memlock 只含map本身，
+	// 各变体之间按 memcg 用量的变化比较
+	bool pid_keyed;
+};
+
+static struct bpf_map *ls_task(struct local_storage_bpf *skel) {
+	return skel->maps.ls_task_map;
+}
+static struct bpf_map *ls_cgrp(struct local_storage_bpf *skel) {
+	return skel->maps.ls_cgrp_map;
+}
+static struct bpf_map *ls_hash(struct local_storage_bpf *skel) {
+	return skel->maps.ls_hash_map;
+}
+static struct bpf_map *ls_lru(struct local_storage_bpf *skel) {
+	return skel->maps.ls_lru_map;
+}
+
+static const struct ls_variant ls_variants[] = {
+    {"task_storage", {"ls_sys_task"}, 1, ls_task, false},
+    {"cgrp_storage", {"ls_sys_cgrp"}, 1, ls_cgrp, false},
+    {"hash", {"ls_sys_hash"}, 1, ls_hash, true},
+    {"hash_cleanup", {"ls_sys_hash", "ls_exit_hash"}, 2, ls_hash, true},
+    {"lru_hash", {"ls_sys_lru"}, 1, ls_lru, true},
+};
+
+// 负载生成: 持续创建子进程，子进程执行若干系统调用后退出或 exec /bin/true
+static int ls_churn(bool do_exec, volatile bool *exiting, __u32 *nr_tasks) {
+	int inflight = 0, err = -EINTR;
+	pid_t pid;
+
+	*nr_tasks = 0;
+	while (*nr_tasks < LS_NR_TASKS && !*exiting) {
+		if (inflight >= LS_INFLIGHT) {
+			if (wait(NULL) > 0)
+				inflight--;
+		}
+		pid = fork();
+		if (pid < 0) {
+			err = -errno;
+			fprintf(stderr, "fork failed: %d\n", err);
+			break;
+		}
+		if (pid == 0) {
+			for (int i = 0; i < LS_CHILD_SYSCALLS; i++)
+				getppid();
+			if (do_exec)
+				execl("/bin/true", "true", (char *)NULL);
+			_exit(0);
+		}
+		inflight++;
+		(*nr_tasks)++;
+	}
+	// Ctrl-C 打断时仍要回收全部子进程
+	while (inflight > 0) {
+		if (wait(NULL) > 0)
+			inflight--;
+		else if (errno != EINTR)
+			break;
+	}
+	return *nr_tasks ? 0 : err;
+}
+
+// 遍历按pid索引的map，统计总条目数与对应进程已不存在的残留条目数
+static void ls_count_entries(int fd, __u32 *entries, __u32 *stale) {
+	__u32 key, next, *prev = NULL;
+
+	*entries = *stale = 0;
+	while (bpf_map_get_next_key(fd, prev, &next) == 0) {
+		(*entries)++;
+		if (kill((pid_t)next, 0) && errno == ESRCH)
+			(*stale)++;
+		key = next;
+		prev = &key;
+	}
+}
+
+static int ls_sum_stats(struct local_storage_bpf *skel, struct ls_stat *sum) {
+	int nr_cpus = libbpf_num_possible_cpus();
+	struct ls_stat *vals;
+	__u32 zero = 0;
+
+	memset(sum, 0, sizeof(*sum));
+	vals = calloc(nr_cpus, sizeof(*vals));
+	if (!vals)
+		return -ENOMEM;
+	if (bpf_map_lookup_elem(bpf_map__fd(skel->maps.ls_stats), &zero, vals)) {
+		free(vals);
+		return -errno;
+	}
+	for (int i = 0; i < nr_cpus; i++) {
+		sum->lookup_ns += vals[i].lookup_ns;
+		sum->lookups += vals[i].lookups;
+		sum->create_ns += vals[i].create_ns;
+		sum->creates += vals[i].creates;
+		sum->create_fails += vals[i].create_fails;
+		sum->clock_ns += vals[i].clock_ns;
+		sum->clocks += vals[i].clocks;
+	}
+	free(vals);
+	return 0;
+}
+
+// 平均耗时并扣除一次 bpf_ktime_get_ns 的开销
+static double ls_avg(__u64 ns, __u64 nr, double clock_ns) {
+	double avg;
+
+	if (!nr)
+		return 0;
+	avg = (double)ns / nr - clock_ns;
+	return avg > 0 ? avg : 0;
+}
+
+static void ls_print_unsupported(const struct ls_variant *v,
+                                 const char *workload) {
+	printf("%-13s %-15s %s\n", v->name, workload,
+	       "unsupported by running kernel");
+	fflush(stdout);
+	BENCH_OUTPUT("local_storage", BF_STR("variant", v->name),
+	             BF_STR("workload", workload), BF_STR("status", "unsupported"));
+}
+
+static int ls_run_one(const struct ls_variant *v, bool do_exec,
+                      volatile bool *exiting) {
+	const char *workload = do_exec ? "fork_exec_exit" : "fork_exit";
+	struct bpf_link *links[LS_MAX_PROGS] = {};
+	struct local_storage_bpf *skel;
+	char entries_str[16] = "-", stale_str[16] = "-";
+	long long mem_before, mem_after, memcg_before, memcg_after;
+	struct bpf_program *prog;
+	struct ls_stat st;
+	__u32 nr_tasks, entries = 0, stale = 0;
+	__u64 start, wall_ns;
+	double clock_ns, task_us, memcg_delta;
+	int nr_links = 0, err;
+
+	skel = BENCH_SKEL_OPEN(local_storage);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return -errno;
+	}
+	bench_autoload_only(skel->obj, v->progs, v->nr_progs);
+	if (!bpf_map__autocreate(v->map(skel))) {
+		ls_print_unsupported(v, workload);
+		local_storage_bpf__destroy(skel);
+		return 0;
+	}
+	// 从创建map之前开始计，预分配的 hash 在创建时就已占用全部条目
+	bench_memcg_settle();
+	memcg_before = bench_memcg_usage();
+	err = BENCH_SKEL_LOAD(local_storage, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load %s programs: %d\n", v->name, err);
+		goto out;
+	}
+	start = bench_now_ns();
+	bpf_object__for_each_program(prog, skel->obj) {
+		if (!bpf_program__autoload(prog))
+			continue;
+		links[nr_links] = bpf_program__attach(prog);
+		if (!links[nr_links]) {
+			err = -errno;
+			fprintf(stderr, "Failed to attach %s: %d\n",
+			        bpf_program__name(prog), err);
+			goto out;
+		}
+		nr_links++;
+	}
+	bench_skel_time("local_storage", BENCH_SKEL_PHASE_ATTACH,
+	                bench_now_ns() - start);
+
+	mem_before = bench_map_memlock(bpf_map__fd(v->map(skel)));
+	skel->bss->ls_gen_tgid = getpid();
+	start = bench_now_ns();
+	err = ls_churn(do_exec, exiting, &nr_tasks);
+	wall_ns = bench_now_ns() - start;
+	skel->bss->ls_gen_tgid = 0;
+	if (err)
+		goto out;
+	mem_after = bench_map_memlock(bpf_map__fd(v->map(skel)));
+	// 子进程退出后本地存储元素随之释放，hash 中未清理的条目会留下
+	bench_memcg_settle();
+	memcg_after = bench_memcg_usage();
+	memcg_delta = memcg_before < 0 || memcg_after < 0
+	                  ? NAN
+	                  : (double)(memcg_after - memcg_before);
+	// ls_churn 没有创建任何任务时已返回错误，这里仍不依赖这一点
+	task_us = nr_tasks ? (double)wall_ns / nr_tasks / 1000 : NAN;
+
+	err = ls_sum_stats(skel, &st);
+	if (err) {
+		fprintf(stderr, "Failed to read ls_stats: %d\n", err);
+		goto out;
+	}
+	if (v->pid_keyed) {
+		ls_count_entries(bpf_map__fd(v->map(skel)), &entries, &stale);
+		snprintf(entries_str, sizeof(entries_str), "%u", entries);
+		snprintf(stale_str, sizeof(stale_str), "%u", stale);
+	}
+	clock_ns = st.clocks ? (double)st.clock_ns / st.clocks : 0;
+	// 本地存储的 memlock 只是map本身，用 * 标出，不能与 hash 按条目比较
+	printf("%-13s %-15s %-7u %-10llu %-10.1f %-8llu %-10.1f %-8llu %-8s "
+	       "%-8s %-10lld %-10lld %-3s %-11.1f %-10.1f\n",
+	       v->name, workload, nr_tasks, st.lookups,
+	       ls_avg(st.lookup_ns, st.lookups, clock_ns), st.creates,
+	       ls_avg(st.create_ns, st.creates, clock_ns), st.create_fails,
+	       entries_str, stale_str, mem_before, mem_after,
+	       v->pid_keyed ? "" : "*", memcg_delta / 1024, task_us);
+	fflush(stdout);
+	BENCH_OUTPUT("local_storage", BF_STR("variant", v->name),
+	             BF_STR("workload", workload), BF_STR("status", "ok"),
+	             BF_U64("max_entries", bpf_map__max_entries(v->map(skel))),
+	             BF_U64("map_flags", bpf_map__map_flags(v->map(skel))),
+	             BF_U64("tasks", nr_tasks), BF_U64("lookups", st.lookups),
+	             BF_F64("lookup_ns", ls_avg(st.lookup_ns, st.lookups, clock_ns)),
+	             BF_U64("creates", st.creates),
+	             BF_F64("create_ns", ls_avg(st.create_ns, st.creates, clock_ns)),
+	             BF_U64("create_fails", st.create_fails),
+	             BF_F64("entries", v->pid_keyed ? entries : NAN),
+	             BF_F64("stale", v->pid_keyed ? stale : NAN),
+	             BF_I64("memlock_before", mem_before),
+	             BF_I64("memlock_after", mem_after),
+	             BF_STR("memlock_scope", v->pid_keyed ? "entries" : "map_header"),
+	             BF_F64("memcg_delta_bytes", memcg_delta),
+	             BF_F64("task_us", task_us));
+out:
+	// 骨架只管理 skel->links 中的link，这里单独附加的要自己分离
+	while (nr_links > 0)
+		bpf_link__destroy(links[--nr_links]);
+	local_storage_bpf__destroy(skel);
+	return err;
+}
+
+int bench_local_storage(volatile bool *exiting) {
+	int err = 0;
+
+	printf("MEMLOCK: map memlock from fdinfo; * = local storage, map header "
+	       "only (per-owner elements are not counted)\n");
+	printf("MEMCG+: memory cgroup usage from before map creation to after "
+	       "the churn (%s), comparable across variants\n",
+	       bench_memcg_path() ? bench_memcg_path() : "unavailable");
+	printf("%-13s %-15s %-7s %-10s %-10s %-8s %-10s %-8s %-8s %-8s %-10s "
+	       "%-10s %-3s %-11s %-10s\n",
+	       "VARIANT", "WORKLOAD", "TASKS", "LOOKUPS", "LOOKUP(ns)", "CREATES",
+	       "CREATE(ns)", "FAILS", "ENTRIES", "STALE", "MLOCK_BEF", "MLOCK_AFT",
+	       "", "MEMCG+(KB)", "TASK(us)");
+	for (size_t i = 0; !err && i < sizeof(ls_variants) / sizeof(ls_variants[0]);
+	     i++) {
+		for (int e = 0; !err && e < 2 && !*exiting; e++)
+			err = ls_run_one(&ls_variants[i], e, exiting);
+	}
+	return err;
+}
+
+// task/cgroup 本地存储map不支持时由基准测试自身逐行跳过
+static const struct bench_feature local_storage_feats[] = {
+    BENCH_PROG(TRACING), BENCH_MAP(HASH), BENCH_MAP(LRU_HASH),
+    BENCH_MAP(PERCPU_ARRAY),
+};
+
+BENCH_REGISTER(local_storage) = {
+    .name = "local_storage",
+    .key = 's',
+    .doc = "Benchmark task/cgroup local storage against pid-keyed hash maps",
+    .feats = local_storage_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(local_storage_feats),
+    .schema = "variant,workload,status,max_entries,map_flags,tasks,lookups,"
+              "lookup_ns,creates,create_ns,create_fails,entries,stale,"
+              "memlock_before,memlock_after,memlock_scope,memcg_delta_bytes,"
+              "task_us",
+    .run = bench_local_storage,
+};
@@ -0,0 +1,468 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// LPM trie map benchmark.
+#include "bench_lpm.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_timer.h"
+#include "bench_util.h"
+#include "common.h"
+#include "lpm.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 内核态单次 test_run 的重复次数(持续增删期间循环执行)
+#define LPM_CHURN_BATCH 4096
+
+static const __u32 lpm_sizes[] = {1024, 16384, 262144, 1048576};
+
+// 前缀长度分布，权重以千分比表示
+struct lpm_dist {
+	__u32 plen;
+	__u32 weight;
+};
+// 参考公网BGP路由表(/24占多数)，另含少量主机路由
+static const struct lpm_dist lpm_v4_dist[] = {
+    {8, 1},    {12, 4},   {16, 20}, {18, 20}, {19, 40}, {20, 50},
+    {21, 50},  {22, 110}, {23, 100}, {24, 560}, {28, 15}, {32, 30},
+};
+// 参考公网IPv6路由表(/48占多数)，另含少量/64与主机路由
+static const struct lpm_dist lpm_v6_dist[] = {
+    {29, 30}, {32, 120}, {36, 50}, {40, 70}, {44, 80}, {46, 30},
+    {47, 20}, {48, 450}, {56, 50}, {64, 50}, {128, 50},
+};
+
+struct lpm_family {
+	const char *name;
+	__u32 addr_len;
+	const struct lpm_dist *dist;
+	int nr_dist;
+};
+static const struct lpm_family lpm_families[] = {
+    {"ipv4", 4, lpm_v4_dist, sizeof(lpm_v4_dist) / sizeof(lpm_v4_dist[0])},
+    {"ipv6", 16, lpm_v6_dist, sizeof(lpm_v6_dist) / sizeof(lpm_v6_dist[0])},
+};
+
+struct lpm_ctx {
+	struct lpm_bpf *skel;
+	const struct lpm_family *fam;
+	__u32 size;
+	int map_fd;
+	int keys_fd;
+	int prog_fd;
+	int base_fd;
+	// 已写入的前缀，IPv4 只使用 addr 的前4个字节
+	struct lpm_v6_key *prefixes;
+	__u32 nr_prefixes;
+	__u32 *match;
+	struct lpm_v6_key *keys;
+	__u64 *samples;
+	__u64 rng;
+};
+
+static __u64 lpm_rand(__u64 *state) {
+	__u64 x = *state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 2685821657736338717ULL;
+}
+
+// 前 plen 位保留 addr 的值，其余位取 fill 的值
+static void lpm_merge(struct lpm_v6_key *key, const unsigned char *fill,
+                      __u32 plen, __u32 addr_len) {
+	for (__u32 i = 0; i < addr_len; i++) {
+		unsigned char mask;
+
+		if (plen >= (i + 1) * 8)
+			mask = 0xff;
+		else if (plen <= i * 8)
+			mask = 0;
+		else
+			mask = 0xff << (8 - (plen - i * 8));
+		key->addr[i] = (key->addr[i] & mask) | (fill[i] & ~mask);
+	}
+}
+
+static void lpm_random_bytes(struct lpm_ctx *c, unsigned char *buf,
+                             __u32 len) {
+	for (__u32 i = 0; i < len; i++)
+		buf[i] = lpm_rand(&c->rng);
+}
+
+static void lpm_gen_prefix(struct lpm_ctx *c, struct lpm_v6_key *key) {
+	const struct lpm_family *fam = c->fam;
+	unsigned char zero[16] = {};
+	__u32 r = lpm_rand(&c->rng) % 1000, acc = 0;
+	__u32 plen = fam->dist[fam->nr_dist - 1].plen;
+
+	for (int i = 0; i < fam->nr_dist; i++) {
+		acc += fam->dist[i].weight;
+		if (r < acc) {
+			plen = fam->dist[i].plen;
+			break;
+		}
+	}
+	memset(key, 0, sizeof(*key));
+	key->prefixlen = plen;
+	lpm_random_bytes(c, key->addr, fam->addr_len);
+	lpm_merge(key, zero, plen, fam->addr_len);
+}
+
+// 写入一条新前缀(已存在则重新生成)，返回写入耗时
+static int lpm_insert_new(struct lpm_ctx *c, struct lpm_v6_key *key,
+                          __u64 *ns) {
+	__u32 value = 1;
+	__u64 start;
+	int err;
+
+	for (int tries = 0; tries < 64; tries++) {
+		lpm_gen_prefix(c, key);
+		start = bench_timer_start();
+		err = bpf_map_update_elem(c->map_fd, key, &value, BPF_NOEXIST);
+		*ns = bench_timer_ns(start, bench_timer_stop());
+		if (err != -EEXIST)
+			return err;
+	}
+	return -EEXIST;
+}
+
+static int lpm_fill(struct lpm_ctx *c) {
+	__u64 ns;
+	int err;
+
+	c->nr_prefixes = 0;
+	while (c->nr_prefixes < c->size) {
+		err = lpm_insert_new(c, &c->prefixes[c->nr_prefixes], &ns);
+		// 短前缀的地址空间较小，多次冲突后按已写入的数量继续
+		if (err == -EEXIST)
+			break;
+		if (err) {
+			fprintf(stderr, "Failed to insert %s prefix: %d\n", c->fam->name,
+			        err);
+			return err;
+		}
+		c->nr_prefixes++;
+	}
+	return 0;
+}
+
+// 生成落在指定前缀长度(0表示任意长度)前缀内的查找地址
+static __u32 lpm_build_keys(struct lpm_ctx *c, __u32 plen) {
+	__u32 nr_match = 0, max_plen = c->fam->addr_len * 8;
+	unsigned char host[16];
+
+	for (__u32 i = 0; i < c->nr_prefixes; i++)
+		if (!plen || c->prefixes[i].prefixlen == plen)
+			c->match[nr_match++] = i;
+	if (!nr_match)
+		return 0;
+	for (__u32 i = 0; i < LPM_LOOKUP_KEYS; i++) {
+		struct lpm_v6_key *key = &c->keys[i];
+
+		*key = c->prefixes[c->match[lpm_rand(&c->rng) % nr_match]];
+		lpm_random_bytes(c, host, c->fam->addr_len);
+		lpm_merge(key, host, key->prefixlen, c->fam->addr_len);
+		key->prefixlen = max_plen;
+	}
+	return LPM_LOOKUP_KEYS;
+}
+
+static int lpm_upload_keys(struct lpm_ctx *c, __u32 nr) {
+	for (__u32 i = 0; i < nr; i++) {
+		if (bpf_map_update_elem(c->keys_fd, &i, &c->keys[i], BPF_ANY)) {
+			fprintf(stderr, "Failed to upload lookup keys: %d\n", errno);
+			return -errno;
+		}
+	}
+	c->skel->bss->lpm_nr_keys = nr;
+	c->skel->bss->lpm_seq = 0;
+	return 0;
+}
+
+// 内核态查找耗时，扣除只取查找地址的基线程序
+static int lpm_kernel_lookup(struct lpm_ctx *c, __u32 repeat, double *avg) {
+	__u64 base_ns, ns;
+	int err;
+
+	err = bench_prog_run(c->base_fd, repeat, &base_ns);
+	if (!err)
+		err = bench_prog_run(c->prog_fd, repeat, &ns);
+	if (err) {
+		fprintf(stderr, "Failed to run LPM lookup program: %d\n", err);
+		return err;
+	}
+	*avg = ns > base_ns ? ns - base_ns : 0;
+	return 0;
+}
+
+static void lpm_print(struct lpm_ctx *c, bool kernel, const char *op,
+                      __u32 plen, __u32 ops, const struct bench_lat *lat) {
+	char plen_str[8] = "mix";
+
+	if (plen)
+		snprintf(plen_str, sizeof(plen_str), "%u", plen);
+	printf("%-6s %-8u %-6s %-18s %-5s %-8u %-10.1f ", c->fam->name,
+	       c->nr_prefixes, kernel ? "kernel" : "user", op, plen_str, ops,
+	       lat->avg);
+	if (kernel)
+		printf("%-10s %-10s\n", "-", "-");
+	else
+		printf("%-10.0f %-10.0f\n", lat->p50, lat->p99);
+	fflush(stdout);
+	BENCH_OUTPUT("lpm", BF_STR("family", c->fam->name),
+	             BF_U64("max_entries", c->size),
+	             BF_U64("prefixes", c->nr_prefixes),
+	             BF_STR("map_flags", "BPF_F_NO_PREALLOC"),
+	             BF_STR("side", kernel ? "kernel" : "user"), BF_STR("op", op),
+	             BF_STR("prefixlen", plen_str), BF_U64("ops", ops),
+	             BF_F64("avg_ns", lat->avg),
+	             BF_F64("p50_ns", kernel ? NAN : lat->p50),
+	             BF_F64("p99_ns", kernel ? NAN : lat->p99));
+}
+
+// 按目标前缀长度分组测量查找延迟，体现 trie 深度的影响
+static int lpm_lookup_by_plen(struct lpm_ctx *c, __u32 plen) {
+	struct bench_lat lat;
+	char phase[64];
+	__u32 nr, value;
+	__u64 start;
+	int err;
+
+	nr = lpm_build_keys(c, plen);
+	if (!nr)
+		return 0;
+	for (__u32 i = 0; i < nr; i++) {
+		start = bench_timer_start();
+		err = bpf_map_lookup_elem(c->map_fd, &c->keys[i], &value);
+		c->samples[i] = bench_timer_ns(start, bench_timer_stop());
+		if (err) {
+			fprintf(stderr, "%s lookup missed an inserted prefix: %d\n",
+			        c->fam->name, err);
+			return err;
+		}
+	}
+	snprintf(phase, sizeof(phase), "lpm/%s/%u/lookup/%u", c->fam->name,
+	         c->nr_prefixes, plen);
+	bench_lat_summarize(phase, c->samples, nr, &lat);
+	lpm_print(c, false, "lookup", plen, nr, &lat);
+
+	err = lpm_upload_keys(c, nr);
+	if (!err)
+		err = lpm_kernel_lookup(c, nr, &lat.avg);
+	if (err)
+		return err;
+	lpm_print(c, true, "lookup", plen, nr, &lat);
+	return 0;
+}
+
+struct lpm_churn_worker {
+	struct lpm_ctx *c;
+	bool kernel;
+	volatile bool *done;
+	__u32 ops;
+	__u64 *ins_samples;
+	__u64 *del_samples;
+	double kern_sum;
+	__u32 kern_runs;
+	int err;
+};
+
+static void *lpm_churn_fn(void *arg) {
+	struct lpm_churn_worker *w = arg;
+	struct lpm_ctx *c = w->c;
+	__u64 start;
+	double ns;
+
+	if (w->kernel) {
+		// 持续执行内核态查找，直到用户态增删结束
+		do {
+			w->err = lpm_kernel_lookup(c, LPM_CHURN_BATCH, &ns);
+			w->kern_sum += ns;
+			w->kern_runs++;
+		} while (!w->err && !*w->done);
+		return NULL;
+	}
+	// 每次删除一条已有前缀并写入一条新前缀，保持条目数不变
+	for (__u32 i = 0; i < w->ops; i++) {
+		struct lpm_v6_key *victim =
+		    &c->prefixes[lpm_rand(&c->rng) % c->nr_prefixes];
+
+		start = bench_timer_start();
+		w->err = bpf_map_delete_elem(c->map_fd, victim);
+		w->del_samples[i] = bench_timer_ns(start, bench_timer_stop());
+		if (!w->err)
+			w->err = lpm_insert_new(c, victim, &w->ins_samples[i]);
+		if (w->err)
+			break;
+	}
+	*w->done = true;
+	return NULL;
+}
+
+static int lpm_churn(struct lpm_ctx *c) {
+	__u32 ops = c->nr_prefixes < LPM_LOOKUP_KEYS ? c->nr_prefixes
+	                                             : LPM_LOOKUP_KEYS;
+	volatile bool done = false;
+	struct lpm_churn_worker workers[2] = {};
+	struct bench_lat lat;
+	char phase[64];
+	__u64 *del_samples, wall_ns;
+	int err;
+
+	del_samples = calloc(ops, sizeof(*del_samples));
+	if (!del_samples)
+		return -ENOMEM;
+	err = lpm_upload_keys(c, lpm_build_keys(c, 0));
+	for (int i = 0; i < 2; i++) {
+		workers[i].c = c;
+		workers[i].kernel = i == 1;
+		workers[i].done = &done;
+		workers[i].ops = ops;
+		workers[i].ins_samples = c->samples;
+		workers[i].del_samples = del_samples;
+	}
+	if (!err)
+		err = bench_run_threads(2, lpm_churn_fn, workers, sizeof(workers[0]),
+		                        &wall_ns);
+	if (!err)
+		err = workers[0].err ? workers[0].err : workers[1].err;
+	if (err) {
+		fprintf(stderr, "%s churn failed: %d\n", c->fam->name, err);
+		free(del_samples);
+		return err;
+	}
+	snprintf(phase, sizeof(phase), "lpm/%s/%u/insert_churn", c->fam->name,
+	         c->nr_prefixes);
+	bench_lat_summarize(phase, c->samples, ops, &lat);
+	lpm_print(c, false, "insert_churn", 0, ops, &lat);
+	snprintf(phase, sizeof(phase), "lpm/%s/%u/delete_churn", c->fam->name,
+	         c->nr_prefixes);
+	bench_lat_summarize(phase, del_samples, ops, &lat);
+	lpm_print(c, false, "delete_churn", 0, ops, &lat);
+	memset(&lat, 0, sizeof(lat));
+	lat.avg = workers[1].kern_sum / workers[1].kern_runs;
+	lpm_print(c, true, "lookup_under_churn", 0,
+	          workers[1].kern_runs * LPM_CHURN_BATCH, &lat);
+	free(del_samples);
+	return 0;
+}
+
+static struct lpm_bpf *lpm_open(__u32 size) {
+	static const char *const progs[] = {
+	    "lpm_keys_only",
+	    "lpm_lookup_v4",
+	    "lpm_lookup_v6",
+	};
+	struct lpm_bpf *skel;
+	int err;
+
+	skel = BENCH_SKEL_OPEN(lpm);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return NULL;
+	}
+	bench_autoload_only(skel->obj, progs, sizeof(progs) / sizeof(progs[0]));
+	bpf_map__set_max_entries(skel->maps.lpm_v4_map, size);
+	bpf_map__set_max_entries(skel->maps.lpm_v6_map, size);
+	err = BENCH_SKEL_LOAD(lpm, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load LPM trie programs: %d\n", err);
+		lpm_bpf__destroy(skel);
+		// 与 libbpf 一致: 返回NULL时错误码在 errno 中
+		errno = -err;
+		return NULL;
+	}
+	return skel;
+}
+
+static int lpm_run_family(struct lpm_ctx *c, volatile bool *exiting) {
+	const struct lpm_family *fam = c->fam;
+	int err;
+
+	err = lpm_fill(c);
+	if (err)
+		return err;
+	err = lpm_lookup_by_plen(c, 0);
+	for (int i = 0; !err && i < fam->nr_dist && !*exiting; i++)
+		err = lpm_lookup_by_plen(c, fam->dist[i].plen);
+	if (!err && !*exiting)
+		err = lpm_churn(c);
+	return err;
+}
+
+int bench_lpm(volatile bool *exiting) {
+	__u32 max_size = lpm_sizes[sizeof(lpm_sizes) / sizeof(__u32) - 1];
+	struct lpm_ctx c = {.rng = 0x9e3779b97f4a7c15ULL};
+	int err = 0;
+
+	c.prefixes = calloc(max_size, sizeof(*c.prefixes));
+	c.match = calloc(max_size, sizeof(*c.match));
+	c.keys = calloc(LPM_LOOKUP_KEYS, sizeof(*c.keys));
+	c.samples = calloc(LPM_LOOKUP_KEYS, sizeof(*c.samples));
+	if (!c.prefixes || !c.match || !c.keys || !c.samples) {
+		err = -ENOMEM;
+		goto out;
+	}
+	printf("%-6s %-8s %-6s %-18s %-5s %-8s %-10s %-10s %-10s\n", "FAMILY",
+	       "PREFIXES", "SIDE", "OP", "PLEN", "OPS", "AVG(ns)", "P50(ns)",
+	       "P99(ns)");
+	for (size_t s = 0; !err && s < sizeof(lpm_sizes) / sizeof(__u32); s++) {
+		if (*exiting)
+			break;
+		c.size = lpm_sizes[s];
+		c.skel = lpm_open(c.size);
+		if (!c.skel) {
+			err = -errno;
+			break;
+		}
+		c.keys_fd = bpf_map__fd(c.skel->maps.lpm_lookup_keys);
+		c.base_fd = bpf_program__fd(c.skel->progs.lpm_keys_only);
+		for (int f = 0; !err && f < 2; f++) {
+			c.fam = &lpm_families[f];
+			c.map_fd = bpf_map__fd(f ? c.skel->maps.lpm_v6_map
+			                         : c.skel->maps.lpm_v4_map);
+			c.prog_fd = bpf_program__fd(f ? c.skel->progs.lpm_lookup_v6
+			                              : c.skel->progs.lpm_lookup_v4);
+			err = lpm_run_family(&c, exiting);
+		}
+		lpm_bpf__destroy(c.skel);
+	}
+out:
+	free(c.prefixes);
+	free(c.match);
+	free(c.keys);
+	free(c.samples);
+	return err;
+}
+
+static const struct bench_feature lpm_feats[] = {
+    BENCH_PROG(SCHED_CLS), BENCH_MAP(LPM_TRIE), BENCH_MAP(ARRAY),
+};
+
+BENCH_REGISTER(lpm) = {
+    .name = "lpm",
+    .key = 'l',
+    .doc = "Benchmark LPM trie lookups and churn with realistic prefixes",
+    .feats = lpm_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(lpm_feats),
+    .schema = "family,max_entries,prefixes,map_flags,side,op,prefixlen,ops,avg_ns,"
+              "p50_ns,p99_ns",
+    .run = bench_lpm,
+};
@@ -0,0 +1,418 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Map-in-map indirection benchmark.
+#include "bench_map_in_map.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_timer.h"
+#include "bench_util.h"
+#include "map_in_map.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MIM_ENTRIES 1024
+#define MIM_LOOKUPS 65536
+// 每种配置下替换内层map的次数(外层map更新会等待RCU宽限期，次数不宜过多)
+#define MIM_SWAPS 64
+#define MIM_MAX_READERS 4
+// 内层map占用内存超过该值时跳过该配置
+#define MIM_MEM_LIMIT (256ULL << 20)
+
+static const __u32 mim_inner_counts[] = {1, 8, 64, 512};
+
+struct mim_variant {
+	const char *name;
+	enum bpf_map_type type;
+	bool percpu;
+	struct bpf_map *direct;
+	struct bpf_map *outer[2];
+	struct bpf_program *prog_direct;
+	struct bpf_program *prog_outer[2];
+};
+static const char *mim_outer_names[2] = {"array_of_maps", "hash_of_maps"};
+
+struct mim_ctx {
+	struct map_in_map_bpf *skel;
+	__u32 nr_inner;
+	int nr_cpus;
+	__u64 nop_ns;
+	__u64 *values;
+	int *inner_fds;
+	int spare_fd;
+};
+
+static void mim_print(const struct mim_variant *v, const char *outer,
+                      __u32 nr_inner, bool kernel, const char *op, int readers,
+                      __u32 ops, const struct bench_lat *lat, double delta) {
+	char delta_str[16] = "-";
+
+	if (delta >= 0)
+		snprintf(delta_str, sizeof(delta_str), "%.1f", delta);
+	printf("%-13s %-14s %-8u %-6s %-18s %-8d %-8u %-10.1f ", v->name, outer,
+	       nr_inner, kernel ? "kernel" : "user", op, readers, ops, lat->avg);
+	if (kernel)
+		printf("%-10s %-10s ", "-", "-");
+	else
+		printf("%-10.0f %-10.0f ", lat->p50, lat->p99);
+	printf("%-10s\n", delta_str);
+	fflush(stdout);
+	BENCH_OUTPUT("map_in_map", BF_STR("inner", v->name),
+	             BF_STR("outer", outer), BF_U64("nr_inner", nr_inner),
+	             BF_U64("inner_max_entries", MIM_ENTRIES),
+	             BF_STR("side", kernel ? "kernel" : "user"), BF_STR("op", op),
+	             BF_I64("readers", readers), BF_U64("ops", ops),
+	             BF_F64("avg_ns", lat->avg),
+	             BF_F64("p50_ns", kernel ? NAN : lat->p50),
+	             BF_F64("p99_ns", kernel ? NAN : lat->p99),
+	             BF_F64("delta_ns", delta >= 0 ? delta : NAN));
+}
+
+// 写满 0..MIM_ENTRIES-1，per-CPU map 的值为每个CPU一份
+static int mim_fill(struct mim_ctx *c, int fd) {
+	for (__u32 key = 0; key < MIM_ENTRIES; key++) {
+		if (bpf_map_update_elem(fd, &key, c->values, BPF_ANY)) {
+			fprintf(stderr, "Failed to fill inner map: %d\n", errno);
+			return -errno;
+		}
+	}
+	return 0;
+}
+
+static int mim_create_inner(struct mim_ctx *c, const struct mim_variant *v) {
+	int fd, err;
+
+	fd = bpf_map_create(v->type, NULL, sizeof(__u32), sizeof(__u64),
+	                    MIM_ENTRIES, NULL);
+	if (fd < 0) {
+		fprintf(stderr, "Failed to create %s inner map: %d\n", v->name, fd);
+		return fd;
+	}
+	err = mim_fill(c, fd);
+	if (err) {
+		close(fd);
+		return err;
+	}
+	return fd;
+}
+
+static void mim_close_inner(struct mim_ctx *c) {
+	for (__u32 i = 0; i < c->nr_inner; i++) {
+		if (c->inner_fds[i] >= 0)
+			close(c->inner_fds[i]);
+		c->inner_fds[i] = -1;
+	}
+	if (c->spare_fd >= 0)
+		close(c->spare_fd);
+	c->spare_fd = -1;
+}
+
+// 创建 nr_inner 个内层map(外加一个替换用的备用map)并装入两种外层map
+static int mim_setup_inner(struct mim_ctx *c, const struct mim_variant *v) {
+	int err = 0;
+
+	for (__u32 i = 0; i < c->nr_inner; i++) {
+		c->inner_fds[i] = mim_create_inner(c, v);
+		if (c->inner_fds[i] < 0)
+			return c->inner_fds[i];
+		for (int o = 0; o < 2; o++) {
+			err = bpf_map_update_elem(bpf_map__fd(v->outer[o]), &i,
+			                          &c->inner_fds[i], BPF_ANY);
+			if (err) {
+				fprintf(stderr, "Failed to insert inner map into %s: %d\n",
+				        mim_outer_names[o], err);
+				return err;
+			}
+		}
+	}
+	c->spare_fd = mim_create_inner(c, v);
+	return c->spare_fd < 0 ? c->spare_fd : 0;
+}
+
+static int mim_kernel_lookup(struct mim_ctx *c, struct bpf_program *prog,
+                             __u32 repeat, double *avg) {
+	__u64 ns;
+	int err;
+
+	err = bench_prog_run(bpf_program__fd(prog), repeat, &ns);
+	if (err) {
+		fprintf(stderr, "Failed to run %s: %d\n", bpf_program__name(prog),
+		        err);
+		return err;
+	}
+	*avg = ns > c->nop_ns ? ns - c->nop_ns : 0;
+	return 0;
+}
+
+struct mim_swap_worker {
+	struct mim_ctx *c;
+	struct bpf_program *prog;
+	int outer_fd;
+	bool swapper;
+	volatile bool *done;
+	__u64 *samples;
+	double kern_sum;
+	__u32 kern_runs;
+	int err;
+};
+
+static void *mim_swap_fn(void *arg) {
+	struct mim_swap_worker *w = arg;
+	struct mim_ctx *c = w->c;
+	__u64 start;
+	double ns;
+
+	if (!w->swapper) {
+		do {
+			w->err = mim_kernel_lookup(c, w->prog, MIM_ENTRIES, &ns);
+			w->kern_sum += ns;
+			w->kern_runs++;
+		} while (!w->err && !*w->done);
+		return NULL;
+	}
+	// 轮流把备用map换入外层map，换出的map成为新的备用map
+	for (__u32 i = 0; i < MIM_SWAPS; i++) {
+		__u32 idx = i % c->nr_inner;
+		int old = c->inner_fds[idx];
+
+		start = bench_timer_start();
+		w->err = bpf_map_update_elem(w->outer_fd, &idx, &c->spare_fd, BPF_ANY);
+		w->samples[i] = bench_timer_ns(start, bench_timer_stop());
+		if (w->err)
+			break;
+		c->inner_fds[idx] = c->spare_fd;
+		c->spare_fd = old;
+	}
+	*w->done = true;
+	return NULL;
+}
+
+static int mim_swap(struct mim_ctx *c, const struct mim_variant *v, int o,
+                    int readers) {
+	struct mim_swap_worker workers[MIM_MAX_READERS + 1] = {};
+	__u64 samples[MIM_SWAPS], wall_ns;
+	volatile bool done = false;
+	struct bench_lat lat;
+	char phase[64];
+	double kern_sum = 0;
+	__u32 kern_runs = 0;
+	int err = 0;
+
+	for (int i = 0; i <= readers; i++) {
+		workers[i].c = c;
+		workers[i].prog = v->prog_outer[o];
+		workers[i].outer_fd = bpf_map__fd(v->outer[o]);
+		workers[i].swapper = i == 0;
+		workers[i].done = &done;
+		workers[i].samples = samples;
+	}
+	err = bench_run_threads(readers + 1, mim_swap_fn, workers,
+	                        sizeof(workers[0]), &wall_ns);
+	for (int i = 0; !err && i <= readers; i++) {
+		err = workers[i].err;
+		kern_sum += workers[i].kern_sum;
+		kern_runs += workers[i].kern_runs;
+	}
+	if (err) {
+		fprintf(stderr, "%s %s swap failed: %d\n", v->name,
+		        mim_outer_names[o], err);
+		return err;
+	}
+	snprintf(phase, sizeof(phase), "map_in_map/%s/%s/%u/swap_inner/%d",
+	         v->name, mim_outer_names[o], c->nr_inner, readers);
+	bench_lat_summarize(phase, samples, MIM_SWAPS, &lat);
+	mim_print(v, mim_outer_names[o], c->nr_inner, false, "swap_inner", readers,
+	          MIM_SWAPS, &lat, -1);
+	if (readers) {
+		memset(&lat, 0, sizeof(lat));
+		lat.avg = kern_sum / kern_runs;
+		mim_print(v, mim_outer_names[o], c->nr_inner, true,
+		          "lookup_during_swap", readers, kern_runs * MIM_ENTRIES, &lat,
+		          -1);
+	}
+	return 0;
+}
+
+static int mim_run_variant(struct mim_ctx *c, const struct mim_variant *v) {
+	int nr_readers = c->nr_cpus - 1 < MIM_MAX_READERS ? c->nr_cpus - 1
+	                                                  : MIM_MAX_READERS;
+	__u64 mem = (__u64)(c->nr_inner + 1) * MIM_ENTRIES * sizeof(__u64) *
+	            (v->percpu ? libbpf_num_possible_cpus() : 1);
+	struct bench_lat lat = {};
+	double direct_ns, ns;
+	int err;
+
+	if (mem > MIM_MEM_LIMIT) {
+		printf("# skip %s with %u inner maps: needs %llu MB\n", v->name,
+		       c->nr_inner, mem >> 20);
+		return 0;
+	}
+	err = mim_fill(c, bpf_map__fd(v->direct));
+	if (!err)
+		err = mim_setup_inner(c, v);
+	if (!err)
+		err = mim_kernel_lookup(c, v->prog_direct, MIM_LOOKUPS, &direct_ns);
+	if (err)
+		goto out;
+	lat.avg = direct_ns;
+	mim_print(v, "none", c->nr_inner, true, "lookup", 0, MIM_LOOKUPS, &lat, -1);
+	for (int o = 0; o < 2; o++) {
+		err = mim_kernel_lookup(c, v->prog_outer[o], MIM_LOOKUPS, &ns);
+		if (err)
+			goto out;
+		lat.avg = ns;
+		// DELTA 为两级查找相对直接查找多出的耗时
+		mim_print(v, mim_outer_names[o], c->nr_inner, true, "lookup", 0,
+		          MIM_LOOKUPS, &lat, ns > direct_ns ? ns - direct_ns : 0);
+	}
+	for (int o = 0; !err && o < 2; o++) {
+		err = mim_swap(c, v, o, 0);
+		if (!err && nr_readers > 0)
+			err = mim_swap(c, v, o, nr_readers);
+	}
+out:
+	mim_close_inner(c);
+	return err;
+}
+
+static struct map_in_map_bpf *mim_open(__u32 nr_inner) {
+	static const char *const progs[] = {
+	    "bench_nop",
+	    "mim_direct_hash",
+	    "mim_aom_hash",
+	    "mim_hom_hash",
+	    "mim_direct_array",
+	    "mim_aom_array",
+	    "mim_hom_array",
+	    "mim_direct_percpu_array",
+	    "mim_aom_percpu_array",
+	    "mim_hom_percpu_array",
+	    "mim_direct_percpu_hash",
+	    "mim_aom_percpu_hash",
+	    "mim_hom_percpu_hash",
+	};
+	struct map_in_map_bpf *skel;
+	int err;
+
+	skel = BENCH_SKEL_OPEN(map_in_map);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return NULL;
+	}
+	bench_autoload_only(skel->obj, progs, sizeof(progs) / sizeof(progs[0]));
+	bpf_map__set_max_entries(skel->maps.aom_hash, nr_inner);
+	bpf_map__set_max_entries(skel->maps.aom_array, nr_inner);
+	bpf_map__set_max_entries(skel->maps.aom_percpu_array, nr_inner);
+	bpf_map__set_max_entries(skel->maps.aom_percpu_hash, nr_inner);
+	bpf_map__set_max_entries(skel->maps.hom_hash, nr_inner);
+	bpf_map__set_max_entries(skel->maps.hom_array, nr_inner);
+	bpf_map__set_max_entries(skel->maps.hom_percpu_array, nr_inner);
+	bpf_map__set_max_entries(skel->maps.hom_percpu_hash, nr_inner);
+	skel->data->mim_nr_inner = nr_inner;
+	err = BENCH_SKEL_LOAD(map_in_map, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load map-in-map programs: %d\n", err);
+		map_in_map_bpf__destroy(skel);
+		// 与 libbpf 一致: 返回NULL时错误码在 errno 中
+		errno = -err;
+		return NULL;
+	}
+	return skel;
+}
+
+int bench_map_in_map(volatile bool *exiting) {
+	__u32 max_inner =
+	    mim_inner_counts[sizeof(mim_inner_counts) / sizeof(__u32) - 1];
+	struct mim_ctx c = {.spare_fd = -1};
+	int err = 0;
+
+	c.nr_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	c.values = calloc(libbpf_num_possible_cpus(), sizeof(__u64));
+	c.inner_fds = calloc(max_inner, sizeof(int));
+	if (!c.values || !c.inner_fds) {
+		err = -ENOMEM;
+		goto out;
+	}
+	memset(c.inner_fds, -1, max_inner * sizeof(int));
+	printf("%-13s %-14s %-8s %-6s %-18s %-8s %-8s %-10s %-10s %-10s %-10s\n",
+	       "INNER", "OUTER", "N_INNER", "SIDE", "OP", "READERS", "OPS",
+	       "AVG(ns)", "P50(ns)", "P99(ns)", "DELTA(ns)");
+	for (size_t n = 0; !err && n < sizeof(mim_inner_counts) / sizeof(__u32);
+	     n++) {
+		struct map_in_map_bpf *skel;
+
+		if (*exiting)
+			break;
+		c.nr_inner = mim_inner_counts[n];
+		skel = c.skel = mim_open(c.nr_inner);
+		if (!skel) {
+			err = -errno;
+			break;
+		}
+		err = bench_prog_run(bpf_program__fd(skel->progs.bench_nop),
+		                     MIM_LOOKUPS, &c.nop_ns);
+		if (err)
+			fprintf(stderr, "Failed to run bench_nop: %d\n", err);
+		struct mim_variant variants[] = {
+		    {"hash", BPF_MAP_TYPE_HASH, false, skel->maps.hash_map,
+		     {skel->maps.aom_hash, skel->maps.hom_hash},
+		     skel->progs.mim_direct_hash,
+		     {skel->progs.mim_aom_hash, skel->progs.mim_hom_hash}},
+		    {"array", BPF_MAP_TYPE_ARRAY, false, skel->maps.array_map,
+		     {skel->maps.aom_array, skel->maps.hom_array},
+		     skel->progs.mim_direct_array,
+		     {skel->progs.mim_aom_array, skel->progs.mim_hom_array}},
+		    {"percpu_array", BPF_MAP_TYPE_PERCPU_ARRAY, true,
+		     skel->maps.percpu_array_map,
+		     {skel->maps.aom_percpu_array, skel->maps.hom_percpu_array},
+		     skel->progs.mim_direct_percpu_array,
+		     {skel->progs.mim_aom_percpu_array,
+		      skel->progs.mim_hom_percpu_array}},
+		    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, true,
+		     skel->maps.percpu_hash_map,
+		     {skel->maps.aom_percpu_hash, skel->maps.hom_percpu_hash},
+		     skel->progs.mim_direct_percpu_hash,
+		     {skel->progs.mim_aom_percpu_hash,
+		      skel->progs.mim_hom_percpu_hash}},
+		};
+		for (size_t i = 0;
+		     !err && i < sizeof(variants) / sizeof(variants[0]) && !*exiting;
+		     i++)
+			err = mim_run_variant(&c, &variants[i]);
+		map_in_map_bpf__destroy(skel);
+	}
+out:
+	free(c.values);
+	free(c.inner_fds);
+	return err;
+}
+
+static const struct bench_feature map_in_map_feats[] = {
+    BENCH_PROG(SCHED_CLS),   BENCH_MAP(ARRAY_OF_MAPS), BENCH_MAP(HASH_OF_MAPS),
+    BENCH_MAP(PERCPU_ARRAY), BENCH_MAP(PERCPU_HASH),
+};
+
+BENCH_REGISTER(map_in_map) = {
+    .name = "map_in_map",
+    .key = 'm',
+    .doc = "Benchmark map-in-map double lookup and inner map swaps",
+    .feats = map_in_map_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(map_in_map_feats),
+    .schema = "inner,outer,nr_inner,inner_max_entries,side,op,readers,ops,avg_ns,"
+              "p50_ns,p99_ns,delta_ns",
+    .run = bench_map_in_map,
+};
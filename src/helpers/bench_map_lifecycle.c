@@ -0,0 +1,403 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Map creation and teardown cost benchmark.
+#include "bench_map_lifecycle.h"
+#include "bench_features.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_util.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 每个组合重复的次数，取中位数
+#define ML_RUNS 3
+#define ML_VALUE_SIZE 8
+// 批量填充时每次系统调用写入的条目数
+#define ML_BATCH 4096
+// 估计时每个条目的额外开销(元素头、哈希桶等)
+#define ML_ENTRY_OVERHEAD 64
+// 估计占用超过可用内存的该比例时不创建
+#define ML_MEM_SHARE 4
+// 关闭后轮询 memcg 用量的间隔与超时
+#define ML_POLL_US 1000
+#define ML_FREE_TIMEOUT_NS (30ULL * 1000000000ULL)
+// memcg 按批(64页)预扣用量，回落到基线加该余量以内即视为已释放
+#define ML_MEMCG_SLACK (64LL * 4096)
+// 内核内部的 ENOTSUPP，map类型没有实现批量操作时返回
+#ifndef ENOTSUPP
+#define ENOTSUPP 524
+#endif
+
+static const __u32 ml_entries[] = {1024,    16384,   262144,
+                                   1048576, 4194304, 16777216};
+#define ML_NR_ENTRIES BENCH_ARRAY_SIZE(ml_entries)
+
+struct ml_type {
+	const char *name;
+	int type;
+	__u32 flags;
+	const char *flags_name;
+	__u32 key_size;
+	bool percpu;
+};
+
+static const struct ml_type ml_types[] = {
+    {"hash", BPF_MAP_TYPE_HASH, 0, "-", 8, false},
+    {"hash", BPF_MAP_TYPE_HASH, BPF_F_NO_PREALLOC, "no_prealloc", 8, false},
+    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, 0, "-", 8, true},
+    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, BPF_F_NO_PREALLOC,
+     "no_prealloc", 8, true},
+    {"lru_hash", BPF_MAP_TYPE_LRU_HASH, 0, "-", 8, false},
+    {"lru_hash", BPF_MAP_TYPE_LRU_HASH, BPF_F_NO_COMMON_LRU, "no_common_lru",
+     8, false},
+    {"lru_percpu_hash", BPF_MAP_TYPE_LRU_PERCPU_HASH, 0, "-", 8, true},
+    {"array", BPF_MAP_TYPE_ARRAY, 0, "-", 4, false},
+    {"array", BPF_MAP_TYPE_ARRAY, BPF_F_MMAPABLE, "mmapable", 4, false},
+    {"percpu_array", BPF_MAP_TYPE_PERCPU_ARRAY, 0, "-", 4, true},
+};
+
+// 一次创建-填满-关闭的各阶段耗时(ns)
+struct ml_sample {
+	__u64 create_ns;
+	__u64 fill_ns;
+	__u64 close_ns;
+	// 从 close 到 memcg 用量回落的耗时，memcg 不可用或超时为0
+	__u64 free_ns;
+	long long memcg_bytes;
+	bool batch;
+};
+
+// 批量填充用的 key 与 value 缓冲区，每CPU map的 value 每个CPU一份
+struct ml_buf {
+	void *keys;
+	void *values;
+};
+
+static void ml_fill_keys(const struct ml_type *t, void *keys, __u32 start,
+                         __u32 nr) {
+	for (__u32 i = 0; i < nr; i++) {
+		if (t->key_size == 4)
+			((__u32 *)keys)[i] = start + i;
+		else
+			((__u64 *)keys)[i] = start + i;
+	}
+}
+
+// 按重启后用户态重新灌入数据的方式把map写满: 优先使用批量更新，
+// 内核不支持该map类型的批量操作时逐条更新
+static int ml_fill(const struct ml_type *t, int fd, __u32 entries,
+                   const struct ml_buf *buf, size_t value_bytes, bool *batch,
+                   volatile bool *exiting) {
+	LIBBPF_OPTS(bpf_map_batch_opts, opts);
+	__u32 i = 0, nr, count;
+	int err;
+
+	*batch = true;
+	while (i < entries && !*exiting) {
+		nr = entries - i < ML_BATCH ? entries - i : ML_BATCH;
+		ml_fill_keys(t, buf->keys, i, nr);
+		if (*batch) {
+			count = nr;
+			err = bpf_map_update_batch(fd, buf->keys, buf->values, &count,
+			                           &opts);
+			if (err && i == 0 && count == 0 &&
+			    (err == -EINVAL || err == -EOPNOTSUPP || err == -ENOTSUPP)) {
+				*batch = false;
+				continue;
+			}
+			if (err)
+				return err;
+		} else {
+			for (__u32 j = 0; j < nr; j++) {
+				err = bpf_map_update_elem(
+				    fd, (char *)buf->keys + (size_t)j * t->key_size,
+				    (char *)buf->values + j * value_bytes, BPF_ANY);
+				if (err)
+					return err;
+			}
+		}
+		i += nr;
+	}
+	return 0;
+}
+
+// 关闭后等待 memcg 用量回落到创建前的基线附近，返回从 close 开始的
+// 耗时；memcg 不可用或超时返回0
+static __u64 ml_wait_freed(long long before, long long filled, __u64 start) {
+	long long slack, usage;
+	__u64 now;
+
+	if (before < 0 || filled < 0)
+		return 0;
+	slack = (filled - before) / 16;
+	if (slack < ML_MEMCG_SLACK)
+		slack = ML_MEMCG_SLACK;
+	for (;;) {
+		usage = bench_memcg_usage();
+		now = bench_now_ns();
+		if (usage >= 0 && usage <= before + slack)
+			return now - start;
+		if (usage < 0 || now - start > ML_FREE_TIMEOUT_NS)
+			return 0;
+		usleep(ML_POLL_US);
+	}
+}
+
+static int ml_run_once(const struct ml_type *t, __u32 entries,
+                       const struct ml_buf *buf, size_t value_bytes,
+                       struct ml_sample *s, volatile bool *exiting) {
+	LIBBPF_OPTS(bpf_map_create_opts, opts, .map_flags = t->flags);
+	long long before, filled;
+	__u64 start;
+	int fd, err;
+
+	// 上一个map的延迟释放不能计入本次
+	bench_memcg_settle();
+	before = bench_memcg_usage();
+	start = bench_now_ns();
+	fd = bpf_map_create(t->type, "ml_map", t->key_size, ML_VALUE_SIZE,
+	                    entries, &opts);
+	s->create_ns = bench_now_ns() - start;
+	if (fd < 0)
+		return fd;
+	start = bench_now_ns();
+	err = ml_fill(t, fd, entries, buf, value_bytes, &s->batch, exiting);
+	s->fill_ns = bench_now_ns() - start;
+	filled = bench_memcg_usage();
+	s->memcg_bytes = before >= 0 && filled >= 0 ? filled - before : -1;
+	start = bench_now_ns();
+	close(fd);
+	s->close_ns = bench_now_ns() - start;
+	s->free_ns = ml_wait_freed(before, filled, start);
+	return err;
+}
+
+static void ml_print_status(const struct ml_type *t, __u32 entries,
+                            const char *status, const char *detail) {
+	printf("%-15s %-13s %-9u %s\n", t->name, t->flags_name, entries, detail);
+	BENCH_OUTPUT("map_lifecycle", BF_STR("map_type", t->name),
+	             BF_STR("map_flags", t->flags_name),
+	             BF_U64("max_entries", entries),
+	             BF_U64("key_size", t->key_size),
+	             BF_U64("value_size", ML_VALUE_SIZE), BF_STR("status", status));
+}
+
+// 各阶段在不同容量下的中位耗时，用于拟合
+struct ml_curve {
+	double x[ML_NR_ENTRIES];
+	double create[ML_NR_ENTRIES];
+	double fill[ML_NR_ENTRIES];
+	double free[ML_NR_ENTRIES];
+	int nr;
+};
+
+// 测量一个容量，跳过或失败的组合只打印一行，被中断时返回1
+static int ml_run_size(const struct ml_type *t, __u32 entries, int nr_cpus,
+                       __u64 mem_cap, const struct ml_buf *buf,
+                       struct ml_curve *curve, volatile bool *exiting) {
+	__u64 create[ML_RUNS], fill[ML_RUNS], closing[ML_RUNS], freeing[ML_RUNS];
+	struct bench_lat create_lat, fill_lat, close_lat, free_lat;
+	size_t value_bytes = (size_t)ML_VALUE_SIZE * (t->percpu ? nr_cpus : 1);
+	struct ml_sample s = {};
+	long long memcg_bytes = -1;
+	char phase[96], detail[64];
+	int nr = 0, nr_freed = 0, err = 0;
+	double free_ms;
+	__u64 estimate;
+
+	estimate = (__u64)entries * (t->key_size + ML_ENTRY_OVERHEAD + value_bytes);
+	if (mem_cap && estimate > mem_cap) {
+		snprintf(detail, sizeof(detail), "skipped, about %llu MB",
+		         (unsigned long long)estimate >> 20);
+		ml_print_status(t, entries, "skipped", detail);
+		return 0;
+	}
+	for (int i = 0; i < ML_RUNS && !*exiting; i++) {
+		err = ml_run_once(t, entries, buf, value_bytes, &s, exiting);
+		if (err)
+			break;
+		create[nr] = s.create_ns;
+		fill[nr] = s.fill_ns;
+		closing[nr++] = s.close_ns;
+		if (s.free_ns)
+			freeing[nr_freed++] = s.free_ns;
+		memcg_bytes = s.memcg_bytes;
+	}
+	if (err) {
+		snprintf(detail, sizeof(detail), "failed: %d", err);
+		ml_print_status(t, entries, "failed", detail);
+		return 0;
+	}
+	if (*exiting || !nr)
+		return 1;
+
+	snprintf(phase, sizeof(phase), "map_lifecycle/%s/%s/%u/create", t->name,
+	         t->flags_name, entries);
+	bench_lat_summarize(phase, create, nr, &create_lat);
+	snprintf(phase, sizeof(phase), "map_lifecycle/%s/%s/%u/fill", t->name,
+	         t->flags_name, entries);
+	bench_lat_summarize(phase, fill, nr, &fill_lat);
+	bench_lat_summarize(NULL, closing, nr, &close_lat);
+	bench_lat_summarize(NULL, freeing, nr_freed, &free_lat);
+	// 任一次没有观察到释放时不给出释放耗时
+	free_ms = nr_freed == nr ? free_lat.p50 / 1e6 : NAN;
+
+	curve->x[curve->nr] = entries;
+	curve->create[curve->nr] = create_lat.p50;
+	curve->fill[curve->nr] = fill_lat.p50;
+	curve->free[curve->nr++] = free_ms * 1e6;
+	printf("%-15s %-13s %-9u %-11.3f %-7.1f %-11.3f %-7.1f %-6s %-10.1f "
+	       "%-10.3f %-10.1f\n",
+	       t->name, t->flags_name, entries, create_lat.p50 / 1e6,
+	       create_lat.p50 / entries, fill_lat.p50 / 1e6, fill_lat.p50 / entries,
+	       s.batch ? "batch" : "elem", close_lat.p50 / 1e3, free_ms,
+	       memcg_bytes < 0 ? NAN : memcg_bytes / 1048576.0);
+	fflush(stdout);
+	BENCH_OUTPUT("map_lifecycle", BF_STR("map_type", t->name),
+	             BF_STR("map_flags", t->flags_name),
+	             BF_U64("max_entries", entries),
+	             BF_U64("key_size", t->key_size),
+	             BF_U64("value_size", ML_VALUE_SIZE), BF_STR("status", "ok"),
+	             BF_U64("runs", nr),
+	             BF_STR("fill_method", s.batch ? "batch" : "elem"),
+	             BF_F64("create_ns", create_lat.p50),
+	             BF_F64("create_ns_per_entry", create_lat.p50 / entries),
+	             BF_F64("fill_ns", fill_lat.p50),
+	             BF_F64("fill_ns_per_entry", fill_lat.p50 / entries),
+	             BF_F64("close_ns", close_lat.p50),
+	             BF_F64("free_ns", free_ms * 1e6),
+	             BF_I64("memcg_bytes", memcg_bytes));
+	return 0;
+}
+
+// 加权最小二乘拟合 y = fixed + slope * x，按相对误差加权(权重 1/y^2)，
+// 避免最大容量的点主导固定开销；有效点少于两个时为NAN
+static void ml_fit(const double *x, const double *y, int nr, double *fixed,
+                   double *slope) {
+	double sw = 0, sx = 0, sy = 0, sxx = 0, sxy = 0, w, d;
+	int n = 0;
+
+	for (int i = 0; i < nr; i++) {
+		if (isnan(y[i]) || y[i] <= 0)
+			continue;
+		w = 1 / (y[i] * y[i]);
+		sw += w;
+		sx += w * x[i];
+		sy += w * y[i];
+		sxx += w * x[i] * x[i];
+		sxy += w * x[i] * y[i];
+		n++;
+	}
+	d = sw * sxx - sx * sx;
+	if (n < 2 || d == 0) {
+		*fixed = *slope = NAN;
+		return;
+	}
+	*slope = (sw * sxy - sx * sy) / d;
+	*fixed = (sy - *slope * sx) / sw;
+}
+
+static void ml_print_fit(const struct ml_type *t, const struct ml_curve *c) {
+	static const char *const phases[] = {"create", "fill", "free"};
+	const double *ys[] = {c->create, c->fill, c->free};
+	double fixed, slope;
+
+	for (int p = 0; p < BENCH_ARRAY_SIZE(phases); p++) {
+		ml_fit(c->x, ys[p], c->nr, &fixed, &slope);
+		if (isnan(slope))
+			continue;
+		printf("%-15s %-13s fit %-6s = %.1f us + %.2f ns/entry\n", t->name,
+		       t->flags_name, phases[p], fixed / 1e3, slope);
+		BENCH_OUTPUT("map_lifecycle", BF_STR("map_type", t->name),
+		             BF_STR("map_flags", t->flags_name),
+		             BF_U64("key_size", t->key_size),
+		             BF_U64("value_size", ML_VALUE_SIZE),
+		             BF_STR("status", "fit"), BF_STR("phase", phases[p]),
+		             BF_F64("fixed_ns", fixed),
+		             BF_F64("slope_ns_per_entry", slope));
+	}
+}
+
+int bench_map_lifecycle(volatile bool *exiting) {
+	int nr_cpus = libbpf_num_possible_cpus();
+	__u64 mem_cap = bench_mem_available() / ML_MEM_SHARE;
+	struct ml_buf buf;
+	size_t value_bytes;
+
+	if (nr_cpus < 0) {
+		fprintf(stderr, "Failed to get possible CPUs: %d\n", nr_cpus);
+		return nr_cpus;
+	}
+	value_bytes = (size_t)ML_VALUE_SIZE * nr_cpus;
+	buf.keys = calloc(ML_BATCH, sizeof(__u64));
+	buf.values = malloc(ML_BATCH * value_bytes);
+	if (!buf.keys || !buf.values) {
+		free(buf.keys);
+		free(buf.values);
+		return -ENOMEM;
+	}
+	// 提前触碰，避免用户态缺页计入 memcg 的差值
+	memset(buf.values, 0x5a, ML_BATCH * value_bytes);
+
+	printf("possible CPUs: %d, memory cap: %llu MB, memcg: %s\n", nr_cpus,
+	       (unsigned long long)mem_cap >> 20,
+	       bench_memcg_path() ? bench_memcg_path() : "unavailable");
+	printf("%-15s %-13s %-9s %-11s %-7s %-11s %-7s %-6s %-10s %-10s %-10s\n",
+	       "TYPE", "FLAGS", "ENTRIES", "CREATE(ms)", "NS/E", "FILL(ms)",
+	       "NS/E", "METHOD", "CLOSE(us)", "FREE(ms)", "MEMCG(MB)");
+	for (int i = 0; !*exiting && i < BENCH_ARRAY_SIZE(ml_types); i++) {
+		const struct ml_type *t = &ml_types[i];
+		struct ml_curve curve = {};
+
+		if (!bench_map_type_supported(t->type)) {
+			printf("%-15s %-13s unsupported by running kernel\n", t->name,
+			       t->flags_name);
+			continue;
+		}
+		for (int e = 0; e < ML_NR_ENTRIES; e++) {
+			if (ml_run_size(t, ml_entries[e], nr_cpus, mem_cap, &buf, &curve,
+			                exiting))
+				break;
+		}
+		if (!*exiting)
+			ml_print_fit(t, &curve);
+	}
+	free(buf.keys);
+	free(buf.values);
+	return 0;
+}
+
+// 各map类型不支持时由基准测试自身逐行跳过
+static const struct bench_feature map_lifecycle_feats[] = {
+    BENCH_MAP(HASH),
+    BENCH_MAP(ARRAY),
+};
+
+BENCH_REGISTER(map_lifecycle) = {
+    .name = "map_lifecycle",
+    .key = 'K',
+    .doc = "Time map create, first fill, close and deferred free from 1K to "
+           "16M entries",
+    .feats = map_lifecycle_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(map_lifecycle_feats),
+    .schema = "map_type,map_flags,max_entries,key_size,value_size,status,runs,"
+              "fill_method,create_ns,create_ns_per_entry,fill_ns,"
+              "fill_ns_per_entry,close_ns,free_ns,memcg_bytes,phase,fixed_ns,"
+              "slope_ns_per_entry",
+    .run = bench_map_lifecycle,
+};
@@ -0,0 +1,299 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Per-map memory footprint benchmark.
+#include "bench_map_memory.h"
+#include "bench_features.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_util.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 估计占用超过该值的组合不创建，避免在CPU很多的主机上耗尽内存
+#define MM_MAX_BYTES (1ULL << 30)
+// 估计时每个条目的额外开销(元素头、哈希桶等)
+#define MM_ENTRY_OVERHEAD 64
+
+// 最大的 value 大小，已按8字节对齐
+#define MM_VALUE_MAX 64
+
+static const __u32 mm_entries[] = {1024, 16384, 262144};
+static const __u32 mm_value_sizes[] = {8, MM_VALUE_MAX};
+
+// 填充方式
+enum mm_fill {
+	MM_FILL_KEYED, // 8字节key
+	MM_FILL_ARRAY, // 4字节下标
+	MM_FILL_PUSH,  // 无key，push value
+	MM_FILL_LPM,   // /32 前缀
+};
+
+struct mm_type {
+	const char *name;
+	int type;
+	__u32 flags;
+	const char *flags_name;
+	__u32 key_size;
+	bool percpu;
+	enum mm_fill fill;
+	// 布隆过滤器的哈希函数个数
+	__u64 map_extra;
+	// 每CPU map对应的普通map(同样的标志)，用来扣除不随CPU数增长的部分
+	const char *base;
+};
+
+static const struct mm_type mm_types[] = {
+    {"hash", BPF_MAP_TYPE_HASH, 0, "-", 8, false, MM_FILL_KEYED, 0},
+    {"hash", BPF_MAP_TYPE_HASH, BPF_F_NO_PREALLOC, "no_prealloc", 8, false,
+     MM_FILL_KEYED, 0},
+    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, 0, "-", 8, true, MM_FILL_KEYED,
+     0, "hash"},
+    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, BPF_F_NO_PREALLOC,
+     "no_prealloc", 8, true, MM_FILL_KEYED, 0, "hash"},
+    {"lru_hash", BPF_MAP_TYPE_LRU_HASH, 0, "-", 8, false, MM_FILL_KEYED, 0},
+    {"lru_hash", BPF_MAP_TYPE_LRU_HASH, BPF_F_NO_COMMON_LRU, "no_common_lru",
+     8, false, MM_FILL_KEYED, 0},
+    {"lru_percpu_hash", BPF_MAP_TYPE_LRU_PERCPU_HASH, 0, "-", 8, true,
+     MM_FILL_KEYED, 0, "lru_hash"},
+    {"array", BPF_MAP_TYPE_ARRAY, 0, "-", 4, false, MM_FILL_ARRAY, 0},
+    {"array", BPF_MAP_TYPE_ARRAY, BPF_F_MMAPABLE, "mmapable", 4, false,
+     MM_FILL_ARRAY, 0},
+    {"percpu_array", BPF_MAP_TYPE_PERCPU_ARRAY, 0, "-", 4, true,
+     MM_FILL_ARRAY, 0, "array"},
+    {"lpm_trie", BPF_MAP_TYPE_LPM_TRIE, BPF_F_NO_PREALLOC, "no_prealloc", 8,
+     false, MM_FILL_LPM, 0},
+    {"bloom_filter", BPF_MAP_TYPE_BLOOM_FILTER, 0, "-", 0, false, MM_FILL_PUSH,
+     5},
+    {"queue", BPF_MAP_TYPE_QUEUE, 0, "-", 0, false, MM_FILL_PUSH, 0},
+    {"stack", BPF_MAP_TYPE_STACK, 0, "-", 0, false, MM_FILL_PUSH, 0},
+};
+
+// 已测量组合填满后的每条目 memlock，普通map排在对应的每CPU map之前
+static struct mm_result {
+	const struct mm_type *t;
+	__u32 entries;
+	__u32 value_size;
+	double per_entry;
+} mm_results[BENCH_ARRAY_SIZE(mm_types) * BENCH_ARRAY_SIZE(mm_entries) *
+             BENCH_ARRAY_SIZE(mm_value_sizes)];
+static int mm_nr_results;
+
+// 同样标志、容量与 value 大小的普通map的每条目字节数，没有时为NAN
+static double mm_base_per_entry(const struct mm_type *t, __u32 entries,
+                                __u32 value_size) {
+	for (int i = 0; t->base && i < mm_nr_results; i++) {
+		const struct mm_result *r = &mm_results[i];
+
+		if (strcmp(r->t->name, t->base) == 0 &&
+		    strcmp(r->t->flags_name, t->flags_name) == 0 &&
+		    r->entries == entries && r->value_size == value_size)
+			return r->per_entry;
+	}
+	return NAN;
+}
+
+static int mm_fill(const struct mm_type *t, int fd, __u32 entries,
+                   const void *value, volatile bool *exiting) {
+	struct {
+		__u32 prefixlen;
+		__u32 addr;
+	} lpm_key;
+	__u32 idx;
+	__u64 key;
+	int err = 0;
+
+	for (__u32 i = 0; i < entries && !err && !*exiting; i++) {
+		switch (t->fill) {
+		case MM_FILL_KEYED:
+			key = i;
+			err = bpf_map_update_elem(fd, &key, value, BPF_NOEXIST);
+			break;
+		case MM_FILL_ARRAY:
+			idx = i;
+			err = bpf_map_update_elem(fd, &idx, value, BPF_ANY);
+			break;
+		case MM_FILL_PUSH:
+			err = bpf_map_update_elem(fd, NULL, value, BPF_ANY);
+			break;
+		case MM_FILL_LPM:
+			lpm_key.prefixlen = 32;
+			lpm_key.addr = i;
+			err = bpf_map_update_elem(fd, &lpm_key, value, BPF_NOEXIST);
+			break;
+		}
+	}
+	return err;
+}
+
+// 两次读数之差，任一不可用时为NAN
+static double mm_delta(long long before, long long after) {
+	return before < 0 || after < 0 ? NAN : (double)(after - before);
+}
+
+static void mm_print_failed(const struct mm_type *t, __u32 entries,
+                            __u32 value_size, const char *step, int err) {
+	char status[32];
+
+	printf("%-15s %-13s %-8u %-6u failed to %s: %d\n", t->name, t->flags_name,
+	       entries, value_size, step, err);
+	snprintf(status, sizeof(status), "%s_failed", step);
+	BENCH_OUTPUT("map_memory", BF_STR("map_type", t->name),
+	             BF_STR("map_flags", t->flags_name),
+	             BF_U64("max_entries", entries),
+	             BF_U64("key_size", t->key_size),
+	             BF_U64("value_size", value_size), BF_STR("status", status));
+}
+
+static int mm_run_one(const struct mm_type *t, __u32 entries,
+                      __u32 value_size, int nr_cpus, const void *value,
+                      volatile bool *exiting) {
+	LIBBPF_OPTS(bpf_map_create_opts, opts, .map_flags = t->flags,
+	            .map_extra = t->map_extra);
+	long long memcg_before, memcg_created, memcg_filled;
+	long long memlock, memlock_filled, map_extra;
+	double created, filled, per_entry, memcg_per_entry, base, per_cpu;
+	__u64 estimate;
+	int fd, err;
+
+	estimate = (__u64)entries * (t->key_size + MM_ENTRY_OVERHEAD +
+	                             (__u64)value_size * (t->percpu ? nr_cpus : 1));
+	if (estimate > MM_MAX_BYTES) {
+		printf("%-15s %-13s %-8u %-6u skipped, about %llu MB\n", t->name,
+		       t->flags_name, entries, value_size,
+		       (unsigned long long)estimate >> 20);
+		return 0;
+	}
+
+	bench_memcg_settle();
+	memcg_before = bench_memcg_usage();
+	fd = bpf_map_create(t->type, "mm_map", t->key_size, value_size, entries,
+	                    &opts);
+	if (fd < 0) {
+		mm_print_failed(t, entries, value_size, "create", fd);
+		return 0;
+	}
+	memcg_created = bench_memcg_usage();
+	memlock = bench_map_memlock(fd);
+	map_extra = bench_fdinfo_field(fd, "map_extra");
+	err = mm_fill(t, fd, entries, value, exiting);
+	memcg_filled = bench_memcg_usage();
+	memlock_filled = bench_map_memlock(fd);
+	close(fd);
+	// 内存不足等原因填不满时记录失败，继续测量其他组合
+	if (err) {
+		mm_print_failed(t, entries, value_size, "fill", err);
+		return 0;
+	}
+	// 被中断时map没有填满，不输出
+	if (*exiting)
+		return 0;
+
+	created = mm_delta(memcg_before, memcg_created);
+	filled = mm_delta(memcg_created, memcg_filled);
+	per_entry = memlock_filled >= 0 ? (double)memlock_filled / entries : NAN;
+	memcg_per_entry = mm_delta(memcg_before, memcg_filled) / entries;
+	if (!t->percpu && mm_nr_results < BENCH_ARRAY_SIZE(mm_results))
+		mm_results[mm_nr_results++] = (struct mm_result){
+		    t, entries, value_size, per_entry};
+	// 每CPU map比普通map多出 value_size*(CPU数-1) 左右，元素头、key和桶
+	// 不随CPU数增长: 外推到 N 个CPU时每条目约为 base + per_cpu*(N-1)
+	base = t->percpu ? mm_base_per_entry(t, entries, value_size) : NAN;
+	per_cpu = nr_cpus > 1 ? (per_entry - base) / (nr_cpus - 1) : NAN;
+	printf("%-15s %-13s %-8u %-6u %-11.1f %-11.1f %-9.1f %-10.1f %-10.1f "
+	       "%-9.1f\n",
+	       t->name, t->flags_name, entries, value_size, memlock / 1024.0,
+	       memlock_filled / 1024.0, per_entry, created / 1024, filled / 1024,
+	       memcg_per_entry);
+	fflush(stdout);
+	BENCH_OUTPUT("map_memory", BF_STR("map_type", t->name),
+	             BF_STR("map_flags", t->flags_name),
+	             BF_U64("max_entries", entries),
+	             BF_U64("key_size", t->key_size),
+	             BF_U64("value_size", value_size), BF_STR("status", "ok"),
+	             BF_I64("map_extra", map_extra),
+	             BF_I64("memlock_bytes", memlock),
+	             BF_I64("memlock_filled_bytes", memlock_filled),
+	             BF_F64("memlock_per_entry", per_entry),
+	             BF_F64("memcg_create_bytes", created),
+	             BF_F64("memcg_fill_bytes", filled),
+	             BF_F64("memcg_per_entry", memcg_per_entry),
+	             BF_F64("base_per_entry", base),
+	             BF_F64("per_cpu_per_entry", per_cpu));
+	return 0;
+}
+
+int bench_map_memory(volatile bool *exiting) {
+	int nr_cpus = libbpf_num_possible_cpus();
+	size_t value_bytes;
+	void *value;
+	int err = 0;
+
+	if (nr_cpus < 0) {
+		fprintf(stderr, "Failed to get possible CPUs: %d\n", nr_cpus);
+		return nr_cpus;
+	}
+	// 每CPU map的 value 每个CPU一份；提前分配并触碰，
+	// 避免用户态缺页计入 memcg 的差值
+	value_bytes = (size_t)MM_VALUE_MAX * nr_cpus;
+	value = malloc(value_bytes);
+	if (!value)
+		return -ENOMEM;
+	memset(value, 0x5a, value_bytes);
+	mm_nr_results = 0;
+
+	printf("possible CPUs: %d, memcg: %s\n", nr_cpus,
+	       bench_memcg_path() ? bench_memcg_path() : "unavailable");
+	printf("%-15s %-13s %-8s %-6s %-11s %-11s %-9s %-10s %-10s %-9s\n",
+	       "TYPE", "FLAGS", "ENTRIES", "VALUE", "MEMLOCK(KB)", "FILLED(KB)",
+	       "B/ENTRY", "MEMCG+(KB)", "FILL+(KB)", "MEMCG B/E");
+	for (int t = 0; !err && !*exiting && t < BENCH_ARRAY_SIZE(mm_types); t++) {
+		const struct mm_type *type = &mm_types[t];
+
+		if (!bench_map_type_supported(type->type)) {
+			printf("%-15s %-13s unsupported by running kernel\n", type->name,
+			       type->flags_name);
+			continue;
+		}
+		for (int e = 0; !err && e < BENCH_ARRAY_SIZE(mm_entries); e++) {
+			for (int v = 0; !err && v < BENCH_ARRAY_SIZE(mm_value_sizes); v++)
+				err = mm_run_one(type, mm_entries[e], mm_value_sizes[v],
+				                 nr_cpus, value, exiting);
+		}
+	}
+	free(value);
+	return err;
+}
+
+// 各map类型不支持时由基准测试自身逐行跳过
+static const struct bench_feature map_memory_feats[] = {
+    BENCH_MAP(HASH),
+    BENCH_MAP(ARRAY),
+};
+
+BENCH_REGISTER(map_memory) = {
+    .name = "map_memory",
+    .key = 'M',
+    .doc = "Measure memlock and memcg footprint per map type, flags and size",
+    .feats = map_memory_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(map_memory_feats),
+    .schema = "map_type,map_flags,max_entries,key_size,value_size,status,"
+              "map_extra,memlock_bytes,memlock_filled_bytes,memlock_per_entry,"
+              "memcg_create_bytes,memcg_fill_bytes,memcg_per_entry,"
+              "base_per_entry,per_cpu_per_entry",
+    .run = bench_map_memory,
+};
@@ -0,0 +1,407 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Full-map scan benchmark.
+#define _GNU_SOURCE
+#include "bench_map_scan.h"
+#include "bench_features.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_util.h"
+#include "map_scan.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// 每种遍历方式计时的次数(另有一次预热)，取中位数
+#define MS_RUNS 5
+#define MS_VALUE_SIZE 8
+// lookup_batch 每次系统调用取回的条目数
+#define MS_BATCH 4096
+// 每次 read() 迭代器 fd 的缓冲区大小
+#define MS_READ_BUF (64 * 1024)
+// 估计时每个条目的额外开销(元素头、哈希桶等)
+#define MS_ENTRY_OVERHEAD 64
+// 估计占用超过可用内存的该比例时不创建
+#define MS_MEM_SHARE 4
+
+static const __u32 ms_capacities[] = {16384, 262144, 1048576};
+// hash 类map的填充率，array 类map总是满的
+static const int ms_fill_pcts[] = {10, 50, 100};
+
+struct ms_type {
+	const char *name;
+	int type;
+	__u32 key_size;
+	bool percpu;
+	// array 类map的条目个数固定为容量
+	bool keyed;
+};
+
+static const struct ms_type ms_types[] = {
+    {"hash", BPF_MAP_TYPE_HASH, 8, false, true},
+    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, 8, true, true},
+    {"lru_hash", BPF_MAP_TYPE_LRU_HASH, 8, false, true},
+    {"array", BPF_MAP_TYPE_ARRAY, 4, false, false},
+    {"percpu_array", BPF_MAP_TYPE_PERCPU_ARRAY, 4, true, false},
+};
+
+enum ms_method {
+	MS_GET_NEXT_KEY,
+	MS_LOOKUP_BATCH,
+	MS_BPF_ITER,
+	MS_NR_METHODS,
+};
+
+static const char *const ms_method_names[] = {
+    [MS_GET_NEXT_KEY] = "get_next_key",
+    [MS_LOOKUP_BATCH] = "lookup_batch",
+    [MS_BPF_ITER] = "bpf_iter",
+};
+
+// 一个被遍历的map及各遍历方式所需的缓冲区
+struct ms_ctx {
+	const struct ms_type *t;
+	int fd;
+	size_t value_bytes;
+	void *keys;
+	void *values;
+	char *buf;
+	// 附加到该map的迭代器，内核不支持时为NULL
+	struct bpf_link *link;
+};
+
+// 遍历函数返回遍历到的条目数，失败返回负的错误码
+static long long ms_scan_get_next_key(struct ms_ctx *c) {
+	__u64 key, next, *prev = NULL;
+	long long nr = 0;
+	int err;
+
+	// 导出程序的常见写法: 逐个取下一个key再查value，每个条目两次系统调用
+	while (!(err = bpf_map_get_next_key(c->fd, prev, &next))) {
+		err = bpf_map_lookup_elem(c->fd, &next, c->values);
+		if (err)
+			return err;
+		nr++;
+		key = next;
+		prev = &key;
+	}
+	return err == -ENOENT ? nr : err;
+}
+
+static long long ms_scan_lookup_batch(struct ms_ctx *c) {
+	LIBBPF_OPTS(bpf_map_batch_opts, opts);
+	__u64 in_batch, out_batch;
+	long long nr = 0;
+	__u32 count;
+	int err;
+
+	// 遍历结束时返回 -ENOENT，count 为最后一批的条目数
+	do {
+		count = MS_BATCH;
+		err = bpf_map_lookup_batch(c->fd, nr ? &in_batch : NULL, &out_batch,
+		                           c->keys, c->values, &count, &opts);
+		nr += count;
+		in_batch = out_batch;
+	} while (!err && count);
+	return !err || err == -ENOENT ? nr : err;
+}
+
+static long long ms_scan_bpf_iter(struct ms_ctx *c) {
+	long long bytes = 0;
+	ssize_t len;
+	int fd, err = 0;
+
+	// 每次遍历从同一个链接创建新的迭代器，读到文件末尾为止
+	fd = bpf_iter_create(bpf_link__fd(c->link));
+	if (fd < 0)
+		return fd;
+	while ((len = read(fd, c->buf, MS_READ_BUF)) > 0)
+		bytes += len;
+	if (len < 0)
+		err = -errno;
+	close(fd);
+	return err ? err : bytes / (long long)(c->t->key_size + c->value_bytes);
+}
+
+static long long ms_scan(struct ms_ctx *c, enum ms_method m) {
+	switch (m) {
+	case MS_GET_NEXT_KEY:
+		return ms_scan_get_next_key(c);
+	case MS_LOOKUP_BATCH:
+		return ms_scan_lookup_batch(c);
+	case MS_BPF_ITER:
+		return ms_scan_bpf_iter(c);
+	default:
+		return -EINVAL;
+	}
+}
+
+static __u64 ms_thread_cpu_ns(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static __u64 ms_thread_sys_ns(void) {
+	struct rusage ru;
+
+	getrusage(RUSAGE_THREAD, &ru);
+	return (__u64)ru.ru_stime.tv_sec * 1000000000ULL +
+	       ru.ru_stime.tv_usec * 1000ULL;
+}
+
+static void ms_print_status(const struct ms_type *t, __u32 capacity,
+                            int fill_pct, enum ms_method m, const char *status,
+                            const char *detail) {
+	printf("%-13s %-9u %-5d %-13s %s\n", t->name, capacity, fill_pct,
+	       ms_method_names[m], detail);
+	BENCH_OUTPUT("map_scan", BF_STR("map_type", t->name),
+	             BF_U64("max_entries", capacity), BF_U64("fill_pct", fill_pct),
+	             BF_STR("method", ms_method_names[m]), BF_STR("status", status),
+	             BF_U64("key_size", t->key_size),
+	             BF_U64("value_size", MS_VALUE_SIZE));
+}
+
+// 用一种方式反复遍历，expected 为 get_next_key 遍历到的条目数，
+// 各方式结果不一致时记为 mismatch
+static void ms_run_method(struct ms_ctx *c, __u32 capacity, int fill_pct,
+                          enum ms_method m, long long *expected) {
+	__u64 wall[MS_RUNS], cpu[MS_RUNS], start, cpu_start, sys_start, sys_ns;
+	struct bench_lat wall_lat, cpu_lat;
+	const struct ms_type *t = c->t;
+	__u64 cpu_total = 0;
+	long long nr = 0;
+	char phase[96], detail[64];
+	double sys_pct;
+
+	if (m == MS_BPF_ITER && !c->link) {
+		ms_print_status(t, capacity, fill_pct, m, "unsupported",
+		                "map element iterator unavailable");
+		return;
+	}
+	nr = ms_scan(c, m);
+	sys_start = ms_thread_sys_ns();
+	for (int i = 0; nr >= 0 && i < MS_RUNS; i++) {
+		start = bench_now_ns();
+		cpu_start = ms_thread_cpu_ns();
+		nr = ms_scan(c, m);
+		cpu[i] = ms_thread_cpu_ns() - cpu_start;
+		wall[i] = bench_now_ns() - start;
+		cpu_total += cpu[i];
+	}
+	sys_ns = ms_thread_sys_ns() - sys_start;
+	if (nr < 0) {
+		snprintf(detail, sizeof(detail), "failed: %lld", nr);
+		ms_print_status(t, capacity, fill_pct, m, "failed", detail);
+		return;
+	}
+	if (*expected < 0)
+		*expected = nr;
+	if (nr != *expected) {
+		snprintf(detail, sizeof(detail), "scanned %lld of %lld entries", nr,
+		         *expected);
+		ms_print_status(t, capacity, fill_pct, m, "mismatch", detail);
+		return;
+	}
+
+	snprintf(phase, sizeof(phase), "map_scan/%s/%u/%d/%s", t->name, capacity,
+	         fill_pct, ms_method_names[m]);
+	bench_lat_summarize(phase, wall, MS_RUNS, &wall_lat);
+	bench_lat_summarize(NULL, cpu, MS_RUNS, &cpu_lat);
+	// rusage 的精度为微秒，只给出整体比例
+	sys_pct = cpu_total ? 100.0 * sys_ns / cpu_total : NAN;
+	if (sys_pct > 100)
+		sys_pct = 100;
+	printf("%-13s %-9u %-5d %-13s %-9lld %-10.3f %-11.2f %-9.1f %-6.1f\n",
+	       t->name, capacity, fill_pct, ms_method_names[m], nr,
+	       wall_lat.p50 / 1e6, nr ? nr / (wall_lat.p50 / 1e9) / 1e6 : 0.0,
+	       nr ? cpu_lat.p50 / nr : NAN, sys_pct);
+	fflush(stdout);
+	BENCH_OUTPUT("map_scan", BF_STR("map_type", t->name),
+	             BF_U64("max_entries", capacity), BF_U64("fill_pct", fill_pct),
+	             BF_STR("method", ms_method_names[m]), BF_STR("status", "ok"),
+	             BF_U64("key_size", t->key_size),
+	             BF_U64("value_size", MS_VALUE_SIZE), BF_U64("entries", nr),
+	             BF_U64("runs", MS_RUNS), BF_F64("scan_ns", wall_lat.p50),
+	             BF_F64("entries_per_sec", nr ? nr / (wall_lat.p50 / 1e9) : 0),
+	             BF_F64("cpu_ns", cpu_lat.p50),
+	             BF_F64("cpu_ns_per_entry", nr ? cpu_lat.p50 / nr : NAN),
+	             BF_F64("sys_pct", sys_pct));
+}
+
+// 写入 [start, end) 的key，value 为非零内容
+static int ms_fill(struct ms_ctx *c, __u32 start, __u32 end) {
+	__u64 key;
+	__u32 idx;
+	int err;
+
+	for (__u32 i = start; i < end; i++) {
+		if (c->t->keyed) {
+			key = i;
+			err = bpf_map_update_elem(c->fd, &key, c->values, BPF_NOEXIST);
+		} else {
+			idx = i;
+			err = bpf_map_update_elem(c->fd, &idx, c->values, BPF_ANY);
+		}
+		if (err)
+			return err;
+	}
+	return 0;
+}
+
+// 按map的key与value大小加载迭代器程序，失败时只跳过 bpf_iter 方式
+static struct map_scan_bpf *ms_open(const struct ms_type *t,
+                                    size_t value_bytes) {
+	struct map_scan_bpf *skel;
+
+	skel = BENCH_SKEL_OPEN(map_scan);
+	if (!skel)
+		return NULL;
+	skel->rodata->scan_key_size = t->key_size;
+	skel->rodata->scan_value_size = value_bytes;
+	if (BENCH_SKEL_LOAD(map_scan, skel)) {
+		map_scan_bpf__destroy(skel);
+		return NULL;
+	}
+	return skel;
+}
+
+static struct bpf_link *ms_attach(struct map_scan_bpf *skel, int map_fd) {
+	LIBBPF_OPTS(bpf_iter_attach_opts, opts);
+	union bpf_iter_link_info linfo;
+
+	if (!skel)
+		return NULL;
+	memset(&linfo, 0, sizeof(linfo));
+	linfo.map.map_fd = map_fd;
+	opts.link_info = &linfo;
+	opts.link_info_len = sizeof(linfo);
+	return bpf_program__attach_iter(skel->progs.scan_dump, &opts);
+}
+
+static int ms_run_capacity(struct ms_ctx *c, struct map_scan_bpf *skel,
+                           __u32 capacity, __u64 mem_cap,
+                           volatile bool *exiting) {
+	__u64 estimate;
+	__u32 filled = 0, target;
+	long long expected;
+	int err = 0;
+
+	estimate = (__u64)capacity *
+	           (c->t->key_size + MS_ENTRY_OVERHEAD + c->value_bytes);
+	if (mem_cap && estimate > mem_cap) {
+		printf("%-13s %-9u skipped, about %llu MB\n", c->t->name, capacity,
+		       (unsigned long long)estimate >> 20);
+		return 0;
+	}
+	c->fd = bpf_map_create(c->t->type, "ms_map", c->t->key_size,
+	                       MS_VALUE_SIZE, capacity, NULL);
+	if (c->fd < 0) {
+		fprintf(stderr, "Failed to create %s map: %d\n", c->t->name, c->fd);
+		return c->fd;
+	}
+	c->link = ms_attach(skel, c->fd);
+	// 同一个map逐级填充到各个填充率，迭代器链接始终遍历当前内容
+	for (int f = 0; !*exiting && f < BENCH_ARRAY_SIZE(ms_fill_pcts); f++) {
+		if (!c->t->keyed && ms_fill_pcts[f] != 100)
+			continue;
+		target = (__u64)capacity * ms_fill_pcts[f] / 100;
+		err = ms_fill(c, filled, target);
+		if (err) {
+			fprintf(stderr, "Failed to fill %s map: %d\n", c->t->name, err);
+			break;
+		}
+		filled = target;
+		expected = -1;
+		for (int m = 0; !*exiting && m < MS_NR_METHODS; m++)
+			ms_run_method(c, capacity, ms_fill_pcts[f], m, &expected);
+	}
+	bpf_link__destroy(c->link);
+	c->link = NULL;
+	close(c->fd);
+	return err;
+}
+
+int bench_map_scan(volatile bool *exiting) {
+	int nr_cpus = libbpf_num_possible_cpus();
+	__u64 mem_cap = bench_mem_available() / MS_MEM_SHARE;
+	struct map_scan_bpf *skel;
+	struct ms_ctx c = {};
+	size_t max_value;
+	int err = 0;
+
+	if (nr_cpus < 0) {
+		fprintf(stderr, "Failed to get possible CPUs: %d\n", nr_cpus);
+		return nr_cpus;
+	}
+	// 每CPU map的 value 每个CPU一份
+	max_value = (size_t)MS_VALUE_SIZE * nr_cpus;
+	c.keys = calloc(MS_BATCH, sizeof(__u64));
+	c.values = malloc(MS_BATCH * max_value);
+	c.buf = malloc(MS_READ_BUF);
+	if (!c.keys || !c.values || !c.buf) {
+		err = -ENOMEM;
+		goto out;
+	}
+	memset(c.values, 0x5a, MS_BATCH * max_value);
+
+	printf("possible CPUs: %d, batch: %d, iterator read buffer: %d KB\n",
+	       nr_cpus, MS_BATCH, MS_READ_BUF / 1024);
+	printf("%-13s %-9s %-5s %-13s %-9s %-10s %-11s %-9s %-6s\n", "TYPE",
+	       "CAPACITY", "FILL%", "METHOD", "ENTRIES", "SCAN(ms)", "MENTRIES/S",
+	       "CPU NS/E", "SYS%");
+	for (int i = 0; !err && !*exiting && i < BENCH_ARRAY_SIZE(ms_types); i++) {
+		c.t = &ms_types[i];
+		c.value_bytes = MS_VALUE_SIZE * (c.t->percpu ? nr_cpus : 1);
+		if (!bench_map_type_supported(c.t->type)) {
+			printf("%-13s unsupported by running kernel\n", c.t->name);
+			continue;
+		}
+		skel = ms_open(c.t, c.value_bytes);
+		for (int s = 0; !err && !*exiting && s < BENCH_ARRAY_SIZE(ms_capacities);
+		     s++)
+			err = ms_run_capacity(&c, skel, ms_capacities[s], mem_cap, exiting);
+		map_scan_bpf__destroy(skel);
+	}
+out:
+	free(c.keys);
+	free(c.values);
+	free(c.buf);
+	return err;
+}
+
+// 迭代器程序加载失败时只跳过 bpf_iter 方式
+static const struct bench_feature map_scan_feats[] = {
+    BENCH_MAP(HASH),
+    BENCH_MAP(ARRAY),
+};
+
+BENCH_REGISTER(map_scan) = {
+    .name = "map_scan",
+    .key = 'I',
+    .doc = "Compare full-map scans: get_next_key loop, lookup_batch and "
+           "bpf_iter",
+    .feats = map_scan_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(map_scan_feats),
+    .schema = "map_type,max_entries,fill_pct,method,status,key_size,"
+              "value_size,entries,runs,scan_ns,entries_per_sec,cpu_ns,"
+              "cpu_ns_per_entry,sys_pct",
+    .run = bench_map_scan,
+};
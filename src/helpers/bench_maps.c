@@ -0,0 +1,445 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Comparing lookup/insert/delete cost of the basic map types.
+#include "bench_maps.h"
+#include "bench_output.h"
+#include "bench_percpu.h"
+#include "bench_record.h"
+#include "bench_registry.h"
+#include "bench_rounds.h"
+#include "bench_skel.h"
+#include "bench_stats.h"
+#include "bench_util.h"
+#include "common.h"
+#include "maps.skel.h"
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+//控制ringbuff次数
+static int event_count = 0;        // 事件计数器
+static volatile bool stop_polling = false; // 控制轮询的标志
+#define MAX_EVENTS 1024
+
+// 与 compare_ebpf_maps() 的输出顺序一致: 每种map依次为查找、插入、删除
+static void print_event_head(void) {
+	static const char *const maps_columns[] = {
+	    "hash_lookup",         "hash_insert",         "hash_delete",
+	    "array_lookup",        "array_insert",        "array_delete",
+	    "percpu_array_lookup", "percpu_array_insert", "percpu_array_delete",
+	    "percpu_hash_lookup",  "percpu_hash_insert",  "percpu_hash_delete",
+	};
+
+	for (size_t i = 0; i < sizeof(maps_columns) / sizeof(maps_columns[0]); i++)
+		printf("%-13s", maps_columns[i]);
+	printf("\n");
+}
+
+static void print_map_and_check_error(int (*print_func)(struct maps_bpf *),
+                                      struct maps_bpf *skel,
+                                      const char *map_name, int err) {
+	// 预热轮不输出，无需间隔
+	if (!bench_rounds_warmup())
+		OUTPUT_INTERVAL(10);
+	print_func(skel);
+	if (err < 0 && err != -4) {
+		printf("Error printing %s map: %d\n", map_name, err);
+	}
+}
+
+static struct timespec diff(struct timespec start, struct timespec end) {
+	struct timespec temp;
+	if ((end.tv_nsec - start.tv_nsec) < 0) {
+		temp.tv_sec = end.tv_sec - start.tv_sec - 1;
+		temp.tv_nsec = 1000000000 + end.tv_nsec - start.tv_nsec;
+	} else {
+		temp.tv_sec = end.tv_sec - start.tv_sec;
+		temp.tv_nsec = end.tv_nsec - start.tv_nsec;
+	}
+	return temp;
+}
+// 打印 ops 次操作的总耗时(秒)，并以ns为单位写入汇总统计、二进制结果
+// 和带map参数的结构化结果；预热轮的结果全部丢弃
+static void print_elapsed(const struct bpf_map *map, const char *op, int ops,
+                          struct timespec start, struct timespec end) {
+	struct timespec elapsed = diff(start, end);
+	__u64 ns = (__u64)elapsed.tv_sec * 1000000000ULL + elapsed.tv_nsec;
+	char formatted_time[20], name[32], phase[64];
+	size_t len;
+
+	if (bench_rounds_warmup())
+		return;
+	snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
+	         elapsed.tv_sec, elapsed.tv_nsec);
+	printf("%-13s", formatted_time);
+
+	// hash_map -> hash，与表头、分析脚本中的列名一致
+	snprintf(name, sizeof(name), "%s", bpf_map__name(map));
+	len = strlen(name);
+	if (len > 4 && strcmp(name + len - 4, "_map") == 0)
+		name[len - 4] = '\0';
+	snprintf(phase, sizeof(phase), "maps/%s_%s", name, op);
+	bench_record_samples(phase, &ns, 1);
+	bench_stat_add(bench_stats_get(phase), ns);
+	bench_rounds_add(phase, ns);
+	BENCH_OUTPUT("maps", BF_U64("round", bench_rounds_current()),
+	             BF_STR("map", name),
+	             BF_STR("map_type", libbpf_bpf_map_type_str(bpf_map__type(map))),
+	             BF_U64("max_entries", bpf_map__max_entries(map)),
+	             BF_U64("key_size", bpf_map__key_size(map)),
+	             BF_U64("value_size", bpf_map__value_size(map)),
+	             BF_U64("map_flags", bpf_map__map_flags(map)), BF_STR("op", op),
+	             BF_I64("ops", ops), BF_U64("elapsed_ns", ns),
+	             BF_F64("ns_per_op", (double)ns / ops));
+}
+#define MAX_ENTRIES 1024
+static int compare_ebpf_maps(struct maps_bpf *skel) {
+	int hash_fd = bpf_map__fd(skel->maps.hash_map);
+	int array_fd = bpf_map__fd(skel->maps.array_map);
+	int per_cpu_array_fd = bpf_map__fd(skel->maps.percpu_array_map);
+	int per_cpu_hash_fd = bpf_map__fd(skel->maps.percpu_hash_map);
+	if (hash_fd < 0 || array_fd < 0 || per_cpu_array_fd < 0) {
+		fprintf(stderr, "Failed to get map file descriptors: %d, %d\n", hash_fd,
+		        array_fd);
+		return 1;
+	}
+
+	struct timespec start, end;
+	int key, value;
+	srand(time(0)); // 生成随机数种子
+	int random_number;
+
+	// 查找 HashMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		if (bpf_map_lookup_elem(hash_fd, &random_number, &value) != 0) {
+			fprintf(stderr, "Failed to lookup element in hash_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.hash_map, "lookup", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 插入 HashMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		value = random_number * 2;
+		if (bpf_map_update_elem(hash_fd, &random_number, &value, BPF_ANY) !=
+		    0) {
+			fprintf(stderr, "Failed to insert element into hash_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.hash_map, "insert", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 清除 HashMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 0; key < MAX_ENTRIES; key++) {
+		if (bpf_map_delete_elem(hash_fd, &key) != 0) {
+			fprintf(stderr, "Failed to delete element in hash_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.hash_map, "delete", MAX_ENTRIES, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 操作 ArrayMap
+
+	// 查找 ArrayMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		if (bpf_map_lookup_elem(array_fd, &random_number, &value) != 0) {
+			fprintf(stderr, "Failed to lookup element in array_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.array_map, "lookup", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 插入 ArrayMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		value = key * 2;
+		if (bpf_map_update_elem(array_fd, &random_number, &value, BPF_ANY) !=
+		    0) {
+			fprintf(stderr, "Failed to insert element in array_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.array_map, "insert", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 清除 ArrayMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		value = 0;
+		if (bpf_map_update_elem(array_fd, &key, &value, BPF_ANY) != 0) {
+			fprintf(stderr, "Failed to reset element in array_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.array_map, "delete", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 操作 Per_cpu ArrayMap
+	// 每CPU map的 value 按可能的CPU数返回，不是在线CPU数
+	int num_cpus = libbpf_num_possible_cpus();
+	if (num_cpus < 0) {
+		fprintf(stderr, "Failed to get possible CPUs: %d\n", num_cpus);
+		return 1;
+	}
+	size_t value_size = sizeof(__u64) * num_cpus;
+	__u64 sum;
+
+	// 查找 Per_cpu ArrayMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		__u64 *values = malloc(value_size);
+		if (bpf_map_lookup_elem(per_cpu_array_fd, &random_number, values) !=
+		    0) {
+			fprintf(stderr,
+			        "Failed to lookup element in percpu_array_map: %d\n",
+			        errno);
+			return 1;
+		}
+
+		// 汇总各个 CPU 上的值
+		bench_percpu_reduce(BENCH_PERCPU_SUM, values, 1, num_cpus, 1, &sum);
+		free(values);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.percpu_array_map, "lookup", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 插入per_cpu_array_map
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		// 初始化每个CPU的值
+		__u64 *values = malloc(value_size);
+		for (int cpu = 0; cpu < num_cpus; cpu++) {
+			values[cpu] = random_number *
+			              (cpu + 1); // 示例：每个CPU的值为随机数乘以CPU编号
+		}
+
+		if (bpf_map_update_elem(per_cpu_array_fd, &random_number, values,
+		                        BPF_ANY) != 0) {
+			fprintf(stderr,
+			        "Failed to insert element into percpu_array_map: %d\n",
+			        errno);
+			return 1;
+		}
+		free(values);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.percpu_array_map, "insert", MAX_ENTRIES - 1, start, end);
+	fflush(stdout);
+
+	// 清除 Per_cpu ArrayMap
+	// 将每个CPU上的值重置为0
+	__u64 *zero_values = calloc(num_cpus, sizeof(__u64));
+	if (!zero_values)
+		return 1;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		if (bpf_map_update_elem(per_cpu_array_fd, &key, zero_values,
+		                        BPF_ANY) != 0) {
+			fprintf(stderr, "Failed to reset element in percpu_array_map: %d\n",
+			        errno);
+			free(zero_values);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	free(zero_values);
+	print_elapsed(skel->maps.percpu_array_map, "delete", MAX_ENTRIES - 1, start, end);
+	fflush(stdout);
+	// 计算一下malloc和free的耗时
+	//  clock_gettime(CLOCK_MONOTONIC, &start);
+	//  for(int i = 0 ; i < 1024 ; i++){
+	//      __u64 *values = malloc(value_size);
+	//      free(values);
+	//  }
+	//  clock_gettime(CLOCK_MONOTONIC, &end);
+	//  elapsed = diff(start, end);
+	//  snprintf(formatted_time, sizeof(formatted_time), "%ld.%09ld",
+	//  elapsed.tv_sec, elapsed.tv_nsec); printf("malloc耗时:%-13s\n",
+	//  formatted_time);
+
+	// 操作per_cpu_hash_map
+	//  查找 Per_cpu HashMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		__u64 *values = malloc(value_size);
+		if (bpf_map_lookup_elem(per_cpu_hash_fd, &random_number, values) != 0) {
+			fprintf(stderr, "Failed to lookup element in percpu_hash_map: %d\n",
+			        errno);
+			return 1;
+		}
+
+		// 汇总各个 CPU 上的值
+		bench_percpu_reduce(BENCH_PERCPU_SUM, values, 1, num_cpus, 1, &sum);
+		free(values);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.percpu_hash_map, "lookup", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+	// 插入 Per_cpu HashMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		random_number = (rand() % key);
+		// 初始化每个 CPU 的值
+		__u64 *values = malloc(value_size);
+		for (int cpu = 0; cpu < num_cpus; cpu++) {
+			values[cpu] = random_number *
+			              (cpu + 1); // 示例：每个 CPU 的值为随机数乘以 CPU 编号
+		}
+
+		if (bpf_map_update_elem(per_cpu_hash_fd, &random_number, values,
+		                        BPF_ANY) != 0) {
+			fprintf(stderr,
+			        "Failed to insert element into percpu_hash_map: %d\n",
+			        errno);
+			return 1;
+		}
+		free(values);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.percpu_hash_map, "insert", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+
+		// 清除 Per_cpu HashMap
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (key = 1; key < MAX_ENTRIES; key++) {
+		if (bpf_map_delete_elem(per_cpu_hash_fd, &key) != 0) {
+			fprintf(stderr, "Failed to delete element in percpu_hash_map: %d\n",
+			        errno);
+			return 1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_elapsed(skel->maps.percpu_hash_map, "delete", MAX_ENTRIES - 1, start, end);
+	fflush(stdout); // 刷新输出缓冲区
+    
+	// 操作ringbuff
+
+	if (!bench_rounds_warmup())
+		printf("\n");
+	
+	return 0;
+}
+/*环形缓冲区的处理函数，用来打印ringbuff中的数据（最后展示的数据行）*/
+static int handle_event(void *ctx, void *data, size_t data_sz) {
+    printf("进入打印ringbuff函数\n");
+    struct common_event *e = data;
+
+    printf("打印ringbuff的数据\n");
+    //printf("%-6d %-6llu\n", e->test_ringbuff.key, e->test_ringbuff.value);
+    int key = e->test_ringbuff.key;
+    unsigned long long value = e->test_ringbuff.value;
+    event_count++;
+    // 如果事件计数器达到 MAX_EVENTS，设置标志停止轮询
+    if (event_count >= MAX_EVENTS) {
+        stop_polling = true;
+    }
+    return 0;
+}
+
+int bench_maps(volatile bool *exiting) {
+	static const char *const progs[] = {"tp_sys_entry"};
+	struct maps_bpf *skel;
+	struct ring_buffer *rb = NULL;
+	int err;
+
+	skel = BENCH_SKEL_OPEN(maps);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return -errno;
+	}
+	/* 只加载系统调用跟踪点，其他基准测试的程序不加载 */
+	bench_autoload_only(skel->obj, progs, sizeof(progs) / sizeof(progs[0]));
+	/* 加载并验证BPF程序 */
+	err = BENCH_SKEL_LOAD(maps, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load and verify BPF skeleton\n");
+		goto cleanup;
+	}
+	/* 附加跟踪点处理程序 */
+	err = BENCH_SKEL_ATTACH(maps, skel);
+	if (err) {
+		fprintf(stderr, "Failed to attach BPF skeleton\n");
+		goto cleanup;
+	}
+	/* 设置环形缓冲区轮询 */
+	rb = ring_buffer__new(bpf_map__fd(skel->maps.rb), handle_event, NULL,
+	                      NULL);
+	if (!rb) {
+		err = -errno;
+		fprintf(stderr, "Failed to create ring buffer\n");
+		goto cleanup;
+	}
+	print_event_head();
+	bench_rounds_start();
+	while (bench_rounds_next(exiting)) {
+		print_map_and_check_error(compare_ebpf_maps, skel, "maps", err);
+		if (bench_stats_take_request())
+			bench_stats_print(stdout, BENCH_STATS_TITLE);
+	}
+cleanup:
+	ring_buffer__free(rb);
+	maps_bpf__destroy(skel);
+	return err;
+}
+
+static const struct bench_feature maps_feats[] = {
+    BENCH_PROG(TRACEPOINT),   BENCH_MAP(RINGBUF),
+    BENCH_MAP(HASH),          BENCH_MAP(ARRAY),
+    BENCH_MAP(PERCPU_ARRAY),  BENCH_MAP(PERCPU_HASH),
+    BENCH_HELPER(TRACEPOINT, ringbuf_reserve),
+};
+
+BENCH_REGISTER(maps) = {
+    .name = "maps",
+    .key = 'a',
+    .doc = "Comparing the differences between eBPF Maps",
+    .feats = maps_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(maps_feats),
+    .schema = "round,map,map_type,max_entries,key_size,value_size,map_flags,"
+              "op,ops,elapsed_ns,ns_per_op",
+    .run = bench_maps,
+};
@@ -0,0 +1,898 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Declarative benchmark matrix runner.
+#include "bench_matrix.h"
+#include "bench_features.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_util.h"
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 每个参数最多列出的取值个数，以及一个配置文件中最多的节数
+#define MATRIX_MAX_VALUES 16
+#define MATRIX_MAX_SPECS 64
+
+enum matrix_op { MATRIX_LOOKUP, MATRIX_UPDATE, MATRIX_DELETE, MATRIX_NR_OPS };
+static const char *const matrix_op_names[MATRIX_NR_OPS] = {"lookup", "update",
+                                                          "delete"};
+
+struct matrix_map_type {
+	const char *name;
+	int type;
+	bool percpu;
+	bool array;
+};
+static const struct matrix_map_type matrix_map_types[] = {
+    {"hash", BPF_MAP_TYPE_HASH, false, false},
+    {"array", BPF_MAP_TYPE_ARRAY, false, true},
+    {"percpu_hash", BPF_MAP_TYPE_PERCPU_HASH, true, false},
+    {"percpu_array", BPF_MAP_TYPE_PERCPU_ARRAY, true, true},
+    {"lru_hash", BPF_MAP_TYPE_LRU_HASH, false, false},
+    {"lru_percpu_hash", BPF_MAP_TYPE_LRU_PERCPU_HASH, true, false},
+};
+#define MATRIX_NR_MAP_TYPES                                                    \
+	(sizeof(matrix_map_types) / sizeof(matrix_map_types[0]))
+
+// 只列出不影响用户态读写的标志
+static const struct {
+	const char *name;
+	__u32 flag;
+} matrix_flag_names[] = {
+    {"no_prealloc", BPF_F_NO_PREALLOC}, {"no_common_lru", BPF_F_NO_COMMON_LRU},
+    {"zero_seed", BPF_F_ZERO_SEED},     {"rdonly_prog", BPF_F_RDONLY_PROG},
+    {"wronly_prog", BPF_F_WRONLY_PROG},
+};
+#define MATRIX_NR_FLAG_NAMES                                                   \
+	(sizeof(matrix_flag_names) / sizeof(matrix_flag_names[0]))
+
+enum matrix_dist_kind { MATRIX_UNIFORM, MATRIX_SEQ, MATRIX_ZIPF };
+struct matrix_dist {
+	int kind;
+	double s;
+	char name[16];
+};
+
+// 查找/更新/删除所占的百分比
+struct matrix_mix {
+	__u32 pct[MATRIX_NR_OPS];
+	char name[16];
+};
+
+// 配置文件中的一节，每个参数保存其全部取值
+struct matrix_spec {
+	char name[32];
+	int maps[MATRIX_MAX_VALUES];
+	int nr_maps;
+	__u32 flags[MATRIX_MAX_VALUES];
+	int nr_flags;
+	__u32 entries[MATRIX_MAX_VALUES];
+	int nr_entries;
+	__u32 key_sizes[MATRIX_MAX_VALUES];
+	int nr_key_sizes;
+	__u32 value_sizes[MATRIX_MAX_VALUES];
+	int nr_value_sizes;
+	struct matrix_dist dists[MATRIX_MAX_VALUES];
+	int nr_dists;
+	__u32 threads[MATRIX_MAX_VALUES];
+	int nr_threads;
+	struct matrix_mix mixes[MATRIX_MAX_VALUES];
+	int nr_mixes;
+	// 每个线程每轮的操作次数
+	__u32 ops[MATRIX_MAX_VALUES];
+	int nr_ops;
+	__u32 reps[1];
+	int nr_reps;
+};
+
+// 决定能否复用已创建map的几何参数
+struct matrix_geom {
+	int map;
+	__u32 flags;
+	__u32 entries;
+	__u32 key_size;
+	__u32 value_size;
+};
+
+// 笛卡尔积中的一个配置
+struct matrix_config {
+	const struct matrix_spec *spec;
+	struct matrix_geom geom;
+	const struct matrix_dist *dist;
+	__u32 threads;
+	const struct matrix_mix *mix;
+	__u32 ops;
+};
+
+struct matrix_ctx {
+	struct matrix_geom geom;
+	int map_fd;
+	// map中是否已写满 0..entries-1 的全部key
+	bool populated;
+	bool reused;
+	// 最近一次被跳过的几何参数，其余取值组合不再逐条打印
+	struct matrix_geom skip_geom;
+	bool skip_valid;
+	int nr_cpus;
+	// zipf 分布的累积概率表，按容量与参数缓存
+	double *cdf;
+	__u32 cdf_entries;
+	double cdf_s;
+	__u32 nr_configs;
+	__u32 nr_created;
+	__u32 nr_reused;
+	__u32 nr_skipped;
+};
+
+struct matrix_worker {
+	struct matrix_ctx *c;
+	const struct matrix_map_type *mt;
+	__u32 *keys;
+	unsigned char *ops;
+	__u32 nr_ops;
+	void *key;
+	void *value;
+	void *zero;
+	__u64 ns;
+	__u64 misses;
+	int err;
+};
+
+/* ---------------- 配置文件解析 ---------------- */
+
+static char *matrix_trim(char *s) {
+	char *end;
+
+	while (isspace((unsigned char)*s))
+		s++;
+	end = s + strlen(s);
+	while (end > s && isspace((unsigned char)end[-1]))
+		end--;
+	*end = '\0';
+	return s;
+}
+
+// 支持 k/m 后缀(1024进制)
+static int matrix_parse_u32(const char *tok, void *out) {
+	unsigned long long v;
+	char *end;
+
+	v = strtoull(tok, &end, 0);
+	if (end == tok || *tok == '-')
+		return -EINVAL;
+	if (*end == 'k' || *end == 'K') {
+		v <<= 10;
+		end++;
+	} else if (*end == 'm' || *end == 'M') {
+		v <<= 20;
+		end++;
+	}
+	if (*end || !v || v > 0xffffffffULL)
+		return -EINVAL;
+	*(__u32 *)out = v;
+	return 0;
+}
+
+// key 的前4个字节保存下标，因此至少为4
+static int matrix_parse_key_size(const char *tok, void *out) {
+	int err = matrix_parse_u32(tok, out);
+
+	return err ? err : *(__u32 *)out < sizeof(__u32) ? -EINVAL : 0;
+}
+
+static int matrix_parse_map(const char *tok, void *out) {
+	for (size_t i = 0; i < MATRIX_NR_MAP_TYPES; i++) {
+		if (strcmp(tok, matrix_map_types[i].name) == 0) {
+			*(int *)out = i;
+			return 0;
+		}
+	}
+	return -EINVAL;
+}
+
+// none，或以 | 连接的标志名/数值，如 no_prealloc|zero_seed
+static int matrix_parse_flags(const char *tok, void *out) {
+	char buf[128], *name, *save, *end;
+	__u32 flags = 0;
+	size_t i;
+
+	if (strcmp(tok, "none") == 0) {
+		*(__u32 *)out = 0;
+		return 0;
+	}
+	snprintf(buf, sizeof(buf), "%s", tok);
+	for (name = strtok_r(buf, "|", &save); name;
+	     name = strtok_r(NULL, "|", &save)) {
+		name = matrix_trim(name);
+		for (i = 0; i < MATRIX_NR_FLAG_NAMES; i++) {
+			if (strcmp(name, matrix_flag_names[i].name) == 0)
+				break;
+		}
+		if (i < MATRIX_NR_FLAG_NAMES) {
+			flags |= matrix_flag_names[i].flag;
+			continue;
+		}
+		flags |= strtoul(name, &end, 0);
+		if (end == name || *end)
+			return -EINVAL;
+	}
+	*(__u32 *)out = flags;
+	return 0;
+}
+
+// uniform、seq 或 zipf[:s](默认 s=0.99)
+static int matrix_parse_dist(const char *tok, void *out) {
+	struct matrix_dist *d = out;
+	char *end;
+
+	d->s = 0;
+	if (strcmp(tok, "uniform") == 0) {
+		d->kind = MATRIX_UNIFORM;
+	} else if (strcmp(tok, "seq") == 0) {
+		d->kind = MATRIX_SEQ;
+	} else if (strncmp(tok, "zipf", 4) == 0 &&
+	           (tok[4] == '\0' || tok[4] == ':')) {
+		d->kind = MATRIX_ZIPF;
+		d->s = 0.99;
+		if (tok[4] == ':') {
+			d->s = strtod(tok + 5, &end);
+			if (end == tok + 5 || *end || !(d->s > 0))
+				return -EINVAL;
+		}
+	} else {
+		return -EINVAL;
+	}
+	snprintf(d->name, sizeof(d->name), "%s", tok);
+	return 0;
+}
+
+// lookup、update、delete，或"查找/更新/删除"百分比，如 90/10/0
+static int matrix_parse_mix(const char *tok, void *out) {
+	struct matrix_mix *m = out;
+	bool named = false;
+	int n = 0;
+
+	memset(m->pct, 0, sizeof(m->pct));
+	for (int i = 0; i < MATRIX_NR_OPS && !named; i++) {
+		if (strcmp(tok, matrix_op_names[i]) == 0) {
+			m->pct[i] = 100;
+			named = true;
+		}
+	}
+	if (!named &&
+	    (sscanf(tok, "%u/%u/%u%n", &m->pct[0], &m->pct[1], &m->pct[2], &n) !=
+	         3 ||
+	     tok[n] || m->pct[0] + m->pct[1] + m->pct[2] != 100))
+		return -EINVAL;
+	snprintf(m->name, sizeof(m->name), "%s", tok);
+	return 0;
+}
+
+struct matrix_key {
+	const char *name;
+	// 取值数组与取值个数在 struct matrix_spec 中的偏移
+	size_t values;
+	size_t nr;
+	size_t size;
+	int max;
+	int (*parse)(const char *tok, void *out);
+};
+#define MATRIX_KEY(name, field, max, parse)                                    \
+	{name,                                                                     \
+	 offsetof(struct matrix_spec, field),                                      \
+	 offsetof(struct matrix_spec, nr_##field),                                 \
+	 sizeof(((struct matrix_spec *)0)->field[0]),                              \
+	 max,                                                                      \
+	 parse}
+static const struct matrix_key matrix_keys[] = {
+    MATRIX_KEY("map", maps, MATRIX_MAX_VALUES, matrix_parse_map),
+    MATRIX_KEY("flags", flags, MATRIX_MAX_VALUES, matrix_parse_flags),
+    MATRIX_KEY("entries", entries, MATRIX_MAX_VALUES, matrix_parse_u32),
+    MATRIX_KEY("key_size", key_sizes, MATRIX_MAX_VALUES,
+               matrix_parse_key_size),
+    MATRIX_KEY("value_size", value_sizes, MATRIX_MAX_VALUES,
+               matrix_parse_u32),
+    MATRIX_KEY("dist", dists, MATRIX_MAX_VALUES, matrix_parse_dist),
+    MATRIX_KEY("threads", threads, MATRIX_MAX_VALUES, matrix_parse_u32),
+    MATRIX_KEY("mix", mixes, MATRIX_MAX_VALUES, matrix_parse_mix),
+    MATRIX_KEY("ops", ops, MATRIX_MAX_VALUES, matrix_parse_u32),
+    MATRIX_KEY("reps", reps, 1, matrix_parse_u32),
+};
+
+static void matrix_spec_init(struct matrix_spec *s) {
+	memset(s, 0, sizeof(*s));
+	snprintf(s->name, sizeof(s->name), "default");
+	s->maps[s->nr_maps++] = 0;
+	s->flags[s->nr_flags++] = 0;
+	s->entries[s->nr_entries++] = 1024;
+	s->key_sizes[s->nr_key_sizes++] = sizeof(__u32);
+	s->value_sizes[s->nr_value_sizes++] = sizeof(__u64);
+	matrix_parse_dist("uniform", &s->dists[s->nr_dists++]);
+	s->threads[s->nr_threads++] = 1;
+	matrix_parse_mix("lookup", &s->mixes[s->nr_mixes++]);
+	s->ops[s->nr_ops++] = 100000;
+	s->reps[s->nr_reps++] = 5;
+}
+
+// 以逗号分隔的取值整体替换该参数原有(继承自默认值)的取值
+static const char *matrix_set(struct matrix_spec *s, const struct matrix_key *k,
+                              char *values) {
+	char *base = (char *)s, *tok, *save;
+	int *nr = (int *)(base + k->nr);
+
+	*nr = 0;
+	for (tok = strtok_r(values, ",", &save); tok;
+	     tok = strtok_r(NULL, ",", &save)) {
+		if (*nr >= k->max)
+			return "too many values";
+		if (k->parse(matrix_trim(tok), base + k->values + *nr * k->size))
+			return "invalid value";
+		(*nr)++;
+	}
+	return *nr ? NULL : "missing value";
+}
+
+// 第一个节之前的键值是所有节的默认值；文件中没有节时，顶层键值本身即一个矩阵
+static int matrix_parse(const char *path, struct matrix_spec *specs,
+                        int *nr_specs) {
+	struct matrix_spec defaults, *cur = &defaults;
+	const char *msg = NULL, *key = NULL;
+	char line[512], *p, *eq;
+	int lineno = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (!f) {
+		fprintf(stderr, "Failed to open %s: %d\n", path, -errno);
+		return -errno;
+	}
+	matrix_spec_init(&defaults);
+	*nr_specs = 0;
+	while (!msg && fgets(line, sizeof(line), f)) {
+		lineno++;
+		key = NULL;
+		p = strchr(line, '#');
+		if (p)
+			*p = '\0';
+		p = matrix_trim(line);
+		if (!*p)
+			continue;
+		if (*p == '[') {
+			eq = strchr(p, ']');
+			if (!eq || eq[1]) {
+				msg = "malformed section header";
+			} else if (*nr_specs >= MATRIX_MAX_SPECS) {
+				msg = "too many sections";
+			} else {
+				*eq = '\0';
+				cur = &specs[(*nr_specs)++];
+				*cur = defaults;
+				snprintf(cur->name, sizeof(cur->name), "%s",
+				         matrix_trim(p + 1));
+			}
+			continue;
+		}
+		eq = strchr(p, '=');
+		if (!eq) {
+			msg = "expected key = value[, value...]";
+			continue;
+		}
+		*eq = '\0';
+		key = matrix_trim(p);
+		msg = "unknown key";
+		for (size_t i = 0; i < sizeof(matrix_keys) / sizeof(matrix_keys[0]);
+		     i++) {
+			if (strcmp(key, matrix_keys[i].name) == 0) {
+				msg = matrix_set(cur, &matrix_keys[i], eq + 1);
+				break;
+			}
+		}
+	}
+	fclose(f);
+	if (msg) {
+		fprintf(stderr, "%s:%d: %s%s%s\n", path, lineno, key ? key : "",
+		        key ? ": " : "", msg);
+		return -EINVAL;
+	}
+	if (!*nr_specs)
+		specs[(*nr_specs)++] = defaults;
+	return 0;
+}
+
+/* ---------------- 负载生成 ---------------- */
+
+static __u64 matrix_rand(__u64 *state) {
+	__u64 x = *state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+static double matrix_rand_unit(__u64 *state) {
+	return (matrix_rand(state) >> 11) * 0x1.0p-53;
+}
+
+// 第 i 名的概率正比于 1/(i+1)^s，排名即key下标
+static int matrix_zipf_prepare(struct matrix_ctx *c, __u32 entries, double s) {
+	double sum = 0;
+
+	if (c->cdf && c->cdf_entries == entries && c->cdf_s == s)
+		return 0;
+	free(c->cdf);
+	c->cdf = malloc(entries * sizeof(*c->cdf));
+	if (!c->cdf)
+		return -ENOMEM;
+	for (__u32 i = 0; i < entries; i++) {
+		sum += pow(i + 1, -s);
+		c->cdf[i] = sum;
+	}
+	for (__u32 i = 0; i < entries; i++)
+		c->cdf[i] /= sum;
+	c->cdf_entries = entries;
+	c->cdf_s = s;
+	return 0;
+}
+
+static __u32 matrix_zipf(const struct matrix_ctx *c, __u64 *rng) {
+	double u = matrix_rand_unit(rng);
+	__u32 lo = 0, hi = c->cdf_entries - 1;
+
+	while (lo < hi) {
+		__u32 mid = lo + (hi - lo) / 2;
+		if (c->cdf[mid] < u)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+// 预先生成每个线程的key下标与操作序列，计时区间内只执行map操作
+static void matrix_gen(struct matrix_ctx *c, const struct matrix_config *cfg,
+                       int t, struct matrix_worker *w) {
+	__u32 entries = cfg->geom.entries;
+	__u32 start = (__u64)entries * t / cfg->threads;
+	__u64 rng = 0x9e3779b97f4a7c15ULL ^ ((__u64)(t + 1) << 32);
+
+	for (__u32 i = 0; i < w->nr_ops; i++) {
+		__u32 r = matrix_rand(&rng) % 100;
+
+		switch (cfg->dist->kind) {
+		case MATRIX_SEQ:
+			w->keys[i] = (start + i) % entries;
+			break;
+		case MATRIX_ZIPF:
+			w->keys[i] = matrix_zipf(c, &rng);
+			break;
+		default:
+			w->keys[i] = matrix_rand(&rng) % entries;
+			break;
+		}
+		w->ops[i] = r < cfg->mix->pct[MATRIX_LOOKUP] ? MATRIX_LOOKUP
+		            : r < cfg->mix->pct[MATRIX_LOOKUP] +
+		                      cfg->mix->pct[MATRIX_UPDATE]
+		                ? MATRIX_UPDATE
+		                : MATRIX_DELETE;
+	}
+}
+
+/* ---------------- map 管理与测量 ---------------- */
+
+static bool matrix_geom_equal(const struct matrix_geom *a,
+                              const struct matrix_geom *b) {
+	return a->map == b->map && a->flags == b->flags &&
+	       a->entries == b->entries && a->key_size == b->key_size &&
+	       a->value_size == b->value_size;
+}
+
+// 用户态读写per-CPU map时，value 按8字节对齐后乘以可能的CPU个数
+static size_t matrix_value_len(const struct matrix_ctx *c,
+                               const struct matrix_config *cfg) {
+	const struct matrix_map_type *mt = &matrix_map_types[cfg->geom.map];
+
+	if (!mt->percpu)
+		return cfg->geom.value_size;
+	return ((cfg->geom.value_size + 7) & ~7U) * c->nr_cpus;
+}
+
+static void matrix_close_map(struct matrix_ctx *c) {
+	if (c->map_fd >= 0)
+		close(c->map_fd);
+	c->map_fd = -1;
+}
+
+// 几何参数不变时复用当前map，否则重新创建
+static int matrix_open_map(struct matrix_ctx *c, const struct matrix_geom *g) {
+	const struct matrix_map_type *mt = &matrix_map_types[g->map];
+	LIBBPF_OPTS(bpf_map_create_opts, opts, .map_flags = g->flags);
+
+	c->reused = c->map_fd >= 0 && matrix_geom_equal(&c->geom, g);
+	if (c->reused) {
+		c->nr_reused++;
+		return 0;
+	}
+	matrix_close_map(c);
+	c->map_fd = bpf_map_create(mt->type, "matrix_map", g->key_size,
+	                           g->value_size, g->entries, &opts);
+	if (c->map_fd < 0)
+		return c->map_fd;
+	c->geom = *g;
+	// array map 创建后即包含全部key
+	c->populated = mt->array;
+	c->nr_created++;
+	return 0;
+}
+
+static int matrix_populate(struct matrix_ctx *c, struct matrix_worker *w) {
+	int err;
+
+	memset(w->key, 0, c->geom.key_size);
+	for (__u32 i = 0; i < c->geom.entries; i++) {
+		memcpy(w->key, &i, sizeof(i));
+		err = bpf_map_update_elem(c->map_fd, w->key, w->value, BPF_ANY);
+		if (err)
+			return err;
+	}
+	c->populated = true;
+	return 0;
+}
+
+static void *matrix_worker_fn(void *arg) {
+	struct matrix_worker *w = arg;
+	int fd = w->c->map_fd, err = 0;
+	__u64 start;
+
+	start = bench_now_ns();
+	for (__u32 i = 0; i < w->nr_ops; i++) {
+		memcpy(w->key, &w->keys[i], sizeof(__u32));
+		switch (w->ops[i]) {
+		case MATRIX_LOOKUP:
+			err = bpf_map_lookup_elem(fd, w->key, w->value);
+			break;
+		case MATRIX_UPDATE:
+			err = bpf_map_update_elem(fd, w->key, w->value, BPF_ANY);
+			break;
+		default:
+			// array map 不支持删除，与 -a 一致以写入全0值代替
+			err = w->mt->array
+			          ? bpf_map_update_elem(fd, w->key, w->zero, BPF_ANY)
+			          : bpf_map_delete_elem(fd, w->key);
+			break;
+		}
+		// 删除后再查找/删除、LRU 淘汰都会出现不存在的key，只计数
+		if (err == -ENOENT) {
+			w->misses++;
+			err = 0;
+		}
+		if (err)
+			break;
+	}
+	w->ns = bench_now_ns() - start;
+	w->err = err;
+	return NULL;
+}
+
+static void matrix_free_workers(struct matrix_worker *workers, __u32 nr) {
+	for (__u32 i = 0; i < nr; i++) {
+		free(workers[i].keys);
+		free(workers[i].ops);
+		free(workers[i].key);
+		free(workers[i].value);
+		free(workers[i].zero);
+	}
+	free(workers);
+}
+
+static struct matrix_worker *matrix_alloc_workers(struct matrix_ctx *c,
+                                                  const struct matrix_config *cfg) {
+	size_t value_len = matrix_value_len(c, cfg);
+	struct matrix_worker *workers;
+
+	workers = calloc(cfg->threads, sizeof(*workers));
+	if (!workers)
+		return NULL;
+	for (__u32 t = 0; t < cfg->threads; t++) {
+		struct matrix_worker *w = &workers[t];
+
+		w->c = c;
+		w->mt = &matrix_map_types[cfg->geom.map];
+		w->nr_ops = cfg->ops;
+		w->keys = calloc(cfg->ops, sizeof(*w->keys));
+		w->ops = calloc(cfg->ops, sizeof(*w->ops));
+		w->key = calloc(1, cfg->geom.key_size);
+		w->value = malloc(value_len);
+		w->zero = calloc(1, value_len);
+		if (!w->keys || !w->ops || !w->key || !w->value || !w->zero) {
+			matrix_free_workers(workers, cfg->threads);
+			return NULL;
+		}
+		memset(w->value, 0x5a, value_len);
+		matrix_gen(c, cfg, t, w);
+	}
+	return workers;
+}
+
+static void matrix_flags_str(__u32 flags, char *buf, size_t size) {
+	size_t len = 0;
+
+	buf[0] = '\0';
+	for (size_t i = 0; i < MATRIX_NR_FLAG_NAMES; i++) {
+		if (!(flags & matrix_flag_names[i].flag))
+			continue;
+		len += snprintf(buf + len, len < size ? size - len : 0, "%s%s",
+		                len ? "|" : "", matrix_flag_names[i].name);
+		flags &= ~matrix_flag_names[i].flag;
+	}
+	if (flags)
+		snprintf(buf + len, len < size ? size - len : 0, "%s%#x",
+		         len ? "|" : "", flags);
+	else if (!len)
+		snprintf(buf, size, "none");
+}
+
+static void matrix_print_skip(struct matrix_ctx *c,
+                              const struct matrix_config *cfg,
+                              const char *flags, const char *reason) {
+	c->skip_geom = cfg->geom;
+	c->skip_valid = true;
+	c->nr_skipped++;
+	printf("%-12s %-15s %-12s %-8u %-4u %-5u %s\n", cfg->spec->name,
+	       matrix_map_types[cfg->geom.map].name, flags, cfg->geom.entries,
+	       cfg->geom.key_size, cfg->geom.value_size, reason);
+	fflush(stdout);
+}
+
+static void matrix_print(struct matrix_ctx *c, const struct matrix_config *cfg,
+                         const char *flags, const __u64 *samples, __u32 reps,
+                         const struct bench_lat *lat, double mops,
+                         __u64 misses, __u64 total_ops) {
+	const struct matrix_map_type *mt = &matrix_map_types[cfg->geom.map];
+	double miss_pct = total_ops ? 100.0 * misses / total_ops : 0;
+
+	printf("%-12s %-15s %-12s %-8u %-4u %-5u %-10s %-3u %-9s %-8u %-9.1f "
+	       "%-9llu %-9llu %-9llu %-8.3f %-6.2f %s\n",
+	       cfg->spec->name, mt->name, flags, cfg->geom.entries,
+	       cfg->geom.key_size, cfg->geom.value_size, cfg->dist->name,
+	       cfg->threads, cfg->mix->name, cfg->ops, lat->avg,
+	       (unsigned long long)lat->p50, (unsigned long long)samples[0],
+	       (unsigned long long)samples[reps - 1], mops, miss_pct,
+	       c->reused ? "reused" : "created");
+	fflush(stdout);
+	BENCH_OUTPUT("matrix", BF_STR("matrix", cfg->spec->name),
+	             BF_STR("map", mt->name),
+	             BF_STR("map_type", libbpf_bpf_map_type_str(mt->type)),
+	             BF_STR("map_flags", flags),
+	             BF_U64("max_entries", cfg->geom.entries),
+	             BF_U64("key_size", cfg->geom.key_size),
+	             BF_U64("value_size", cfg->geom.value_size),
+	             BF_STR("dist", cfg->dist->name),
+	             BF_U64("threads", cfg->threads), BF_STR("mix", cfg->mix->name),
+	             BF_U64("lookup_pct", cfg->mix->pct[MATRIX_LOOKUP]),
+	             BF_U64("update_pct", cfg->mix->pct[MATRIX_UPDATE]),
+	             BF_U64("delete_pct", cfg->mix->pct[MATRIX_DELETE]),
+	             BF_U64("ops", cfg->ops), BF_U64("reps", reps),
+	             BF_F64("avg_ns", lat->avg), BF_F64("p50_ns", lat->p50),
+	             BF_U64("min_ns", samples[0]),
+	             BF_U64("max_ns", samples[reps - 1]), BF_F64("mops", mops),
+	             BF_U64("misses", misses),
+	             BF_STR("map_setup", c->reused ? "reused" : "created"));
+}
+
+// 每轮记录一个样本: 各线程平均每次操作的耗时(ns)
+static int matrix_run_config(struct matrix_ctx *c,
+                             const struct matrix_config *cfg,
+                             volatile bool *exiting) {
+	const struct matrix_map_type *mt = &matrix_map_types[cfg->geom.map];
+	__u32 reps = cfg->spec->reps[0], done = 0;
+	struct matrix_worker *workers = NULL;
+	__u64 *samples = NULL, wall_ns, total_wall = 0, misses = 0;
+	char flags[64], phase[112], reason[64];
+	struct bench_lat lat;
+	int err;
+
+	c->nr_configs++;
+	if (c->skip_valid && matrix_geom_equal(&c->skip_geom, &cfg->geom)) {
+		c->nr_skipped++;
+		return 0;
+	}
+	matrix_flags_str(cfg->geom.flags, flags, sizeof(flags));
+	if (!bench_map_type_supported(mt->type)) {
+		matrix_print_skip(c, cfg, flags, "skipped: map type unsupported");
+		return 0;
+	}
+	if (mt->array && cfg->geom.key_size != sizeof(__u32)) {
+		matrix_print_skip(c, cfg, flags,
+		                  "skipped: array maps need key_size 4");
+		return 0;
+	}
+	err = matrix_open_map(c, &cfg->geom);
+	if (err) {
+		// 标志与map类型不兼容等属于矩阵中的正常组合，跳过即可
+		snprintf(reason, sizeof(reason), "skipped: map create failed: %d",
+		         err);
+		matrix_print_skip(c, cfg, flags, reason);
+		return 0;
+	}
+	if (cfg->dist->kind == MATRIX_ZIPF) {
+		err = matrix_zipf_prepare(c, cfg->geom.entries, cfg->dist->s);
+		if (err)
+			return err;
+	}
+	samples = calloc(reps, sizeof(*samples));
+	workers = matrix_alloc_workers(c, cfg);
+	if (!samples || !workers) {
+		err = -ENOMEM;
+		goto out;
+	}
+	for (; done < reps && !*exiting; done++) {
+		__u64 ns = 0;
+
+		if (!c->populated) {
+			err = matrix_populate(c, &workers[0]);
+			if (err) {
+				fprintf(stderr, "Failed to populate %s map: %d\n", mt->name,
+				        err);
+				goto out;
+			}
+		}
+		for (__u32 t = 0; t < cfg->threads; t++) {
+			workers[t].misses = 0;
+			workers[t].err = 0;
+		}
+		err = bench_run_threads(cfg->threads, matrix_worker_fn, workers,
+		                        sizeof(workers[0]), &wall_ns);
+		for (__u32 t = 0; !err && t < cfg->threads; t++) {
+			err = workers[t].err;
+			ns += workers[t].ns;
+			misses += workers[t].misses;
+		}
+		if (err) {
+			fprintf(stderr, "%s %s failed: %d\n", cfg->spec->name, mt->name,
+			        err);
+			goto out;
+		}
+		samples[done] = ns / ((__u64)cfg->threads * cfg->ops);
+		total_wall += wall_ns;
+		// 删除过的key需要在下一轮前补齐，保证每轮的起始状态一致
+		if (cfg->mix->pct[MATRIX_DELETE] && !mt->array)
+			c->populated = false;
+	}
+	if (!done)
+		goto out;
+	snprintf(phase, sizeof(phase), "matrix/%s/%s/%s/e%u/k%u/v%u/%s/t%u/%s/n%u",
+	         cfg->spec->name, mt->name, flags, cfg->geom.entries,
+	         cfg->geom.key_size, cfg->geom.value_size, cfg->dist->name,
+	         cfg->threads, cfg->mix->name, cfg->ops);
+	bench_lat_summarize(phase, samples, done, &lat);
+	matrix_print(c, cfg, flags, samples, done, &lat,
+	             (double)done * cfg->threads * cfg->ops * 1000.0 / total_wall,
+	             misses, (__u64)done * cfg->threads * cfg->ops);
+out:
+	if (workers)
+		matrix_free_workers(workers, cfg->threads);
+	free(samples);
+	return err;
+}
+
+// 按笛卡尔积遍历一节: 几何参数在外层，相邻配置尽量共用同一个map
+static int matrix_run_spec(struct matrix_ctx *c, const struct matrix_spec *s,
+                           volatile bool *exiting) {
+	const int counts[] = {s->nr_maps,   s->nr_flags,       s->nr_entries,
+	                      s->nr_key_sizes, s->nr_value_sizes, s->nr_dists,
+	                      s->nr_threads, s->nr_mixes,      s->nr_ops};
+	const int nr_dims = sizeof(counts) / sizeof(counts[0]);
+	int idx[sizeof(counts) / sizeof(counts[0])] = {};
+	struct matrix_config cfg = {.spec = s};
+	int d, err;
+
+	do {
+		cfg.geom.map = s->maps[idx[0]];
+		cfg.geom.flags = s->flags[idx[1]];
+		cfg.geom.entries = s->entries[idx[2]];
+		cfg.geom.key_size = s->key_sizes[idx[3]];
+		cfg.geom.value_size = s->value_sizes[idx[4]];
+		cfg.dist = &s->dists[idx[5]];
+		cfg.threads = s->threads[idx[6]];
+		cfg.mix = &s->mixes[idx[7]];
+		cfg.ops = s->ops[idx[8]];
+		err = matrix_run_config(c, &cfg, exiting);
+		if (err)
+			return err;
+		// 最内层维度变化最快
+		for (d = nr_dims - 1; d >= 0; d--) {
+			if (++idx[d] < counts[d])
+				break;
+			idx[d] = 0;
+		}
+	} while (d >= 0 && !*exiting);
+	return 0;
+}
+
+// 解析后的配置文件，setup 时解析，参数有误时不运行任何基准测试
+static struct matrix_spec *matrix_specs;
+static int matrix_nr_specs;
+
+static int matrix_setup(const char *path) {
+	int err;
+
+	matrix_specs = calloc(MATRIX_MAX_SPECS, sizeof(*matrix_specs));
+	if (!matrix_specs)
+		return -ENOMEM;
+	err = matrix_parse(path, matrix_specs, &matrix_nr_specs);
+	if (err) {
+		free(matrix_specs);
+		matrix_specs = NULL;
+	}
+	return err;
+}
+
+static void matrix_teardown(void) {
+	free(matrix_specs);
+	matrix_specs = NULL;
+	matrix_nr_specs = 0;
+}
+
+int bench_matrix(volatile bool *exiting) {
+	struct matrix_ctx c = {.map_fd = -1};
+	int err = 0;
+	__u64 start;
+
+	c.nr_cpus = libbpf_num_possible_cpus();
+	if (c.nr_cpus < 0)
+		return c.nr_cpus;
+	printf("%-12s %-15s %-12s %-8s %-4s %-5s %-10s %-3s %-9s %-8s %-9s %-9s "
+	       "%-9s %-9s %-8s %-6s %s\n",
+	       "MATRIX", "MAP", "FLAGS", "ENTRIES", "KEY", "VALUE", "DIST", "THR",
+	       "MIX", "OPS", "AVG(ns)", "P50(ns)", "MIN(ns)", "MAX(ns)", "Mops/s",
+	       "MISS%", "MAP");
+	start = bench_now_ns();
+	for (int i = 0; !err && i < matrix_nr_specs && !*exiting; i++)
+		err = matrix_run_spec(&c, &matrix_specs[i], exiting);
+	printf("\n%u configs in %.1fs: %u maps created, %u reused, %u skipped\n",
+	       c.nr_configs, (bench_now_ns() - start) / 1e9, c.nr_created,
+	       c.nr_reused, c.nr_skipped);
+	matrix_close_map(&c);
+	free(c.cdf);
+	return err;
+}
+
+// 矩阵中各map类型是否支持由矩阵运行时逐个配置判断
+static const struct bench_feature matrix_feats[] = {
+    BENCH_MAP(HASH),
+};
+
+BENCH_REGISTER(matrix) = {
+    .name = "matrix",
+    .key = 'f',
+    .arg = "FILE",
+    .doc = "Run the cross product of benchmark configurations declared in FILE",
+    .feats = matrix_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(matrix_feats),
+    .schema = "matrix,map,map_type,map_flags,max_entries,key_size,value_size,"
+              "dist,threads,mix,lookup_pct,update_pct,delete_pct,ops,reps,"
+              "avg_ns,p50_ns,min_ns,max_ns,mops,misses,map_setup",
+    .setup = matrix_setup,
+    .run = bench_matrix,
+    .teardown = matrix_teardown,
+};
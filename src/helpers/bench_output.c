@@ -0,0 +1,402 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Structured CSV / JSON-lines output with run metadata.
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_timer.h"
+#include <bpf/libbpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef BENCH_GIT_REV
+#define BENCH_GIT_REV "unknown"
+#endif
+
+// 每条记录都携带的运行元数据
+static struct {
+	char run_id[32];
+	char host[64];
+	char kernel[128];
+	char arch[32];
+	char cpu_model[128];
+	long online_cpus;
+	int possible_cpus;
+	char governor[32];
+	char jit[8];
+	const char *git_rev;
+	const char *load;
+} meta = {.load = "none"};
+
+// 每个基准测试(或元数据记录流)写一个CSV文件，表头只在文件开头出现一次
+struct csv_out {
+	char bench[32];
+	FILE *f;
+	// 已注册的基准测试按 schema 排列列，缺少的字段留空
+	const struct bench_desc *desc;
+	// 未注册的记录流(env、load 等)以第一条记录的字段作为表头
+	char keys[1024];
+	bool mismatch_warned;
+};
+
+// -c 指定的路径，实际文件为 <路径去掉 .csv>.<bench>.csv
+static char *csv_base;
+static struct csv_out csv_outs[BENCH_MAX];
+static int nr_csv_outs;
+// 正在写入的CSV文件
+static FILE *csv_file;
+static FILE *json_file;
+
+// 读取文件第一行，失败时填入 "unknown"
+static void read_line(const char *path, char *buf, size_t size) {
+	FILE *f = fopen(path, "r");
+
+	snprintf(buf, size, "unknown");
+	if (!f)
+		return;
+	if (fgets(buf, size, f))
+		buf[strcspn(buf, "\n")] = '\0';
+	fclose(f);
+}
+
+// x86 为 "model name"，arm64 没有型号字符串时退回 "CPU part"
+static void read_cpu_model(char *buf, size_t size) {
+	static const char *const keys[] = {"model name", "Model", "CPU part"};
+	char line[256], *colon;
+	FILE *f;
+
+	snprintf(buf, size, "unknown");
+	for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++) {
+		f = fopen("/proc/cpuinfo", "r");
+		if (!f)
+			return;
+		while (fgets(line, sizeof(line), f)) {
+			if (strncmp(line, keys[k], strlen(keys[k])) ||
+			    !(colon = strchr(line, ':')))
+				continue;
+			colon += strspn(colon + 1, " \t") + 1;
+			colon[strcspn(colon, "\n")] = '\0';
+			snprintf(buf, size, "%s", colon);
+			fclose(f);
+			return;
+		}
+		fclose(f);
+	}
+}
+
+static void collect_meta(void) {
+	struct utsname uts;
+
+	snprintf(meta.run_id, sizeof(meta.run_id), "%ld-%d", (long)time(NULL),
+	         getpid());
+	if (!uname(&uts)) {
+		snprintf(meta.host, sizeof(meta.host), "%.*s",
+		         (int)sizeof(meta.host) - 1, uts.nodename);
+		snprintf(meta.kernel, sizeof(meta.kernel), "%s", uts.release);
+		snprintf(meta.arch, sizeof(meta.arch), "%.*s",
+		         (int)sizeof(meta.arch) - 1, uts.machine);
+	}
+	read_cpu_model(meta.cpu_model, sizeof(meta.cpu_model));
+	meta.online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	meta.possible_cpus = libbpf_num_possible_cpus();
+	read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor",
+	          meta.governor, sizeof(meta.governor));
+	read_line("/proc/sys/net/core/bpf_jit_enable", meta.jit, sizeof(meta.jit));
+	meta.git_rev = BENCH_GIT_REV;
+}
+
+int bench_output_open(const char *csv_path, const char *json_path) {
+	size_t len;
+
+	collect_meta();
+	if (csv_path) {
+		csv_base = strdup(csv_path);
+		if (!csv_base)
+			return -ENOMEM;
+		len = strlen(csv_base);
+		if (len > 4 && !strcmp(csv_base + len - 4, ".csv"))
+			csv_base[len - 4] = '\0';
+	}
+	if (json_path) {
+		json_file = fopen(json_path, "w");
+		if (!json_file) {
+			int err = -errno;
+			bench_output_close();
+			return err;
+		}
+	}
+	return 0;
+}
+
+void bench_output_close(void) {
+	for (int i = 0; i < nr_csv_outs; i++) {
+		if (csv_outs[i].f)
+			fclose(csv_outs[i].f);
+	}
+	nr_csv_outs = 0;
+	free(csv_base);
+	if (json_file)
+		fclose(json_file);
+	csv_base = NULL;
+	csv_file = json_file = NULL;
+}
+
+bool bench_output_enabled(void) { return csv_base || json_file; }
+
+void bench_output_set_load(const char *spec) { meta.load = spec; }
+
+static void csv_str(const char *s) {
+	// 含逗号、引号或换行时加引号，内部引号写两遍
+	if (!strpbrk(s, ",\"\n")) {
+		fputs(s, csv_file);
+		return;
+	}
+	fputc('"', csv_file);
+	for (; *s; s++) {
+		if (*s == '"')
+			fputc('"', csv_file);
+		fputc(*s, csv_file);
+	}
+	fputc('"', csv_file);
+}
+
+static void json_str(const char *s) {
+	fputc('"', json_file);
+	for (; *s; s++) {
+		if (*s == '"' || *s == '\\')
+			fprintf(json_file, "\\%c", *s);
+		else if ((unsigned char)*s < 0x20)
+			fprintf(json_file, "\\u%04x", *s);
+		else
+			fputc(*s, json_file);
+	}
+	fputc('"', json_file);
+}
+
+// 元数据字段，CSV 与 JSON 共用
+#define META_FIELDS(bench, ts_ns)                                              \
+	BF_STR("bench", bench), BF_STR("run_id", meta.run_id),                     \
+	    BF_U64("ts_ns", ts_ns), BF_STR("host", meta.host),                     \
+	    BF_STR("kernel", meta.kernel), BF_STR("arch", meta.arch),              \
+	    BF_STR("cpu_model", meta.cpu_model),                                   \
+	    BF_I64("online_cpus", meta.online_cpus),                               \
+	    BF_I64("possible_cpus", meta.possible_cpus),                           \
+	    BF_STR("governor", meta.governor), BF_STR("jit", meta.jit),            \
+	    BF_STR("git_rev", meta.git_rev), BF_STR("load", meta.load),          \
+	    BF_STR("timer", bench_timer_name())
+
+static void csv_value(const struct bench_field *f) {
+	switch (f->type) {
+	case BENCH_F_STR:
+		csv_str(f->s ? f->s : "");
+		break;
+	case BENCH_F_U64:
+		fprintf(csv_file, "%llu", (unsigned long long)f->u);
+		break;
+	case BENCH_F_I64:
+		fprintf(csv_file, "%lld", (long long)f->i);
+		break;
+	case BENCH_F_F64:
+		if (!isnan(f->f))
+			fprintf(csv_file, "%.3f", f->f);
+		break;
+	}
+}
+
+static void json_value(const struct bench_field *f) {
+	switch (f->type) {
+	case BENCH_F_STR:
+		json_str(f->s ? f->s : "");
+		break;
+	case BENCH_F_U64:
+		fprintf(json_file, "%llu", (unsigned long long)f->u);
+		break;
+	case BENCH_F_I64:
+		fprintf(json_file, "%lld", (long long)f->i);
+		break;
+	case BENCH_F_F64:
+		if (isnan(f->f) || isinf(f->f))
+			fputs("null", json_file);
+		else
+			fprintf(json_file, "%.3f", f->f);
+		break;
+	}
+}
+
+// 返回基准测试对应的CSV文件，首次写入时创建文件并写表头；失败返回NULL
+static struct csv_out *csv_open(const char *bench,
+                                const struct bench_field *meta_f, int nr_meta,
+                                const struct bench_field *fields, int nr) {
+	struct csv_out *o;
+	char path[4096];
+
+	for (int i = 0; i < nr_csv_outs; i++) {
+		if (!strcmp(csv_outs[i].bench, bench))
+			return csv_outs[i].f ? &csv_outs[i] : NULL;
+	}
+	if (nr_csv_outs >= BENCH_MAX)
+		return NULL;
+	o = &csv_outs[nr_csv_outs++];
+	memset(o, 0, sizeof(*o));
+	snprintf(o->bench, sizeof(o->bench), "%s", bench);
+	snprintf(path, sizeof(path), "%s.%s.csv", csv_base, bench);
+	// 打开失败只提示一次，之后该基准测试的记录只写入 JSON
+	o->f = fopen(path, "w");
+	if (!o->f) {
+		fprintf(stderr, "Failed to open %s: %d\n", path, -errno);
+		return NULL;
+	}
+	o->desc = bench_find(bench);
+	if (o->desc && !o->desc->schema)
+		o->desc = NULL;
+	for (int i = 0; i < nr_meta; i++)
+		fprintf(o->f, "%s,", meta_f[i].key);
+	if (o->desc) {
+		fprintf(o->f, "%s\n", o->desc->schema);
+		return o;
+	}
+	for (int i = 0; i < nr; i++) {
+		strncat(o->keys, fields[i].key, sizeof(o->keys) - strlen(o->keys) - 1);
+		if (i + 1 < nr)
+			strncat(o->keys, ",", sizeof(o->keys) - strlen(o->keys) - 1);
+	}
+	fprintf(o->f, "%s\n", o->keys);
+	return o;
+}
+
+// 未注册的记录流每条记录的字段须与表头一致
+static bool csv_keys_match(const struct csv_out *o,
+                           const struct bench_field *fields, int nr) {
+	const char *p = o->keys;
+	size_t len;
+
+	for (int i = 0; i < nr; i++) {
+		len = strlen(fields[i].key);
+		if (strncmp(p, fields[i].key, len) || (p[len] != ',' && p[len]))
+			return false;
+		p += len + (p[len] == ',');
+	}
+	return !*p;
+}
+
+static void csv_record(const char *bench, const struct bench_field *meta_f,
+                       int nr_meta, const struct bench_field *fields, int nr) {
+	struct csv_out *o = csv_open(bench, meta_f, nr_meta, fields, nr);
+	const char *p;
+	size_t len;
+	int i;
+
+	if (!o)
+		return;
+	if (!o->desc && !csv_keys_match(o, fields, nr)) {
+		// 同一个文件里不能出现第二个表头，字段不同的记录只写入 JSON
+		if (!o->mismatch_warned)
+			fprintf(stderr,
+			        "Warning: %s record fields differ from its CSV header, "
+			        "not written to CSV\n",
+			        bench);
+		o->mismatch_warned = true;
+		return;
+	}
+	csv_file = o->f;
+	for (i = 0; i < nr_meta; i++) {
+		csv_value(&meta_f[i]);
+		fputc(',', csv_file);
+	}
+	if (!o->desc) {
+		for (i = 0; i < nr; i++) {
+			csv_value(&fields[i]);
+			fputc(i + 1 < nr ? ',' : '\n', csv_file);
+		}
+		fflush(csv_file);
+		return;
+	}
+	// 按 schema 的列顺序输出，记录中没有的字段留空
+	for (p = o->desc->schema; *p; p += len + (p[len] == ',')) {
+		len = strcspn(p, ",");
+		for (i = 0; i < nr; i++) {
+			if (strlen(fields[i].key) == len &&
+			    !strncmp(fields[i].key, p, len)) {
+				csv_value(&fields[i]);
+				break;
+			}
+		}
+		fputc(p[len] == ',' ? ',' : '\n', csv_file);
+	}
+	fflush(csv_file);
+}
+
+static void json_record(const struct bench_field *meta_f, int nr_meta,
+                        const struct bench_field *fields, int nr) {
+	fputc('{', json_file);
+	for (int i = 0; i < nr_meta + nr; i++) {
+		const struct bench_field *f =
+		    i < nr_meta ? &meta_f[i] : &fields[i - nr_meta];
+
+		if (i)
+			fputc(',', json_file);
+		json_str(f->key);
+		fputc(':', json_file);
+		json_value(f);
+	}
+	fputs("}\n", json_file);
+	fflush(json_file);
+}
+
+// 已注册的基准测试写出 schema 之外的字段时提示一次，便于下游按 schema 解析
+static void output_check_schema(const char *bench,
+                                const struct bench_field *fields, int nr) {
+	static const struct bench_desc *warned[BENCH_MAX];
+	static int nr_warned;
+	const struct bench_desc *b = bench_find(bench);
+
+	if (!b || !b->schema)
+		return;
+	for (int i = 0; i < nr_warned; i++) {
+		if (warned[i] == b)
+			return;
+	}
+	for (int i = 0; i < nr; i++) {
+		if (bench_schema_has(b, fields[i].key))
+			continue;
+		fprintf(stderr, "Warning: %s result field %s is not in its schema\n",
+		        bench, fields[i].key);
+		if (nr_warned < BENCH_MAX)
+			warned[nr_warned++] = b;
+		return;
+	}
+}
+
+void bench_output(const char *bench, const struct bench_field *fields,
+                  int nr) {
+	struct timespec ts;
+	__u64 ts_ns;
+
+	if (!bench_output_enabled())
+		return;
+	output_check_schema(bench, fields, nr);
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts_ns = (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+	const struct bench_field meta_f[] = {META_FIELDS(bench, ts_ns)};
+	int nr_meta = sizeof(meta_f) / sizeof(meta_f[0]);
+
+	if (csv_base)
+		csv_record(bench, meta_f, nr_meta, fields, nr);
+	if (json_file)
+		json_record(meta_f, nr_meta, fields, nr);
+}
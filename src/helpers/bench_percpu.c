@@ -0,0 +1,363 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Reduction of per-CPU map values read from user space.
+#include "bench_percpu.h"
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PC_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__)
+#define PC_NEON 1
+#include <arm_neon.h>
+#endif
+
+// 对一批key做归约。求和与无符号取最大值的单位元都是0，
+// 各实现都从全0的累加器开始
+typedef void (*pc_fn)(const __u64 *v, __u32 nr_keys, __u32 nr_cpus,
+                      __u32 width, __u64 *out);
+
+// 默认实现从该CPU数起才使用 SIMD
+#define PC_SIMD_MIN_CPUS 8
+
+#define PC_ADD(a, b) ((a) + (b))
+#define PC_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+// 标量基线要保持逐个元素处理，关掉编译器的自动向量化
+#if defined(__clang__)
+#define PC_SCALAR_ATTR
+#define PC_SCALAR_LOOP                                                         \
+	_Pragma("clang loop vectorize(disable) interleave(disable)")
+#elif defined(__GNUC__)
+#define PC_SCALAR_ATTR __attribute__((optimize("no-tree-vectorize")))
+#define PC_SCALAR_LOOP
+#else
+#define PC_SCALAR_ATTR
+#define PC_SCALAR_LOOP
+#endif
+
+// 只有一个u64时在CPU方向上连续归约；否则逐个slot按元素归约到out，
+// 与常见的导出程序写法相同
+#define PC_PLAIN_DEFINE(name, OP, ATTR, LOOP)                                  \
+	static ATTR void name(const __u64 *restrict v, __u32 nr_keys,              \
+	                      __u32 nr_cpus, __u32 width, __u64 *restrict out) {   \
+		for (__u32 k = 0; k < nr_keys; k++) {                                  \
+			if (width == 1) {                                                  \
+				__u64 acc = 0;                                                 \
+				LOOP                                                           \
+				for (__u32 c = 0; c < nr_cpus; c++)                            \
+					acc = OP(acc, v[c]);                                       \
+				out[0] = acc;                                                  \
+			} else {                                                           \
+				LOOP                                                           \
+				for (__u32 i = 0; i < width; i++)                              \
+					out[i] = v[i];                                             \
+				for (__u32 c = 1; c < nr_cpus; c++) {                          \
+					const __u64 *slot = v + (size_t)c * width;                 \
+					LOOP                                                       \
+					for (__u32 i = 0; i < width; i++)                          \
+						out[i] = OP(out[i], slot[i]);                          \
+				}                                                              \
+			}                                                                  \
+			v += (size_t)nr_cpus * width;                                      \
+			out += width;                                                      \
+		}                                                                      \
+	}
+
+PC_PLAIN_DEFINE(pc_scalar_sum, PC_ADD, PC_SCALAR_ATTR, PC_SCALAR_LOOP)
+PC_PLAIN_DEFINE(pc_scalar_max, PC_MAX, PC_SCALAR_ATTR, PC_SCALAR_LOOP)
+PC_PLAIN_DEFINE(pc_auto_sum, PC_ADD, , )
+PC_PLAIN_DEFINE(pc_auto_max, PC_MAX, , )
+
+#ifdef PC_X86
+#define PC_AVX2 __attribute__((target("avx2")))
+#define PC_AVX512 __attribute__((target("avx512f")))
+
+static inline PC_AVX2 __m256i pc_avx2_vadd(__m256i a, __m256i b) {
+	return _mm256_add_epi64(a, b);
+}
+
+// AVX2 没有无符号64位比较，翻转符号位后用有符号比较
+static inline PC_AVX2 __m256i pc_avx2_vmax(__m256i a, __m256i b) {
+	const __m256i sign = _mm256_set1_epi64x((long long)(1ULL << 63));
+	__m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign),
+	                                _mm256_xor_si256(b, sign));
+	return _mm256_blendv_epi8(b, a, gt);
+}
+
+#define PC_LOAD256(p) _mm256_loadu_si256((const __m256i *)(p))
+
+// width 为1时用两个累加器隐藏依赖链；否则每次在寄存器里累加16个u64
+// (一个直方图的常见桶数)，每个slot只读一遍
+#define PC_AVX2_DEFINE(name, VOP, OP)                                          \
+	static PC_AVX2 void name(const __u64 *v, __u32 nr_keys, __u32 nr_cpus,     \
+	                         __u32 width, __u64 *out) {                        \
+		for (__u32 k = 0; k < nr_keys; k++) {                                  \
+			__u32 c = 0, i = 0;                                                \
+			if (width == 1) {                                                  \
+				__m256i a0 = _mm256_setzero_si256(), a1 = a0;                  \
+				__u64 lanes[4], acc;                                           \
+				for (; c + 8 <= nr_cpus; c += 8) {                             \
+					a0 = VOP(a0, PC_LOAD256(v + c));                           \
+					a1 = VOP(a1, PC_LOAD256(v + c + 4));                       \
+				}                                                              \
+				if (c + 4 <= nr_cpus) {                                        \
+					a0 = VOP(a0, PC_LOAD256(v + c));                           \
+					c += 4;                                                    \
+				}                                                              \
+				_mm256_storeu_si256((__m256i *)lanes, VOP(a0, a1));            \
+				acc = OP(OP(lanes[0], lanes[1]), OP(lanes[2], lanes[3]));      \
+				for (; c < nr_cpus; c++)                                       \
+					acc = OP(acc, v[c]);                                       \
+				out[0] = acc;                                                  \
+				goto next;                                                     \
+			}                                                                  \
+			for (; i + 16 <= width; i += 16) {                                 \
+				__m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0,         \
+				        a3 = a0;                                               \
+				for (c = 0; c < nr_cpus; c++) {                                \
+					const __u64 *p = v + (size_t)c * width + i;                \
+					a0 = VOP(a0, PC_LOAD256(p));                               \
+					a1 = VOP(a1, PC_LOAD256(p + 4));                           \
+					a2 = VOP(a2, PC_LOAD256(p + 8));                           \
+					a3 = VOP(a3, PC_LOAD256(p + 12));                          \
+				}                                                              \
+				_mm256_storeu_si256((__m256i *)(out + i), a0);                 \
+				_mm256_storeu_si256((__m256i *)(out + i + 4), a1);             \
+				_mm256_storeu_si256((__m256i *)(out + i + 8), a2);             \
+				_mm256_storeu_si256((__m256i *)(out + i + 12), a3);            \
+			}                                                                  \
+			for (; i + 4 <= width; i += 4) {                                   \
+				__m256i a = _mm256_setzero_si256();                            \
+				for (c = 0; c < nr_cpus; c++)                                  \
+					a = VOP(a, PC_LOAD256(v + (size_t)c * width + i));         \
+				_mm256_storeu_si256((__m256i *)(out + i), a);                  \
+			}                                                                  \
+			for (; i < width; i++) {                                           \
+				__u64 acc = 0;                                                 \
+				for (c = 0; c < nr_cpus; c++)                                  \
+					acc = OP(acc, v[(size_t)c * width + i]);                   \
+				out[i] = acc;                                                  \
+			}                                                                  \
+		next:                                                                  \
+			v += (size_t)nr_cpus * width;                                      \
+			out += width;                                                      \
+		}                                                                      \
+	}
+
+PC_AVX2_DEFINE(pc_avx2_sum, pc_avx2_vadd, PC_ADD)
+PC_AVX2_DEFINE(pc_avx2_max, pc_avx2_vmax, PC_MAX)
+
+// 剩余 left 个u64时一个 zmm 寄存器可用的lane
+static inline __mmask8 pc_avx512_mask(__u32 left) {
+	return left >= 8 ? 0xff : (__mmask8)((1u << left) - 1);
+}
+
+// AVX-512F 直接提供无符号最大值与横向归约；尾部用掩码加载补0
+#define PC_AVX512_DEFINE(name, VOP, HOP)                                       \
+	static PC_AVX512 void name(const __u64 *v, __u32 nr_keys, __u32 nr_cpus,   \
+	                           __u32 width, __u64 *out) {                      \
+		for (__u32 k = 0; k < nr_keys; k++) {                                  \
+			__u32 c = 0;                                                       \
+			if (width == 1) {                                                  \
+				__m512i a0 = _mm512_setzero_si512(), a1 = a0;                  \
+				for (; c + 16 <= nr_cpus; c += 16) {                           \
+					a0 = VOP(a0, _mm512_loadu_si512(v + c));                   \
+					a1 = VOP(a1, _mm512_loadu_si512(v + c + 8));               \
+				}                                                              \
+				for (; c < nr_cpus; c += 8)                                    \
+					a0 = VOP(a0, _mm512_maskz_loadu_epi64(                     \
+					                 pc_avx512_mask(nr_cpus - c), v + c));     \
+				out[0] = HOP(VOP(a0, a1));                                     \
+			} else {                                                           \
+				for (__u32 i = 0; i < width; i += 16) {                        \
+					__mmask8 m0 = pc_avx512_mask(width - i);                   \
+					__mmask8 m1 =                                              \
+					    width - i > 8 ? pc_avx512_mask(width - i - 8) : 0;     \
+					__m512i a0 = _mm512_setzero_si512(), a1 = a0;              \
+					for (c = 0; c < nr_cpus; c++) {                            \
+						const __u64 *p = v + (size_t)c * width + i;            \
+						a0 = VOP(a0, _mm512_maskz_loadu_epi64(m0, p));         \
+						a1 = VOP(a1, _mm512_maskz_loadu_epi64(m1, p + 8));     \
+					}                                                          \
+					_mm512_mask_storeu_epi64(out + i, m0, a0);                 \
+					_mm512_mask_storeu_epi64(out + i + 8, m1, a1);             \
+				}                                                              \
+			}                                                                  \
+			v += (size_t)nr_cpus * width;                                      \
+			out += width;                                                      \
+		}                                                                      \
+	}
+
+PC_AVX512_DEFINE(pc_avx512_sum, _mm512_add_epi64, _mm512_reduce_add_epi64)
+PC_AVX512_DEFINE(pc_avx512_max, _mm512_max_epu64, _mm512_reduce_max_epu64)
+#endif /* PC_X86 */
+
+#ifdef PC_NEON
+static inline uint64x2_t pc_neon_vmax(uint64x2_t a, uint64x2_t b) {
+	return vbslq_u64(vcgtq_u64(a, b), a, b);
+}
+
+static inline __u64 pc_neon_hsum(uint64x2_t a) { return vaddvq_u64(a); }
+
+static inline __u64 pc_neon_hmax(uint64x2_t a) {
+	__u64 x = vgetq_lane_u64(a, 0), y = vgetq_lane_u64(a, 1);
+	return PC_MAX(x, y);
+}
+
+// aarch64 上 uint64_t 是 unsigned long，与 __u64 的指针类型不同
+#define PC_LOAD128(p) vld1q_u64((const uint64_t *)(p))
+#define PC_STORE128(p, a) vst1q_u64((uint64_t *)(p), a)
+
+// 与 AVX2 相同的结构，寄存器宽度为2个u64，每次在寄存器里累加8个
+#define PC_NEON_DEFINE(name, VOP, HOP, OP)                                     \
+	static void name(const __u64 *v, __u32 nr_keys, __u32 nr_cpus,             \
+	                 __u32 width, __u64 *out) {                                \
+		for (__u32 k = 0; k < nr_keys; k++) {                                  \
+			__u32 c = 0, i = 0;                                                \
+			if (width == 1) {                                                  \
+				uint64x2_t a0 = vdupq_n_u64(0), a1 = a0, a2 = a0, a3 = a0;     \
+				__u64 acc;                                                     \
+				for (; c + 8 <= nr_cpus; c += 8) {                             \
+					a0 = VOP(a0, PC_LOAD128(v + c));                           \
+					a1 = VOP(a1, PC_LOAD128(v + c + 2));                       \
+					a2 = VOP(a2, PC_LOAD128(v + c + 4));                       \
+					a3 = VOP(a3, PC_LOAD128(v + c + 6));                       \
+				}                                                              \
+				for (; c + 2 <= nr_cpus; c += 2)                               \
+					a0 = VOP(a0, PC_LOAD128(v + c));                           \
+				acc = HOP(VOP(VOP(a0, a1), VOP(a2, a3)));                      \
+				for (; c < nr_cpus; c++)                                       \
+					acc = OP(acc, v[c]);                                       \
+				out[0] = acc;                                                  \
+				goto next;                                                     \
+			}                                                                  \
+			for (; i + 8 <= width; i += 8) {                                   \
+				uint64x2_t a0 = vdupq_n_u64(0), a1 = a0, a2 = a0, a3 = a0;     \
+				for (c = 0; c < nr_cpus; c++) {                                \
+					const __u64 *p = v + (size_t)c * width + i;                \
+					a0 = VOP(a0, PC_LOAD128(p));                               \
+					a1 = VOP(a1, PC_LOAD128(p + 2));                           \
+					a2 = VOP(a2, PC_LOAD128(p + 4));                           \
+					a3 = VOP(a3, PC_LOAD128(p + 6));                           \
+				}                                                              \
+				PC_STORE128(out + i, a0);                                      \
+				PC_STORE128(out + i + 2, a1);                                  \
+				PC_STORE128(out + i + 4, a2);                                  \
+				PC_STORE128(out + i + 6, a3);                                  \
+			}                                                                  \
+			for (; i + 2 <= width; i += 2) {                                   \
+				uint64x2_t a = vdupq_n_u64(0);                                 \
+				for (c = 0; c < nr_cpus; c++)                                  \
+					a = VOP(a, PC_LOAD128(v + (size_t)c * width + i));         \
+				PC_STORE128(out + i, a);                                       \
+			}                                                                  \
+			for (; i < width; i++) {                                           \
+				__u64 acc = 0;                                                 \
+				for (c = 0; c < nr_cpus; c++)                                  \
+					acc = OP(acc, v[(size_t)c * width + i]);                   \
+				out[i] = acc;                                                  \
+			}                                                                  \
+		next:                                                                  \
+			v += (size_t)nr_cpus * width;                                      \
+			out += width;                                                      \
+		}                                                                      \
+	}
+
+PC_NEON_DEFINE(pc_neon_sum, vaddq_u64, pc_neon_hsum, PC_ADD)
+PC_NEON_DEFINE(pc_neon_max, pc_neon_vmax, pc_neon_hmax, PC_MAX)
+#endif /* PC_NEON */
+
+static const struct pc_impl {
+	const char *name;
+	pc_fn fns[2];
+} pc_impls[BENCH_PERCPU_NR_IMPLS] = {
+    [BENCH_PERCPU_SCALAR] = {"scalar", {pc_scalar_sum, pc_scalar_max}},
+    [BENCH_PERCPU_AUTO] = {"auto", {pc_auto_sum, pc_auto_max}},
+#ifdef PC_X86
+    [BENCH_PERCPU_AVX2] = {"avx2", {pc_avx2_sum, pc_avx2_max}},
+    [BENCH_PERCPU_AVX512] = {"avx512", {pc_avx512_sum, pc_avx512_max}},
+#else
+    [BENCH_PERCPU_AVX2] = {"avx2", {NULL, NULL}},
+    [BENCH_PERCPU_AVX512] = {"avx512", {NULL, NULL}},
+#endif
+#ifdef PC_NEON
+    [BENCH_PERCPU_NEON] = {"neon", {pc_neon_sum, pc_neon_max}},
+#else
+    [BENCH_PERCPU_NEON] = {"neon", {NULL, NULL}},
+#endif
+};
+
+const char *bench_percpu_impl_name(enum bench_percpu_impl impl) {
+	return impl < BENCH_PERCPU_NR_IMPLS ? pc_impls[impl].name : "unknown";
+}
+
+bool bench_percpu_impl_supported(enum bench_percpu_impl impl) {
+	if (impl >= BENCH_PERCPU_NR_IMPLS || !pc_impls[impl].fns[0])
+		return false;
+#ifdef PC_X86
+	if (impl == BENCH_PERCPU_AVX2)
+		return __builtin_cpu_supports("avx2");
+	if (impl == BENCH_PERCPU_AVX512)
+		return __builtin_cpu_supports("avx512f");
+#endif
+	return true;
+}
+
+enum bench_percpu_impl bench_percpu_best(void) {
+	static int best = -1;
+
+	if (best < 0) {
+		static const enum bench_percpu_impl order[] = {
+		    BENCH_PERCPU_AVX512,
+		    BENCH_PERCPU_AVX2,
+		    BENCH_PERCPU_NEON,
+		};
+
+		best = BENCH_PERCPU_AUTO;
+		for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+			if (bench_percpu_impl_supported(order[i])) {
+				best = order[i];
+				break;
+			}
+		}
+	}
+	return best;
+}
+
+void bench_percpu_reduce_impl(enum bench_percpu_impl impl,
+                              enum bench_percpu_op op, const __u64 *values,
+                              __u32 nr_keys, __u32 nr_cpus, __u32 width,
+                              __u64 *out) {
+	// 不支持的实现退回到编译器向量化的版本
+	if (!bench_percpu_impl_supported(impl))
+		impl = BENCH_PERCPU_AUTO;
+	if (!nr_cpus) {
+		for (size_t i = 0; i < (size_t)nr_keys * width; i++)
+			out[i] = 0;
+		return;
+	}
+	pc_impls[impl].fns[op == BENCH_PERCPU_MAX](values, nr_keys, nr_cpus, width,
+	                                           out);
+}
+
+void bench_percpu_reduce(enum bench_percpu_op op, const __u64 *values,
+                         __u32 nr_keys, __u32 nr_cpus, __u32 width,
+                         __u64 *out) {
+	// CPU很少时每个key只有几个值，横向归约与尾部处理的开销超过向量化的收益
+	enum bench_percpu_impl impl =
+	    nr_cpus < PC_SIMD_MIN_CPUS ? BENCH_PERCPU_AUTO : bench_percpu_best();
+
+	bench_percpu_reduce_impl(impl, op, values, nr_keys, nr_cpus, width, out);
+}
@@ -0,0 +1,265 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Per-CPU value aggregation benchmark.
+#include "bench_percpu_agg.h"
+#include "bench_features.h"
+#include "bench_output.h"
+#include "bench_percpu.h"
+#include "bench_registry.h"
+#include "bench_util.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 每种实现计时的次数(另有一次预热)，取中位数
+#define PA_RUNS 9
+// 每次计时至少归约的数据量，小的批次重复多次
+#define PA_SAMPLE_BYTES (64ULL << 20)
+// 直方图的桶数
+#define PA_BUCKETS 16
+// 真实map的条目数
+#define PA_MAP_KEYS 1024
+
+// 合成数据模拟的CPU个数，lookup 返回的是全部可能的CPU
+static const __u32 pa_cpus[] = {8, 16, 32, 64, 128, 192, 256, 512};
+
+static const struct pa_op {
+	const char *name;
+	enum bench_percpu_op op;
+	// 每个CPU的u64个数
+	__u32 width;
+	// 每批key数，512个CPU时一批为4MB
+	__u32 keys;
+} pa_ops[] = {
+    {"sum", BENCH_PERCPU_SUM, 1, 1024},
+    {"max", BENCH_PERCPU_MAX, 1, 1024},
+    {"hist", BENCH_PERCPU_SUM, PA_BUCKETS, 64},
+};
+
+// 计时 impl 对一批key的归约，返回每个key耗时的中位数(ns)
+static double pa_time(enum bench_percpu_impl impl, const struct pa_op *op,
+                      const __u64 *values, __u32 keys, __u32 nr_cpus,
+                      __u64 *out) {
+	size_t bytes = (size_t)keys * nr_cpus * op->width * sizeof(__u64);
+	__u64 reps = PA_SAMPLE_BYTES / bytes, samples[PA_RUNS], start;
+	struct bench_lat lat;
+
+	if (!reps)
+		reps = 1;
+	bench_percpu_reduce_impl(impl, op->op, values, keys, nr_cpus, op->width,
+	                         out);
+	for (int r = 0; r < PA_RUNS; r++) {
+		start = bench_now_ns();
+		for (__u64 i = 0; i < reps; i++)
+			bench_percpu_reduce_impl(impl, op->op, values, keys, nr_cpus,
+			                         op->width, out);
+		samples[r] = bench_now_ns() - start;
+	}
+	bench_lat_summarize(NULL, samples, PA_RUNS, &lat);
+	return lat.p50 / reps / keys;
+}
+
+// 计数器与直方图的值，高位留空以免求和溢出
+static void pa_fill_random(__u64 *values, size_t nr) {
+	__u64 x = 0x9e3779b97f4a7c15ULL;
+
+	for (size_t i = 0; i < nr; i++) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		values[i] = x >> 24;
+	}
+}
+
+static void pa_print(const char *phase, const struct pa_op *op, __u32 nr_cpus,
+                     __u32 keys, enum bench_percpu_impl impl, double ns,
+                     double scalar_ns, double lookup_ns, bool match) {
+	double bytes = (double)nr_cpus * op->width * sizeof(__u64);
+	const char *name = bench_percpu_impl_name(impl);
+	char lookup[32] = "-";
+
+	// 合成数据没有读取map的开销
+	if (!isnan(lookup_ns))
+		snprintf(lookup, sizeof(lookup), "%.2f", lookup_ns);
+	printf("%-9s %-5s %-5u %-8s %-9.2f %-8.2f %-8.2f %-10s %s\n", phase,
+	       op->name, nr_cpus, name, ns, bytes / ns, scalar_ns / ns, lookup,
+	       match ? "ok" : "mismatch");
+	fflush(stdout);
+	BENCH_OUTPUT("percpu_agg", BF_STR("phase", phase), BF_STR("op", op->name),
+	             BF_STR("impl", name), BF_U64("cpus", nr_cpus),
+	             BF_U64("width", op->width), BF_U64("keys", keys),
+	             BF_F64("ns_per_key", ns), BF_F64("gb_per_s", bytes / ns),
+	             BF_F64("speedup", scalar_ns / ns),
+	             BF_F64("lookup_ns_per_key", lookup_ns),
+	             BF_STR("status", match ? "ok" : "mismatch"));
+}
+
+// 按 impl 归约并与标量结果比较，输出一行
+static void pa_measure(const char *phase, const struct pa_op *op,
+                       const __u64 *values, __u32 keys, __u32 nr_cpus,
+                       double lookup_ns, __u64 *ref, __u64 *out) {
+	size_t out_bytes = (size_t)keys * op->width * sizeof(__u64);
+	double scalar_ns, ns;
+
+	scalar_ns = pa_time(BENCH_PERCPU_SCALAR, op, values, keys, nr_cpus, ref);
+	pa_print(phase, op, nr_cpus, keys, BENCH_PERCPU_SCALAR, scalar_ns,
+	         scalar_ns, lookup_ns, true);
+	for (int i = BENCH_PERCPU_SCALAR + 1; i < BENCH_PERCPU_NR_IMPLS; i++) {
+		if (!bench_percpu_impl_supported(i))
+			continue;
+		memset(out, 0, out_bytes);
+		ns = pa_time(i, op, values, keys, nr_cpus, out);
+		pa_print(phase, op, nr_cpus, keys, i, ns, scalar_ns, lookup_ns,
+		         !memcmp(out, ref, out_bytes));
+	}
+}
+
+// 用 lookup_batch 读出整个map，返回读到的条目数或负的错误码
+static long long pa_lookup_all(int fd, __u32 *keys, __u64 *values,
+                               size_t stride) {
+	LIBBPF_OPTS(bpf_map_batch_opts, opts);
+	__u32 in_batch, out_batch, count;
+	long long nr = 0;
+	int err;
+
+	do {
+		count = PA_MAP_KEYS - nr;
+		err = bpf_map_lookup_batch(fd, nr ? &in_batch : NULL, &out_batch,
+		                           keys + nr, values + nr * stride, &count,
+		                           &opts);
+		nr += count;
+		in_batch = out_batch;
+	} while (!err && count && nr < PA_MAP_KEYS);
+	return !err || err == -ENOENT ? nr : err;
+}
+
+// 本机 percpu_array 上一次 lookup_batch 读出全部key，再归约每个key
+static int pa_map(const struct pa_op *op, __u32 nr_cpus, __u64 *values,
+                  __u64 *ref, __u64 *out) {
+	size_t stride = (size_t)nr_cpus * op->width;
+	__u32 keys[PA_MAP_KEYS];
+	__u64 samples[PA_RUNS], start;
+	struct bench_lat lat;
+	long long nr = 0;
+	int fd, err = 0;
+
+	fd = bpf_map_create(BPF_MAP_TYPE_PERCPU_ARRAY, "pa_map", sizeof(__u32),
+	                    op->width * sizeof(__u64), PA_MAP_KEYS, NULL);
+	if (fd < 0) {
+		fprintf(stderr, "Failed to create percpu_array: %d\n", fd);
+		return fd;
+	}
+	pa_fill_random(values, stride * PA_MAP_KEYS);
+	for (__u32 k = 0; !err && k < PA_MAP_KEYS; k++)
+		err = bpf_map_update_elem(fd, &k, values + k * stride, BPF_ANY);
+	if (err) {
+		fprintf(stderr, "Failed to fill percpu_array: %d\n", err);
+		goto out;
+	}
+
+	for (int r = 0; nr >= 0 && r <= PA_RUNS; r++) {
+		start = bench_now_ns();
+		nr = pa_lookup_all(fd, keys, values, stride);
+		// 第一次为预热
+		if (r)
+			samples[r - 1] = bench_now_ns() - start;
+	}
+	if (nr != PA_MAP_KEYS) {
+		// 旧内核不支持对每CPU map做批量查找
+		printf("%-9s %-5s %-5u lookup_batch failed: %lld\n", "map", op->name,
+		       nr_cpus, nr);
+		goto out;
+	}
+	bench_lat_summarize(NULL, samples, PA_RUNS, &lat);
+	pa_measure("map", op, values, PA_MAP_KEYS, nr_cpus,
+	           lat.p50 / PA_MAP_KEYS, ref, out);
+out:
+	close(fd);
+	return err;
+}
+
+int bench_percpu_agg(volatile bool *exiting) {
+	int possible = libbpf_num_possible_cpus();
+	size_t max_elems = 0, max_out = 0, elems;
+	__u64 *values, *ref, *out;
+	int err = 0;
+
+	if (possible < 0) {
+		fprintf(stderr, "Failed to get possible CPUs: %d\n", possible);
+		return possible;
+	}
+	for (int o = 0; o < BENCH_ARRAY_SIZE(pa_ops); o++) {
+		elems = (size_t)pa_ops[o].keys * pa_ops[o].width;
+		if (elems > max_out)
+			max_out = elems;
+		elems *= pa_cpus[BENCH_ARRAY_SIZE(pa_cpus) - 1];
+		if (elems > max_elems)
+			max_elems = elems;
+		elems = (size_t)PA_MAP_KEYS * pa_ops[o].width;
+		if (elems > max_out)
+			max_out = elems;
+		elems *= possible;
+		if (elems > max_elems)
+			max_elems = elems;
+	}
+	values = malloc(max_elems * sizeof(__u64));
+	ref = malloc(max_out * sizeof(__u64));
+	out = malloc(max_out * sizeof(__u64));
+	if (!values || !ref || !out) {
+		err = -ENOMEM;
+		goto out;
+	}
+
+	printf("possible CPUs: %d, default implementation: %s\n", possible,
+	       bench_percpu_impl_name(bench_percpu_best()));
+	printf("%-9s %-5s %-5s %-8s %-9s %-8s %-8s %-10s %s\n", "PHASE", "OP",
+	       "CPUS", "IMPL", "NS/KEY", "GB/S", "SPEEDUP", "LOOKUP/KEY", "CHECK");
+	// 合成数据: 模拟CPU很多的主机上 lookup_batch 返回的一批key
+	for (int o = 0; !*exiting && o < BENCH_ARRAY_SIZE(pa_ops); o++) {
+		const struct pa_op *op = &pa_ops[o];
+
+		for (int c = 0; !*exiting && c < BENCH_ARRAY_SIZE(pa_cpus); c++) {
+			pa_fill_random(values, (size_t)op->keys * pa_cpus[c] * op->width);
+			pa_measure("synthetic", op, values, op->keys, pa_cpus[c], NAN, ref,
+			           out);
+		}
+	}
+	// 本机: 与读取map的系统调用相比归约占多少
+	for (int o = 0; !err && !*exiting && o < BENCH_ARRAY_SIZE(pa_ops); o++)
+		err = pa_map(&pa_ops[o], possible, values, ref, out);
+out:
+	free(values);
+	free(ref);
+	free(out);
+	return err;
+}
+
+static const struct bench_feature percpu_agg_feats[] = {
+    BENCH_MAP(PERCPU_ARRAY),
+};
+
+BENCH_REGISTER(percpu_agg) = {
+    .name = "percpu_agg",
+    .key = 'G',
+    .doc = "Compare scalar and SIMD aggregation of per-CPU map values at "
+           "8-512 CPUs",
+    .feats = percpu_agg_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(percpu_agg_feats),
+    .schema = "phase,op,impl,cpus,width,keys,ns_per_key,gb_per_s,speedup,"
+              "lookup_ns_per_key,status",
+    .run = bench_percpu_agg,
+};
@@ -0,0 +1,304 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Queue and stack map benchmark.
+#include "bench_queue_stack.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_skel.h"
+#include "bench_timer.h"
+#include "bench_util.h"
+#include "queue_stack.skel.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define QS_MAX_PRODUCERS 4
+
+static const __u32 qs_capacities[] = {1024, 16384, 262144};
+static const __u32 qs_fill_pcts[] = {0, 25, 50, 75, 100};
+
+enum qs_op {
+	QS_PUSH,
+	QS_POP,
+	QS_PEEK,
+	QS_OP_MAX,
+};
+// 用户态 pop 即 BPF_MAP_LOOKUP_AND_DELETE_ELEM，peek 即 BPF_MAP_LOOKUP_ELEM
+static const char *qs_kernel_ops[QS_OP_MAX] = {"push", "pop", "peek"};
+static const char *qs_user_ops[QS_OP_MAX] = {"push", "lookup_and_delete",
+                                             "peek"};
+
+struct qs_map {
+	const char *name;
+	int fd;
+	int prog_fds[QS_OP_MAX];
+};
+
+struct qs_worker {
+	int fd; // 用户态为map fd，内核态为程序fd
+	enum qs_op op;
+	bool kernel;
+	__u32 ops;
+	__u64 *samples;
+	__u64 kern_avg_ns;
+	int err;
+};
+
+static void *qs_worker_fn(void *arg) {
+	struct qs_worker *w = arg;
+	__u64 value = 1, start;
+
+	if (w->kernel) {
+		w->err = bench_prog_run(w->fd, w->ops, &w->kern_avg_ns);
+		return NULL;
+	}
+	for (__u32 i = 0; i < w->ops; i++) {
+		start = bench_timer_start();
+		switch (w->op) {
+		case QS_PUSH:
+			w->err = bpf_map_update_elem(w->fd, NULL, &value, BPF_ANY);
+			break;
+		case QS_POP:
+			w->err = bpf_map_lookup_and_delete_elem(w->fd, NULL, &value);
+			break;
+		default:
+			w->err = bpf_map_lookup_elem(w->fd, NULL, &value);
+			break;
+		}
+		w->samples[i] = bench_timer_ns(start, bench_timer_stop());
+		if (w->err)
+			return NULL;
+	}
+	return NULL;
+}
+
+// 清空后重新填充到 level 个元素
+static int qs_set_level(int fd, __u32 level) {
+	__u64 value;
+
+	while (bpf_map_lookup_and_delete_elem(fd, NULL, &value) == 0)
+		;
+	for (value = 0; value < level; value++) {
+		if (bpf_map_update_elem(fd, NULL, &value, BPF_ANY)) {
+			fprintf(stderr, "Failed to fill queue/stack map: %d\n", errno);
+			return -errno;
+		}
+	}
+	return 0;
+}
+
+// 本轮可执行的操作次数：push 受剩余空间限制，pop 受已有元素限制
+static __u32 qs_batch(enum qs_op op, __u32 capacity, __u32 level) {
+	__u32 batch = capacity / 8 ? capacity / 8 : 1;
+
+	if (op == QS_PUSH && batch > capacity - level)
+		batch = capacity - level;
+	if (op != QS_PUSH && !level)
+		batch = 0;
+	if (op == QS_POP && batch > level)
+		batch = level;
+	return batch;
+}
+
+static int qs_measure(struct queue_stack_bpf *skel, struct qs_map *m,
+                      enum qs_op op, bool kernel, __u32 capacity,
+                      __u32 fill_pct, int threads, __u64 nop_ns) {
+	struct qs_worker workers[QS_MAX_PRODUCERS] = {};
+	__u32 level = (__u64)capacity * fill_pct / 100;
+	__u32 batch = qs_batch(op, capacity, level);
+	__u64 errors, wall_ns, *samples = NULL, kern_sum = 0;
+	struct bench_lat lat = {};
+	__u32 per_thread, total;
+	int i, err;
+
+	per_thread = batch / threads;
+	if (!per_thread)
+		return 0;
+	total = per_thread * threads;
+	err = qs_set_level(m->fd, level);
+	if (err)
+		return err;
+	if (!kernel) {
+		samples = calloc(total, sizeof(*samples));
+		if (!samples)
+			return -ENOMEM;
+	}
+	for (i = 0; i < threads; i++) {
+		workers[i].fd = kernel ? m->prog_fds[op] : m->fd;
+		workers[i].op = op;
+		workers[i].kernel = kernel;
+		workers[i].ops = per_thread;
+		workers[i].samples = samples ? samples + i * per_thread : NULL;
+	}
+	errors = skel->bss->qs_errors;
+	err = bench_run_threads(threads, qs_worker_fn, workers, sizeof(workers[0]),
+	                        &wall_ns);
+	for (i = 0; !err && i < threads; i++) {
+		err = workers[i].err;
+		kern_sum += workers[i].kern_avg_ns;
+	}
+	if (err) {
+		fprintf(stderr, "%s %s %s failed: %d\n", m->name,
+		        kernel ? "kernel" : "user",
+		        kernel ? qs_kernel_ops[op] : qs_user_ops[op], err);
+		free(samples);
+		return err;
+	}
+	if (skel->bss->qs_errors != errors)
+		fprintf(stderr, "warning: %llu %s %s ops hit a full/empty map\n",
+		        skel->bss->qs_errors - errors, m->name, qs_kernel_ops[op]);
+
+	if (kernel) {
+		// 内核态只能拿到 test_run 的平均耗时，扣除空程序的开销
+		lat.avg = (double)kern_sum / threads;
+		lat.avg = lat.avg > nop_ns ? lat.avg - nop_ns : 0;
+	} else {
+		char phase[64];
+
+		snprintf(phase, sizeof(phase), "queue_stack/%s/%s/%u/%u/%d", m->name,
+		         qs_user_ops[op], capacity, fill_pct, threads);
+		bench_lat_summarize(phase, samples, total, &lat);
+	}
+	printf("%-6s %-6s %-18s %-9u %-6u %-8d %-8u %-10.0f ", m->name,
+	       kernel ? "kernel" : "user",
+	       kernel ? qs_kernel_ops[op] : qs_user_ops[op], capacity, fill_pct,
+	       threads, total, lat.avg);
+	if (kernel)
+		printf("%-10s %-10s ", "-", "-");
+	else
+		printf("%-10.0f %-10.0f ", lat.p50, lat.p99);
+	printf("%-10.3f\n", wall_ns ? total * 1000.0 / wall_ns : 0);
+	fflush(stdout);
+	BENCH_OUTPUT("queue_stack", BF_STR("map", m->name),
+	             BF_STR("side", kernel ? "kernel" : "user"),
+	             BF_STR("op", kernel ? qs_kernel_ops[op] : qs_user_ops[op]),
+	             BF_U64("max_entries", capacity), BF_U64("fill_pct", fill_pct),
+	             BF_I64("threads", threads), BF_U64("ops", total),
+	             BF_F64("avg_ns", lat.avg),
+	             BF_F64("p50_ns", kernel ? NAN : lat.p50),
+	             BF_F64("p99_ns", kernel ? NAN : lat.p99),
+	             BF_F64("mops", wall_ns ? total * 1000.0 / wall_ns : 0));
+	free(samples);
+	return 0;
+}
+
+static struct queue_stack_bpf *qs_open(__u32 capacity) {
+	static const char *const progs[] = {
+	    "bench_nop",    "qs_queue_push", "qs_queue_pop", "qs_queue_peek",
+	    "qs_stack_push", "qs_stack_pop", "qs_stack_peek",
+	};
+	struct queue_stack_bpf *skel;
+	int err;
+
+	skel = BENCH_SKEL_OPEN(queue_stack);
+	if (!skel) {
+		fprintf(stderr, "Failed to open BPF skeleton\n");
+		return NULL;
+	}
+	bench_autoload_only(skel->obj, progs, sizeof(progs) / sizeof(progs[0]));
+	bpf_map__set_max_entries(skel->maps.queue_map, capacity);
+	bpf_map__set_max_entries(skel->maps.stack_map, capacity);
+	err = BENCH_SKEL_LOAD(queue_stack, skel);
+	if (err) {
+		fprintf(stderr, "Failed to load queue/stack programs: %d\n", err);
+		queue_stack_bpf__destroy(skel);
+		// 与 libbpf 一致: 返回NULL时错误码在 errno 中
+		errno = -err;
+		return NULL;
+	}
+	return skel;
+}
+
+// 在一个容量下遍历填充率 × 操作 × 内核/用户态 × 生产者数量
+static int qs_run_map(struct queue_stack_bpf *skel, struct qs_map *m,
+                      __u32 capacity, __u64 nop_ns, volatile bool *exiting) {
+	int nr_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	int multi = nr_cpus < QS_MAX_PRODUCERS ? nr_cpus : QS_MAX_PRODUCERS;
+	int err;
+
+	for (size_t f = 0; f < sizeof(qs_fill_pcts) / sizeof(__u32); f++) {
+		for (int op = 0; op < QS_OP_MAX; op++) {
+			for (int kernel = 1; kernel >= 0; kernel--) {
+				if (*exiting)
+					return 0;
+				err = qs_measure(skel, m, op, kernel, capacity,
+				                 qs_fill_pcts[f], 1, nop_ns);
+				if (!err && multi > 1)
+					err = qs_measure(skel, m, op, kernel, capacity,
+					                 qs_fill_pcts[f], multi, nop_ns);
+				if (err)
+					return err;
+			}
+		}
+	}
+	return 0;
+}
+
+int bench_queue_stack(volatile bool *exiting) {
+	struct queue_stack_bpf *skel;
+	__u64 nop_ns;
+	int err = 0;
+
+	printf("%-6s %-6s %-18s %-9s %-6s %-8s %-8s %-10s %-10s %-10s %-10s\n",
+	       "MAP", "SIDE", "OP", "CAPACITY", "FILL%", "THREADS", "OPS",
+	       "AVG(ns)", "P50(ns)", "P99(ns)", "Mops/s");
+	for (size_t c = 0; c < sizeof(qs_capacities) / sizeof(__u32); c++) {
+		__u32 capacity = qs_capacities[c];
+
+		skel = qs_open(capacity);
+		if (!skel)
+			return -errno;
+		err = bench_prog_run(bpf_program__fd(skel->progs.bench_nop), capacity,
+		                     &nop_ns);
+		if (err) {
+			fprintf(stderr, "Failed to run bench_nop: %d\n", err);
+			queue_stack_bpf__destroy(skel);
+			return err;
+		}
+		struct qs_map maps[] = {
+		    {"queue",
+		     bpf_map__fd(skel->maps.queue_map),
+		     {bpf_program__fd(skel->progs.qs_queue_push),
+		      bpf_program__fd(skel->progs.qs_queue_pop),
+		      bpf_program__fd(skel->progs.qs_queue_peek)}},
+		    {"stack",
+		     bpf_map__fd(skel->maps.stack_map),
+		     {bpf_program__fd(skel->progs.qs_stack_push),
+		      bpf_program__fd(skel->progs.qs_stack_pop),
+		      bpf_program__fd(skel->progs.qs_stack_peek)}},
+		};
+		for (size_t i = 0; !err && i < sizeof(maps) / sizeof(maps[0]); i++)
+			err = qs_run_map(skel, &maps[i], capacity, nop_ns, exiting);
+		queue_stack_bpf__destroy(skel);
+		if (err || *exiting)
+			break;
+	}
+	return err;
+}
+
+static const struct bench_feature queue_stack_feats[] = {
+    BENCH_PROG(SCHED_CLS), BENCH_MAP(QUEUE), BENCH_MAP(STACK),
+    BENCH_HELPER(SCHED_CLS, map_push_elem),
+};
+
+BENCH_REGISTER(queue_stack) = {
+    .name = "queue_stack",
+    .key = 'q',
+    .doc = "Benchmark push/pop/peek of queue and stack maps",
+    .feats = queue_stack_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(queue_stack_feats),
+    .schema = "map,side,op,max_entries,fill_pct,threads,ops,avg_ns,p50_ns,p99_ns,mops",
+    .run = bench_queue_stack,
+};
@@ -0,0 +1,232 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Binary result format and its memory-mapped reader.
+#include "bench_record.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REC_ALIGN(x) (((x) + 7) & ~(size_t)7)
+// 写入缓冲区大小，长时间运行时减少系统调用次数
+#define REC_BUF_SIZE (1 << 20)
+
+static FILE *rec_file;
+static char *rec_buf;
+// 已登记的阶段名，下标即阶段id
+static char **rec_phases;
+static __u32 rec_nr_phases;
+
+static __u64 rec_clock_ns(clockid_t clk) {
+	struct timespec ts;
+
+	clock_gettime(clk, &ts);
+	return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+int bench_record_open(const char *path, const char *command) {
+	struct bench_rec_file_header h = {0};
+	struct utsname uts;
+
+	rec_file = fopen(path, "wb");
+	if (!rec_file)
+		return -errno;
+	rec_buf = malloc(REC_BUF_SIZE);
+	if (rec_buf)
+		setvbuf(rec_file, rec_buf, _IOFBF, REC_BUF_SIZE);
+
+	memcpy(h.magic, BENCH_REC_MAGIC, sizeof(BENCH_REC_MAGIC));
+	h.version = BENCH_REC_VERSION;
+	h.header_size = sizeof(h);
+	h.start_ns = rec_clock_ns(CLOCK_REALTIME);
+	h.nr_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (!uname(&uts)) {
+		snprintf(h.kernel, sizeof(h.kernel), "%s", uts.release);
+		snprintf(h.machine, sizeof(h.machine), "%.*s",
+		         (int)sizeof(h.machine) - 1, uts.machine);
+	}
+	snprintf(h.command, sizeof(h.command), "%s", command ? command : "");
+	if (fwrite(&h, sizeof(h), 1, rec_file) != 1) {
+		bench_record_close();
+		return -EIO;
+	}
+	return 0;
+}
+
+void bench_record_close(void) {
+	if (rec_file)
+		fclose(rec_file);
+	rec_file = NULL;
+	free(rec_buf);
+	rec_buf = NULL;
+	for (__u32 i = 0; i < rec_nr_phases; i++)
+		free(rec_phases[i]);
+	free(rec_phases);
+	rec_phases = NULL;
+	rec_nr_phases = 0;
+}
+
+bool bench_record_enabled(void) { return rec_file != NULL; }
+
+// 查找阶段id，首次出现时写入阶段记录
+static int rec_phase_id(const char *name) {
+	struct bench_rec_phase p = {0};
+	char **phases;
+
+	for (__u32 i = 0; i < rec_nr_phases; i++) {
+		if (strcmp(rec_phases[i], name) == 0)
+			return i;
+	}
+	phases = realloc(rec_phases, (rec_nr_phases + 1) * sizeof(*phases));
+	if (!phases)
+		return -ENOMEM;
+	rec_phases = phases;
+	rec_phases[rec_nr_phases] = strdup(name);
+	if (!rec_phases[rec_nr_phases])
+		return -ENOMEM;
+
+	p.hdr.type = BENCH_REC_PHASE;
+	p.hdr.size = sizeof(p);
+	p.id = rec_nr_phases;
+	p.ts_ns = rec_clock_ns(CLOCK_MONOTONIC);
+	snprintf(p.name, sizeof(p.name), "%s", name);
+	fwrite(&p, sizeof(p), 1, rec_file);
+	return rec_nr_phases++;
+}
+
+int bench_hist_bucket(__u64 v) {
+	int msb;
+
+	if (v < (1 << BENCH_HIST_SUB_BITS))
+		return v;
+	msb = 63 - __builtin_clzll(v);
+	return ((msb - BENCH_HIST_SUB_BITS + 1) << BENCH_HIST_SUB_BITS) +
+	       ((v >> (msb - BENCH_HIST_SUB_BITS)) &
+	        ((1 << BENCH_HIST_SUB_BITS) - 1));
+}
+
+__u64 bench_hist_bucket_low(int idx) {
+	int msb, sub;
+
+	if (idx < (1 << BENCH_HIST_SUB_BITS))
+		return idx;
+	msb = (idx >> BENCH_HIST_SUB_BITS) + BENCH_HIST_SUB_BITS - 1;
+	sub = idx & ((1 << BENCH_HIST_SUB_BITS) - 1);
+	return (1ULL << msb) | ((__u64)sub << (msb - BENCH_HIST_SUB_BITS));
+}
+
+void bench_record_samples(const char *phase, const __u64 *samples, size_t nr) {
+	struct bench_rec_samples s = {0};
+	struct bench_rec_hist h = {0};
+	int id;
+
+	if (!rec_file || !nr)
+		return;
+	id = rec_phase_id(phase);
+	if (id < 0)
+		return;
+
+	s.hdr.type = BENCH_REC_SAMPLES;
+	s.phase = id;
+	s.ts_ns = rec_clock_ns(CLOCK_MONOTONIC);
+	for (size_t off = 0; off < nr; off += BENCH_REC_MAX_SAMPLES) {
+		s.nr = nr - off < BENCH_REC_MAX_SAMPLES ? nr - off
+		                                        : BENCH_REC_MAX_SAMPLES;
+		s.hdr.size = sizeof(s) + s.nr * sizeof(__u64);
+		fwrite(&s, sizeof(s), 1, rec_file);
+		fwrite(samples + off, sizeof(__u64), s.nr, rec_file);
+	}
+
+	h.hdr.type = BENCH_REC_HIST;
+	h.hdr.size = sizeof(h);
+	h.phase = id;
+	h.nr_buckets = BENCH_HIST_BUCKETS;
+	h.min = samples[0];
+	for (size_t i = 0; i < nr; i++) {
+		h.counts[bench_hist_bucket(samples[i])]++;
+		h.sum += samples[i];
+		if (samples[i] < h.min)
+			h.min = samples[i];
+		if (samples[i] > h.max)
+			h.max = samples[i];
+	}
+	h.count = nr;
+	fwrite(&h, sizeof(h), 1, rec_file);
+}
+
+int bench_rec_reader_open(struct bench_rec_reader *r, const char *path) {
+	const struct bench_rec_file_header *h;
+	struct stat st;
+	void *base;
+	int fd, err = 0;
+
+	memset(r, 0, sizeof(*r));
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -errno;
+	if (fstat(fd, &st)) {
+		err = -errno;
+		goto out;
+	}
+	if ((size_t)st.st_size < sizeof(*h)) {
+		err = -EINVAL;
+		goto out;
+	}
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (base == MAP_FAILED) {
+		err = -errno;
+		goto out;
+	}
+	h = base;
+	// 版本号较新的文件头可能更长，只要求能容纳当前版本的字段
+	if (memcmp(h->magic, BENCH_REC_MAGIC, sizeof(BENCH_REC_MAGIC)) ||
+	    h->version < 1 || h->header_size < sizeof(*h) ||
+	    h->header_size > (size_t)st.st_size) {
+		munmap(base, st.st_size);
+		err = -EINVAL;
+		goto out;
+	}
+	madvise(base, st.st_size, MADV_SEQUENTIAL);
+	r->base = base;
+	r->size = st.st_size;
+	r->off = h->header_size;
+	r->header = h;
+out:
+	close(fd);
+	return err;
+}
+
+const struct bench_rec_hdr *bench_rec_next(struct bench_rec_reader *r) {
+	const struct bench_rec_hdr *rec;
+
+	if (r->off + sizeof(*rec) > r->size)
+		return NULL;
+	rec = (const void *)((const char *)r->base + r->off);
+	// 写入中断时最后一条记录可能不完整
+	if (rec->size < sizeof(*rec) || r->off + rec->size > r->size)
+		return NULL;
+	r->off += REC_ALIGN(rec->size);
+	return rec;
+}
+
+void bench_rec_reader_close(struct bench_rec_reader *r) {
+	if (r->base)
+		munmap((void *)r->base, r->size);
+	memset(r, 0, sizeof(*r));
+}
@@ -0,0 +1,159 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Benchmark registry: each benchmark describes itself in its own file.
+#include "bench_registry.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const struct bench_desc *benches[BENCH_MAX];
+static int nr_benches;
+// 构造函数的执行顺序取决于链接顺序，首次查询时按名字排序
+static bool sorted;
+
+// 按命令行顺序选中的基准测试
+static struct {
+	const struct bench_desc *desc;
+	const char *arg;
+	bool set_up;
+} selected[BENCH_MAX];
+static int nr_selected;
+
+void bench_register(const struct bench_desc *b) {
+	if (nr_benches == BENCH_MAX) {
+		fprintf(stderr, "Too many benchmarks, %s not registered\n", b->name);
+		return;
+	}
+	benches[nr_benches++] = b;
+	sorted = false;
+}
+
+static int bench_cmp_name(const void *a, const void *b) {
+	return strcmp((*(const struct bench_desc *const *)a)->name,
+	              (*(const struct bench_desc *const *)b)->name);
+}
+
+static void bench_sort(void) {
+	if (sorted)
+		return;
+	qsort(benches, nr_benches, sizeof(benches[0]), bench_cmp_name);
+	sorted = true;
+}
+
+int bench_count(void) { return nr_benches; }
+
+const struct bench_desc *bench_at(int i) {
+	bench_sort();
+	return i >= 0 && i < nr_benches ? benches[i] : NULL;
+}
+
+const struct bench_desc *bench_find(const char *name) {
+	for (int i = 0; i < nr_benches; i++) {
+		if (strcmp(benches[i]->name, name) == 0)
+			return benches[i];
+	}
+	return NULL;
+}
+
+int bench_option_key(const struct bench_desc *b) {
+	bench_sort();
+	if (b->key)
+		return b->key;
+	for (int i = 0; i < nr_benches; i++) {
+		if (benches[i] == b)
+			return BENCH_LONG_KEY_BASE + i;
+	}
+	return 0;
+}
+
+const struct bench_desc *bench_find_key(int key) {
+	bench_sort();
+	for (int i = 0; i < nr_benches; i++) {
+		if (bench_option_key(benches[i]) == key)
+			return benches[i];
+	}
+	return NULL;
+}
+
+bool bench_schema_has(const struct bench_desc *b, const char *field) {
+	size_t len = strlen(field);
+	const char *p = b->schema;
+
+	while (p && *p) {
+		if (strncmp(p, field, len) == 0 && (p[len] == ',' || !p[len]))
+			return true;
+		p = strchr(p, ',');
+		if (p)
+			p++;
+	}
+	return false;
+}
+
+int bench_select(const struct bench_desc *b, const char *arg) {
+	for (int i = 0; i < nr_selected; i++) {
+		if (selected[i].desc == b)
+			return -EEXIST;
+	}
+	selected[nr_selected].desc = b;
+	selected[nr_selected++].arg = arg;
+	return 0;
+}
+
+int bench_nr_selected(void) { return nr_selected; }
+
+int bench_setup_selected(void) {
+	int err;
+
+	for (int i = 0; i < nr_selected; i++) {
+		if (selected[i].desc->setup) {
+			err = selected[i].desc->setup(selected[i].arg);
+			if (err)
+				return err;
+		}
+		// 没有 setup 的基准测试同样需要 teardown
+		selected[i].set_up = true;
+	}
+	return 0;
+}
+
+int bench_run_selected(volatile bool *exiting) {
+	const struct bench_feature *missing;
+	const struct bench_desc *b;
+	int err = 0;
+
+	for (int i = 0; i < nr_selected && !err && !*exiting; i++) {
+		b = selected[i].desc;
+		if (nr_selected > 1)
+			printf("%s==> %s\n", i ? "\n" : "", b->name);
+		// 所选基准测试在当前内核上不可用时跳过，不视为失败
+		missing = bench_features_missing(b->feats, b->nr_feats);
+		if (missing) {
+			printf("%s: unsupported on this kernel (missing %s)\n", b->name,
+			       missing->name);
+			continue;
+		}
+		err = b->run(exiting);
+		if (err)
+			fprintf(stderr, "Failed to run %s: %d\n", b->name, err);
+	}
+	return err;
+}
+
+void bench_teardown_selected(void) {
+	for (int i = 0; i < nr_selected; i++) {
+		if (selected[i].set_up && selected[i].desc->teardown)
+			selected[i].desc->teardown();
+		selected[i].set_up = false;
+	}
+}
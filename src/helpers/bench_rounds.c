@@ -0,0 +1,213 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Round controller: warmup, round/time budget and outlier flagging.
+#include "bench_rounds.h"
+#include "bench_output.h"
+#include "bench_util.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 一个阶段在各轮中的耗时，按轮次顺序保存
+struct rounds_phase {
+	char name[64];
+	unsigned int *rounds;
+	__u64 *values;
+	size_t nr;
+	size_t cap;
+};
+
+static struct {
+	unsigned int warmup;
+	unsigned int rounds;
+	__u64 budget_ns;
+	__u64 start_ns;
+	__u64 round_start_ns;
+	__u64 last_round_ns;
+	// 已开始的轮数(含预热)与已完成的计入结果的轮数
+	unsigned int started;
+	unsigned int measured;
+	const char *reason;
+	struct rounds_phase **phases;
+	int nr_phases;
+} ctl;
+
+void bench_rounds_init(unsigned int warmup, unsigned int rounds,
+                       unsigned int budget_s) {
+	ctl.warmup = warmup;
+	ctl.rounds = rounds;
+	ctl.budget_ns = budget_s * 1000000000ULL;
+}
+
+void bench_rounds_start(void) {
+	ctl.start_ns = 0;
+	ctl.round_start_ns = 0;
+	ctl.last_round_ns = 0;
+	ctl.started = 0;
+	ctl.measured = 0;
+	ctl.reason = NULL;
+}
+
+bool bench_rounds_warmup(void) { return ctl.started <= ctl.warmup; }
+
+unsigned int bench_rounds_current(void) {
+	return ctl.started > ctl.warmup ? ctl.started - ctl.warmup : 0;
+}
+
+bool bench_rounds_next(volatile bool *exiting) {
+	__u64 now = bench_now_ns();
+
+	if (!ctl.start_ns)
+		ctl.start_ns = now;
+	if (ctl.started) {
+		ctl.last_round_ns = now - ctl.round_start_ns;
+		if (!bench_rounds_warmup())
+			ctl.measured++;
+	}
+	if (ctl.budget_ns && now - ctl.start_ns + ctl.last_round_ns > ctl.budget_ns)
+		ctl.reason = "time budget";
+	else if (*exiting)
+		ctl.reason = "interrupted";
+	else if (ctl.rounds && ctl.measured >= ctl.rounds)
+		ctl.reason = "round limit";
+	if (ctl.reason)
+		return false;
+	ctl.started++;
+	ctl.round_start_ns = now;
+	return true;
+}
+
+static struct rounds_phase *rounds_phase_get(const char *name) {
+	struct rounds_phase **grown, *p;
+
+	for (int i = 0; i < ctl.nr_phases; i++) {
+		if (strcmp(ctl.phases[i]->name, name) == 0)
+			return ctl.phases[i];
+	}
+	grown = realloc(ctl.phases, (ctl.nr_phases + 1) * sizeof(*ctl.phases));
+	if (!grown)
+		return NULL;
+	ctl.phases = grown;
+	p = calloc(1, sizeof(*p));
+	if (!p)
+		return NULL;
+	snprintf(p->name, sizeof(p->name), "%s", name);
+	ctl.phases[ctl.nr_phases++] = p;
+	return p;
+}
+
+void bench_rounds_add(const char *phase, __u64 ns) {
+	struct rounds_phase *p = rounds_phase_get(phase);
+
+	if (!p)
+		return;
+	if (p->nr == p->cap) {
+		size_t cap = p->cap ? p->cap * 2 : 64;
+		unsigned int *rounds = realloc(p->rounds, cap * sizeof(*rounds));
+		__u64 *values;
+
+		if (!rounds)
+			return;
+		p->rounds = rounds;
+		values = realloc(p->values, cap * sizeof(*values));
+		if (!values)
+			return;
+		p->values = values;
+		p->cap = cap;
+	}
+	p->rounds[p->nr] = bench_rounds_current();
+	p->values[p->nr++] = ns;
+}
+
+static int rounds_cmp_double(const void *a, const void *b) {
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static double rounds_median(double *v, size_t n) {
+	qsort(v, n, sizeof(*v), rounds_cmp_double);
+	return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+// 按 Iglewicz-Hoaglin 修正z分数标记离群轮次，返回离群个数
+static int rounds_flag_phase(FILE *out, const struct rounds_phase *p) {
+	double *tmp, median, mad, z;
+	int nr_out = 0;
+
+	if (p->nr < 3)
+		return 0;
+	tmp = malloc(p->nr * sizeof(*tmp));
+	if (!tmp)
+		return 0;
+	for (size_t i = 0; i < p->nr; i++)
+		tmp[i] = p->values[i];
+	median = rounds_median(tmp, p->nr);
+	for (size_t i = 0; i < p->nr; i++)
+		tmp[i] = fabs(p->values[i] - median);
+	mad = rounds_median(tmp, p->nr);
+	free(tmp);
+	// 超过一半的轮次完全相同时 MAD 为0，无法给出尺度，不做标记
+	if (mad == 0)
+		return 0;
+	for (size_t i = 0; i < p->nr; i++) {
+		z = 0.6745 * (p->values[i] - median) / mad;
+		if (fabs(z) <= BENCH_OUTLIER_Z)
+			continue;
+		if (!nr_out++)
+			fprintf(out, "%-28s median %llu ns, MAD %.0f ns\n", p->name,
+			        (unsigned long long)median, mad);
+		fprintf(out, "  round %-6u %-14llu z=%+.1f\n", p->rounds[i],
+		        (unsigned long long)p->values[i], z);
+		BENCH_OUTPUT("outlier", BF_STR("phase", p->name),
+		             BF_U64("round", p->rounds[i]),
+		             BF_U64("elapsed_ns", p->values[i]),
+		             BF_F64("median_ns", median), BF_F64("mad_ns", mad),
+		             BF_F64("z", z));
+	}
+	return nr_out;
+}
+
+void bench_rounds_summary(FILE *out) {
+	double elapsed;
+	int nr_out = 0;
+
+	if (!ctl.started)
+		return;
+	elapsed = ctl.start_ns ? (bench_now_ns() - ctl.start_ns) / 1e9 : 0;
+	fprintf(out, "\nRun summary: %u rounds measured, %u warmup rounds "
+	             "discarded, %.1fs, stopped by %s\n",
+	        ctl.measured, ctl.started < ctl.warmup ? ctl.started : ctl.warmup,
+	        elapsed, ctl.reason ? ctl.reason : "error");
+	fprintf(out, "Outlier rounds (|modified z| > %.1f, kept in results):\n",
+	        BENCH_OUTLIER_Z);
+	for (int i = 0; i < ctl.nr_phases; i++)
+		nr_out += rounds_flag_phase(out, ctl.phases[i]);
+	if (!nr_out)
+		fprintf(out, "  none\n");
+	BENCH_OUTPUT("run", BF_U64("rounds", ctl.measured),
+	             BF_U64("warmup", ctl.warmup), BF_F64("elapsed_s", elapsed),
+	             BF_STR("stop_reason", ctl.reason ? ctl.reason : "error"),
+	             BF_U64("outliers", nr_out));
+}
+
+void bench_rounds_free(void) {
+	for (int i = 0; i < ctl.nr_phases; i++) {
+		free(ctl.phases[i]->rounds);
+		free(ctl.phases[i]->values);
+		free(ctl.phases[i]);
+	}
+	free(ctl.phases);
+	ctl.phases = NULL;
+	ctl.nr_phases = 0;
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Per-object BPF skeleton open/load/attach cost.
+#include "bench_skel.h"
+#include "bench_output.h"
+#include "bench_record.h"
+#include <string.h>
+
+// 最多统计的BPF对象个数
+#define SKEL_MAX_OBJS 16
+
+static const char *const skel_phase_names[BENCH_SKEL_NR_PHASES] = {
+    "open", "load", "attach"};
+
+// 一个对象各阶段的次数、首次耗时(冷启动)与累计耗时
+static struct skel_obj {
+	const char *name;
+	__u64 count[BENCH_SKEL_NR_PHASES];
+	__u64 first_ns[BENCH_SKEL_NR_PHASES];
+	__u64 total_ns[BENCH_SKEL_NR_PHASES];
+} skel_objs[SKEL_MAX_OBJS];
+static int nr_skel_objs;
+
+static struct skel_obj *skel_obj_get(const char *name) {
+	for (int i = 0; i < nr_skel_objs; i++) {
+		if (strcmp(skel_objs[i].name, name) == 0)
+			return &skel_objs[i];
+	}
+	if (nr_skel_objs == SKEL_MAX_OBJS)
+		return NULL;
+	skel_objs[nr_skel_objs].name = name;
+	return &skel_objs[nr_skel_objs++];
+}
+
+void bench_skel_time(const char *obj, enum bench_skel_phase phase, __u64 ns) {
+	struct skel_obj *o = skel_obj_get(obj);
+	char record[64];
+
+	if (!o)
+		return;
+	if (!o->count[phase]++)
+		o->first_ns[phase] = ns;
+	o->total_ns[phase] += ns;
+	snprintf(record, sizeof(record), "startup/%s/%s", obj,
+	         skel_phase_names[phase]);
+	bench_record_samples(record, &ns, 1);
+	BENCH_OUTPUT("startup", BF_STR("object", obj),
+	             BF_STR("phase", skel_phase_names[phase]),
+	             BF_U64("seq", o->count[phase]), BF_U64("elapsed_ns", ns));
+}
+
+void bench_skel_summary(FILE *out) {
+	if (!nr_skel_objs)
+		return;
+	fprintf(out, "\nBPF object startup cost (us, first / average):\n");
+	fprintf(out, "%-15s %-7s %-19s %-19s %-19s\n", "OBJECT", "LOADS", "OPEN",
+	        "LOAD", "ATTACH");
+	for (int i = 0; i < nr_skel_objs; i++) {
+		const struct skel_obj *o = &skel_objs[i];
+
+		fprintf(out, "%-15s %-7llu", o->name,
+		        (unsigned long long)o->count[BENCH_SKEL_PHASE_LOAD]);
+		for (int p = 0; p < BENCH_SKEL_NR_PHASES; p++) {
+			char cell[32] = "-";
+
+			if (o->count[p])
+				snprintf(cell, sizeof(cell), "%.0f / %.0f",
+				         o->first_ns[p] / 1e3,
+				         o->total_ns[p] / 1e3 / o->count[p]);
+			fprintf(out, " %-19s", cell);
+		}
+		fprintf(out, "\n");
+	}
+}
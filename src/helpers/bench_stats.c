@@ -0,0 +1,162 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Streaming statistics engine.
+#include "bench_stats.h"
+#include <math.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct bench_stat **stats;
+static int nr_stats;
+static volatile sig_atomic_t print_requested;
+
+// gamma = (1 + alpha) / (1 - alpha)，值 v 落在下标 ceil(log_gamma(v)) 的桶
+static double sketch_log_gamma(void) {
+	static double lg;
+
+	if (!lg)
+		lg = log((1 + BENCH_SKETCH_ALPHA) / (1 - BENCH_SKETCH_ALPHA));
+	return lg;
+}
+
+static int sketch_index(__u64 v) {
+	int idx = (int)ceil(log((double)v) / sketch_log_gamma());
+
+	if (idx < 0)
+		return 0;
+	return idx < BENCH_SKETCH_BINS ? idx : BENCH_SKETCH_BINS - 1;
+}
+
+// 桶 i 覆盖 (gamma^(i-1), gamma^i]，取使相对误差最小的代表值
+static double sketch_value(int idx) {
+	double gamma = exp(sketch_log_gamma());
+
+	return 2 * pow(gamma, idx) / (gamma + 1);
+}
+
+struct bench_stat *bench_stats_get(const char *name) {
+	struct bench_stat **grown, *s;
+
+	for (int i = 0; i < nr_stats; i++) {
+		if (strcmp(stats[i]->name, name) == 0)
+			return stats[i];
+	}
+	grown = realloc(stats, (nr_stats + 1) * sizeof(*stats));
+	if (!grown)
+		return NULL;
+	stats = grown;
+	s = calloc(1, sizeof(*s));
+	if (!s)
+		return NULL;
+	snprintf(s->name, sizeof(s->name), "%s", name);
+	stats[nr_stats++] = s;
+	return s;
+}
+
+void bench_stat_add(struct bench_stat *s, __u64 v) {
+	double delta;
+
+	if (!s)
+		return;
+	if (!s->n || v < s->min)
+		s->min = v;
+	if (v > s->max)
+		s->max = v;
+	s->n++;
+	delta = v - s->mean;
+	s->mean += delta / s->n;
+	s->m2 += delta * (v - s->mean);
+	if (v == 0)
+		s->zeros++;
+	else
+		s->bins[sketch_index(v)]++;
+}
+
+void bench_stats_add_samples(const char *name, const __u64 *samples,
+                             size_t nr) {
+	struct bench_stat *s = bench_stats_get(name);
+
+	for (size_t i = 0; s && i < nr; i++)
+		bench_stat_add(s, samples[i]);
+}
+
+double bench_stat_stddev(const struct bench_stat *s) {
+	return s->n > 1 ? sqrt(s->m2 / (s->n - 1)) : 0;
+}
+
+double bench_stat_quantile(const struct bench_stat *s, double q) {
+	__u64 rank, seen;
+
+	if (!s->n)
+		return 0;
+	rank = (__u64)(q * (s->n - 1));
+	seen = s->zeros;
+	if (rank < seen)
+		return 0;
+	for (int i = 0; i < BENCH_SKETCH_BINS; i++) {
+		seen += s->bins[i];
+		if (rank < seen) {
+			double v = sketch_value(i);
+			// 估计值不超出实际观测到的范围
+			return v < s->min ? s->min : v > s->max ? s->max : v;
+		}
+	}
+	return s->max;
+}
+
+void bench_stats_print(FILE *f, const char *title) {
+	// 各基准测试的指标名长短不一，名字列按最长的对齐
+	int width = 28;
+
+	if (!nr_stats)
+		return;
+	for (int i = 0; i < nr_stats; i++) {
+		if ((int)strlen(stats[i]->name) > width)
+			width = strlen(stats[i]->name);
+	}
+	fprintf(f, "\n%s\n", title);
+	fprintf(f, "%-*s %-8s %-12s %-12s %-10s %-10s %-10s %-10s %-10s %-10s\n",
+	        width, "METRIC", "N", "MEAN(ns)", "STDDEV(ns)", "MIN", "P50", "P90",
+	        "P99", "P99.9", "MAX");
+	for (int i = 0; i < nr_stats; i++) {
+		const struct bench_stat *s = stats[i];
+
+		fprintf(f,
+		        "%-*s %-8llu %-12.1f %-12.1f %-10llu %-10.0f %-10.0f %-10.0f "
+		        "%-10.0f %-10llu\n",
+		        width, s->name, (unsigned long long)s->n, s->mean,
+		        bench_stat_stddev(s), (unsigned long long)s->min,
+		        bench_stat_quantile(s, 0.5), bench_stat_quantile(s, 0.9),
+		        bench_stat_quantile(s, 0.99), bench_stat_quantile(s, 0.999),
+		        (unsigned long long)s->max);
+	}
+	fflush(f);
+}
+
+void bench_stats_free(void) {
+	for (int i = 0; i < nr_stats; i++)
+		free(stats[i]);
+	free(stats);
+	stats = NULL;
+	nr_stats = 0;
+}
+
+void bench_stats_request(int sig) { print_requested = 1; }
+
+bool bench_stats_take_request(void) {
+	if (!print_requested)
+		return false;
+	print_requested = 0;
+	return true;
+}
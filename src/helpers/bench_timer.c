@@ -0,0 +1,157 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Low-overhead cycle counter timing for per-operation samples.
+#include "bench_timer.h"
+#include "bench_output.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+// 每个校准窗口的时长，两个窗口得到的频率相差超过该比例视为不稳定
+#define TIMER_CAL_NS 25000000ULL
+#define TIMER_CAL_TOLERANCE 0.001
+// 测量计时开销时连续计时的次数
+#define TIMER_OVERHEAD_PAIRS 10000
+
+struct bench_timer_cal bench_timer_cal = {.ns_per_tick = 1.0};
+
+const char *bench_timer_name(void) {
+	if (!bench_timer_cal.counter)
+		return "clock_gettime";
+#if defined(__aarch64__)
+	return "cntvct";
+#else
+	return "tsc";
+#endif
+}
+
+static __u64 timer_raw_ns(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return (__u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 计数器不可用时返回原因，可用时返回NULL
+static const char *timer_counter_unusable(void) {
+	static char reason[64];
+	char clocksource[32] = "";
+	FILE *f;
+
+#if defined(__x86_64__) || defined(__i386__)
+	unsigned int eax, ebx, ecx, edx;
+
+	// CPUID.80000007H:EDX[8] 为 invariant TSC，频率不随调频与C-state变化
+	if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) ||
+	    !(edx & (1U << 8)))
+		return "TSC is not invariant";
+#elif !defined(__aarch64__)
+	return "no cycle counter on this architecture";
+#endif
+	// 内核发现 TSC 在CPU之间不同步时会换用其他时钟源
+	f = fopen("/sys/devices/system/clocksource/clocksource0/"
+	          "current_clocksource",
+	          "r");
+	if (f) {
+		if (fgets(clocksource, sizeof(clocksource), f))
+			clocksource[strcspn(clocksource, "\n")] = '\0';
+		fclose(f);
+	}
+#if defined(__aarch64__)
+	if (clocksource[0] && strcmp(clocksource, "arch_sys_counter")) {
+#else
+	if (clocksource[0] && strcmp(clocksource, "tsc")) {
+#endif
+		snprintf(reason, sizeof(reason), "kernel clocksource is %s",
+		         clocksource);
+		return reason;
+	}
+	return NULL;
+}
+
+// 在一个校准窗口内同时读计数器与 CLOCK_MONOTONIC_RAW，返回每个计数的ns
+static double timer_calibrate_window(void) {
+	__u64 t0, c0, t1, c1;
+
+	t0 = timer_raw_ns();
+	c0 = bench_timer_start();
+	do {
+		t1 = timer_raw_ns();
+	} while (t1 - t0 < TIMER_CAL_NS);
+	c1 = bench_timer_stop();
+	return c1 > c0 ? (double)(t1 - t0) / (c1 - c0) : 0;
+}
+
+static int timer_cmp_u64(const void *a, const void *b) {
+	__u64 x = *(const __u64 *)a, y = *(const __u64 *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+// 连续计时空操作，最小值作为要扣除的开销，中位数仅用于报告
+static void timer_measure_overhead(double *min_ns, double *median_ns) {
+	__u64 *ticks = malloc(TIMER_OVERHEAD_PAIRS * sizeof(*ticks)), start;
+
+	*min_ns = *median_ns = 0;
+	if (!ticks)
+		return;
+	for (int i = 0; i < TIMER_OVERHEAD_PAIRS; i++) {
+		start = bench_timer_start();
+		ticks[i] = bench_timer_stop() - start;
+	}
+	qsort(ticks, TIMER_OVERHEAD_PAIRS, sizeof(*ticks), timer_cmp_u64);
+	*min_ns = ticks[0] * bench_timer_cal.ns_per_tick;
+	*median_ns = ticks[TIMER_OVERHEAD_PAIRS / 2] * bench_timer_cal.ns_per_tick;
+	free(ticks);
+}
+
+void bench_timer_init(void) {
+	const char *fallback = timer_counter_unusable();
+	double a, b, overhead_median;
+
+	bench_timer_cal.counter = false;
+	bench_timer_cal.ns_per_tick = 1.0;
+	bench_timer_cal.overhead_ns = 0;
+	if (!fallback) {
+		bench_timer_cal.counter = true;
+		a = timer_calibrate_window();
+		b = timer_calibrate_window();
+		if (a <= 0 || b <= 0 || fabs(a - b) > TIMER_CAL_TOLERANCE * a) {
+			bench_timer_cal.counter = false;
+			fallback = "calibration is unstable";
+		} else {
+			bench_timer_cal.ns_per_tick = (a + b) / 2;
+		}
+	}
+	timer_measure_overhead(&bench_timer_cal.overhead_ns, &overhead_median);
+
+	if (fallback)
+		printf("Timer: clock_gettime (%s), overhead %.1f ns (median %.1f "
+		       "ns)\n",
+		       fallback, bench_timer_cal.overhead_ns, overhead_median);
+	else
+		printf("Timer: %s at %.3f GHz, overhead %.1f ns (median %.1f ns)\n",
+		       bench_timer_name(), 1 / bench_timer_cal.ns_per_tick,
+		       bench_timer_cal.overhead_ns, overhead_median);
+	BENCH_OUTPUT("timer", BF_STR("source", bench_timer_name()),
+	             BF_F64("freq_mhz", bench_timer_cal.counter
+	                                    ? 1e3 / bench_timer_cal.ns_per_tick
+	                                    : NAN),
+	             BF_F64("overhead_ns", bench_timer_cal.overhead_ns),
+	             BF_F64("overhead_median_ns", overhead_median),
+	             BF_STR("fallback_reason", fallback ? fallback : ""));
+}
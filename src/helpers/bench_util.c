@@ -0,0 +1,328 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// User space helpers shared by the map benchmarks.
+#define _GNU_SOURCE
+#include "bench_util.h"
+#include "bench_env.h"
+#include "bench_features.h"
+#include "bench_load.h"
+#include "bench_record.h"
+#include "bench_stats.h"
+#include <bpf/bpf.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void bench_autoload_only(struct bpf_object *obj, const char *const *names,
+                         int nr_names) {
+	struct bpf_program *prog;
+
+	bpf_object__for_each_program(prog, obj) {
+		bool load = false;
+		for (int i = 0; i < nr_names; i++) {
+			if (strcmp(bpf_program__name(prog), names[i]) == 0) {
+				load = true;
+				break;
+			}
+		}
+		bpf_program__set_autoload(prog, load);
+	}
+	bench_skip_unsupported(obj);
+}
+
+void bench_skip_unsupported(struct bpf_object *obj) {
+	struct bpf_program *prog;
+	struct bpf_map *map;
+
+	bpf_object__for_each_map(map, obj) {
+		// .data/.bss 等内部map总是可用
+		if (bpf_map__is_internal(map))
+			continue;
+		if (!bench_map_type_supported(bpf_map__type(map)))
+			bpf_map__set_autocreate(map, false);
+	}
+	bpf_object__for_each_program(prog, obj) {
+		if (bpf_program__autoload(prog) &&
+		    !bench_prog_type_supported(bpf_program__type(prog)))
+			bpf_program__set_autoload(prog, false);
+	}
+}
+
+long long bench_fdinfo_field(int fd, const char *field) {
+	char path[64], line[128];
+	size_t len = strlen(field);
+	long long val = -1;
+	FILE *f;
+
+	snprintf(path, sizeof(path), "/proc/self/fdinfo/%d", fd);
+	f = fopen(path, "r");
+	if (!f)
+		return -1;
+	while (fgets(line, sizeof(line), f)) {
+		if (strncmp(line, field, len) == 0 && line[len] == ':') {
+			// map_extra 等字段以十六进制输出
+			val = strtoll(line + len + 1, NULL, 0);
+			break;
+		}
+	}
+	fclose(f);
+	return val;
+}
+
+long long bench_map_memlock(int map_fd) {
+	return bench_fdinfo_field(map_fd, "memlock");
+}
+
+__u64 bench_mem_available(void) {
+	unsigned long long kb = 0;
+	char line[128];
+	FILE *f;
+
+	f = fopen("/proc/meminfo", "r");
+	if (!f)
+		return 0;
+	while (fgets(line, sizeof(line), f)) {
+		if (sscanf(line, "MemAvailable: %llu kB", &kb) == 1)
+			break;
+	}
+	fclose(f);
+	return kb * 1024;
+}
+
+// 等待 memcg 用量稳定的轮询间隔与次数
+#define BENCH_SETTLE_US 20000
+#define BENCH_SETTLE_TRIES 50
+
+static char memcg_path[512];
+static bool memcg_inited;
+
+static void bench_memcg_init(void) {
+	char line[512], *v1;
+	FILE *f;
+
+	memcg_inited = true;
+	f = fopen("/proc/self/cgroup", "r");
+	if (!f)
+		return;
+	while (fgets(line, sizeof(line), f)) {
+		line[strcspn(line, "\n")] = '\0';
+		if (strncmp(line, "0::", 3) == 0)
+			snprintf(memcg_path, sizeof(memcg_path),
+			         "/sys/fs/cgroup%s/memory.current", line + 3);
+		else if ((v1 = strstr(line, ":memory:")))
+			snprintf(memcg_path, sizeof(memcg_path),
+			         "/sys/fs/cgroup/memory%s/memory.kmem.usage_in_bytes",
+			         v1 + strlen(":memory:"));
+		else
+			continue;
+		if (!access(memcg_path, R_OK))
+			break;
+		memcg_path[0] = '\0';
+	}
+	fclose(f);
+}
+
+const char *bench_memcg_path(void) {
+	if (!memcg_inited)
+		bench_memcg_init();
+	return memcg_path[0] ? memcg_path : NULL;
+}
+
+long long bench_memcg_usage(void) {
+	const char *path = bench_memcg_path();
+	long long usage = -1;
+	FILE *f;
+
+	if (!path)
+		return -1;
+	f = fopen(path, "r");
+	if (!f)
+		return -1;
+	if (fscanf(f, "%lld", &usage) != 1)
+		usage = -1;
+	fclose(f);
+	return usage;
+}
+
+void bench_memcg_settle(void) {
+	long long prev = bench_memcg_usage(), cur;
+
+	for (int i = 0; prev >= 0 && i < BENCH_SETTLE_TRIES; i++) {
+		usleep(BENCH_SETTLE_US);
+		cur = bench_memcg_usage();
+		if (cur == prev)
+			break;
+		prev = cur;
+	}
+}
+
+int bench_prog_run(int prog_fd, int repeat, __u64 *avg_ns) {
+	char pkt[BENCH_PKT_SIZE] = {0};
+	LIBBPF_OPTS(bpf_test_run_opts, opts, .data_in = pkt,
+	            .data_size_in = sizeof(pkt), .repeat = repeat);
+	int err;
+
+	err = bpf_prog_test_run_opts(prog_fd, &opts);
+	if (err)
+		return err;
+	*avg_ns = opts.duration;
+	return 0;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+	__u64 x = *(const __u64 *)a, y = *(const __u64 *)b;
+	return x < y ? -1 : x > y;
+}
+
+void bench_lat_summarize(const char *phase, __u64 *samples, size_t nr,
+                         struct bench_lat *lat) {
+	double sum = 0;
+
+	memset(lat, 0, sizeof(*lat));
+	if (!nr)
+		return;
+	// 有名字的测量同时进入流式统计，运行结束时统一打印汇总表；
+	// 收到 SIGUSR1 时在这里打印当前的汇总
+	if (phase) {
+		bench_record_samples(phase, samples, nr);
+		bench_stats_add_samples(phase, samples, nr);
+		if (bench_stats_take_request())
+			bench_stats_print(stdout, BENCH_STATS_TITLE);
+	}
+	qsort(samples, nr, sizeof(*samples), cmp_u64);
+	for (size_t i = 0; i < nr; i++)
+		sum += samples[i];
+	lat->avg = sum / nr;
+	lat->p50 = samples[nr / 2];
+	lat->p99 = samples[(nr * 99) / 100];
+}
+
+void bench_attr_sched_other(pthread_attr_t *attr) {
+	struct sched_param param = {.sched_priority = 0};
+
+	pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(attr, SCHED_OTHER);
+	pthread_attr_setschedparam(attr, &param);
+}
+
+// 工作线程就绪计数与开始信号: go 为1时开始执行，为-1时(部分线程创建失败)
+// 直接退出
+struct bench_gate {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int ready;
+	int go;
+};
+
+struct bench_thread {
+	struct bench_gate *gate;
+	void *(*fn)(void *);
+	void *arg;
+};
+
+static void *bench_thread_entry(void *arg) {
+	struct bench_thread *t = arg;
+	int go;
+
+	// 所有线程就绪后同时开始
+	pthread_mutex_lock(&t->gate->lock);
+	t->gate->ready++;
+	pthread_cond_broadcast(&t->gate->cond);
+	while (!t->gate->go)
+		pthread_cond_wait(&t->gate->cond, &t->gate->lock);
+	go = t->gate->go;
+	pthread_mutex_unlock(&t->gate->lock);
+	return go > 0 ? t->fn(t->arg) : NULL;
+}
+
+// 工作线程可用的CPU: 测量CPU在前，其后是启动时允许运行且没有背景负载的CPU
+static int bench_worker_cpus(int *cpus, int max) {
+	int measure_cpu = bench_env_cpu(), nr = 0;
+
+	cpus[nr++] = measure_cpu;
+	for (int i = 0; i < CPU_SETSIZE && nr < max; i++) {
+		if (i != measure_cpu && bench_env_cpu_allowed(i) &&
+		    !bench_load_on_cpu(i))
+			cpus[nr++] = i;
+	}
+	return nr;
+}
+
+int bench_run_threads(int nr, void *(*fn)(void *), void *ctxs,
+                      size_t ctx_size, __u64 *wall_ns) {
+	struct bench_gate gate = {
+	    .lock = PTHREAD_MUTEX_INITIALIZER,
+	    .cond = PTHREAD_COND_INITIALIZER,
+	};
+	struct bench_thread *threads;
+	int *cpus, nr_cpus, i, err = 0;
+	pthread_t *tids;
+	__u64 start;
+
+	tids = calloc(nr, sizeof(*tids));
+	threads = calloc(nr, sizeof(*threads));
+	cpus = calloc(nr, sizeof(*cpus));
+	if (!tids || !threads || !cpus) {
+		free(tids);
+		free(threads);
+		free(cpus);
+		return -ENOMEM;
+	}
+	nr_cpus = bench_worker_cpus(cpus, nr);
+	if (nr_cpus < nr)
+		fprintf(stderr, "Warning: %d bench threads share %d CPUs\n", nr,
+		        nr_cpus);
+	for (i = 0; i < nr; i++) {
+		pthread_attr_t attr;
+		cpu_set_t set;
+
+		CPU_ZERO(&set);
+		CPU_SET(cpus[i % nr_cpus], &set);
+		pthread_attr_init(&attr);
+		pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+		if (nr_cpus < nr)
+			bench_attr_sched_other(&attr);
+		threads[i].gate = &gate;
+		threads[i].fn = fn;
+		threads[i].arg = (char *)ctxs + i * ctx_size;
+		err = pthread_create(&tids[i], &attr, bench_thread_entry, &threads[i]);
+		pthread_attr_destroy(&attr);
+		if (err) {
+			fprintf(stderr, "Failed to create bench thread: %d\n", err);
+			err = -err;
+			break;
+		}
+	}
+	// 等已创建的线程全部就绪；创建失败时让它们直接退出
+	pthread_mutex_lock(&gate.lock);
+	while (gate.ready < i)
+		pthread_cond_wait(&gate.cond, &gate.lock);
+	gate.go = err ? -1 : 1;
+	pthread_cond_broadcast(&gate.cond);
+	pthread_mutex_unlock(&gate.lock);
+	start = bench_now_ns();
+	for (int j = 0; j < i; j++)
+		pthread_join(tids[j], NULL);
+	*wall_ns = bench_now_ns() - start;
+
+	pthread_mutex_destroy(&gate.lock);
+	pthread_cond_destroy(&gate.cond);
+	free(cpus);
+	free(threads);
+	free(tids);
+	return err;
+}
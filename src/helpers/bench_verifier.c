@@ -0,0 +1,438 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// BPF program load and verifier cost benchmark.
+#include "bench_verifier.h"
+#include "bench_output.h"
+#include "bench_registry.h"
+#include "bench_util.h"
+#include <bpf/bpf.h>
+#include <bpf/btf.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 每个程序计时加载的次数，另有一次带统计日志的加载兼作预热
+#define VI_LOADS 5
+// 内核中 BPF_LOG_STATS 的取值，uapi 头文件没有导出
+#define VI_LOG_STATS 4
+#define VI_LOG_SIZE 4096
+// 内核最多允许256个子程序(含主程序)
+#define VI_MAX_SUBPROGS 255
+
+static const __u32 vi_sizes[] = {1, 4, 16, 64, 256, 1024, 4096};
+
+// 运行时生成的指令序列
+struct vi_prog {
+	struct bpf_insn *insns;
+	int cnt;
+	int cap;
+	int err;
+	// bpf_loop 回调的起始指令，非0时需要随程序提供 BTF func_info
+	int cb_off;
+};
+
+static void vi_emit(struct vi_prog *p, __u8 code, __u8 dst, __u8 src,
+                    __s16 off, __s32 imm) {
+	struct bpf_insn *insns;
+
+	if (p->err)
+		return;
+	if (p->cnt == p->cap) {
+		p->cap = p->cap ? p->cap * 2 : 256;
+		insns = realloc(p->insns, p->cap * sizeof(*insns));
+		if (!insns) {
+			p->err = -ENOMEM;
+			return;
+		}
+		p->insns = insns;
+	}
+	p->insns[p->cnt++] = (struct bpf_insn){
+	    .code = code, .dst_reg = dst, .src_reg = src, .off = off, .imm = imm};
+}
+
+static void vi_alu_imm(struct vi_prog *p, __u8 op, __u8 dst, __s32 imm) {
+	vi_emit(p, BPF_ALU64 | op | BPF_K, dst, 0, 0, imm);
+}
+
+static void vi_alu_reg(struct vi_prog *p, __u8 op, __u8 dst, __u8 src) {
+	vi_emit(p, BPF_ALU64 | op | BPF_X, dst, src, 0, 0);
+}
+
+static void vi_call(struct vi_prog *p, __u8 src, __s32 imm) {
+	vi_emit(p, BPF_JMP | BPF_CALL, 0, src, 0, imm);
+}
+
+// 64位立即数占两条指令，src 为 BPF_PSEUDO_* 时 imm 由内核解释
+static void vi_ld_imm64(struct vi_prog *p, __u8 dst, __u8 src, __s32 imm) {
+	vi_emit(p, BPF_LD | BPF_DW | BPF_IMM, dst, src, 0, imm);
+	vi_emit(p, 0, 0, 0, 0, 0);
+}
+
+static void vi_return(struct vi_prog *p) {
+	vi_alu_imm(p, BPF_MOV, BPF_REG_0, 0);
+	vi_emit(p, BPF_JMP | BPF_EXIT, 0, 0, 0, 0);
+}
+
+// n 次 array map 查找，每次都要判空后再更新
+static void vi_gen_map_ops(struct vi_prog *p, __u32 n, int map_fd) {
+	for (__u32 i = 0; i < n; i++) {
+		vi_emit(p, BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, -4, 0);
+		vi_alu_reg(p, BPF_MOV, BPF_REG_2, BPF_REG_10);
+		vi_alu_imm(p, BPF_ADD, BPF_REG_2, -4);
+		vi_ld_imm64(p, BPF_REG_1, BPF_PSEUDO_MAP_FD, map_fd);
+		vi_call(p, 0, BPF_FUNC_map_lookup_elem);
+		vi_emit(p, BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 3, 0);
+		vi_emit(p, BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_0, 0, 0);
+		vi_alu_imm(p, BPF_ADD, BPF_REG_1, 1);
+		vi_emit(p, BPF_STX | BPF_MEM | BPF_DW, BPF_REG_0, BPF_REG_1, 0, 0);
+	}
+	vi_return(p);
+}
+
+// n 个互不相关的条件分支，每个分支判断一个新的随机数，
+// 汇合处两条路径的状态等价，可以被剪枝
+static void vi_gen_branches(struct vi_prog *p, __u32 n, int map_fd) {
+	vi_alu_imm(p, BPF_MOV, BPF_REG_7, 0);
+	for (__u32 i = 0; i < n; i++) {
+		vi_call(p, 0, BPF_FUNC_get_prandom_u32);
+		vi_emit(p, BPF_JMP | BPF_JSET | BPF_K, BPF_REG_0, 0, 1, 1);
+		vi_alu_imm(p, BPF_ADD, BPF_REG_7, i + 1);
+	}
+	vi_return(p);
+}
+
+// n 个判断同一随机数不同位的分支，每条路径上该值已知的位不同，
+// 状态无法剪枝，探索的路径数随 n 指数增长
+static void vi_gen_branch_paths(struct vi_prog *p, __u32 n, int map_fd) {
+	vi_call(p, 0, BPF_FUNC_get_prandom_u32);
+	vi_alu_reg(p, BPF_MOV, BPF_REG_6, BPF_REG_0);
+	vi_alu_imm(p, BPF_MOV, BPF_REG_7, 0);
+	for (__u32 i = 0; i < n; i++) {
+		vi_emit(p, BPF_JMP | BPF_JSET | BPF_K, BPF_REG_6, 0, 1,
+		        1U << (i % 31));
+		vi_alu_imm(p, BPF_ADD, BPF_REG_7, i + 1);
+	}
+	vi_return(p);
+}
+
+// 有界循环(5.3+)，校验器逐次模拟每一轮迭代
+static void vi_gen_bounded_loop(struct vi_prog *p, __u32 n, int map_fd) {
+	vi_alu_imm(p, BPF_MOV, BPF_REG_6, 0);
+	vi_alu_imm(p, BPF_MOV, BPF_REG_7, 0);
+	vi_alu_reg(p, BPF_ADD, BPF_REG_7, BPF_REG_6);
+	vi_alu_imm(p, BPF_ADD, BPF_REG_6, 1);
+	vi_emit(p, BPF_JMP | BPF_JLT | BPF_K, BPF_REG_6, 0, -3, n);
+	vi_return(p);
+}
+
+// 与有界循环相同的循环体展开 n 次
+static void vi_gen_unrolled(struct vi_prog *p, __u32 n, int map_fd) {
+	vi_alu_imm(p, BPF_MOV, BPF_REG_6, 0);
+	vi_alu_imm(p, BPF_MOV, BPF_REG_7, 0);
+	for (__u32 i = 0; i < n; i++) {
+		vi_alu_reg(p, BPF_ADD, BPF_REG_7, BPF_REG_6);
+		vi_alu_imm(p, BPF_ADD, BPF_REG_6, 1);
+	}
+	vi_return(p);
+}
+
+// bpf_loop(5.17+) 调用 n 次回调，回调只被校验一次
+static void vi_gen_bpf_loop(struct vi_prog *p, __u32 n, int map_fd) {
+	int ld;
+
+	vi_alu_imm(p, BPF_MOV, BPF_REG_1, n);
+	ld = p->cnt;
+	vi_ld_imm64(p, BPF_REG_2, BPF_PSEUDO_FUNC, 0);
+	vi_alu_imm(p, BPF_MOV, BPF_REG_3, 0);
+	vi_alu_imm(p, BPF_MOV, BPF_REG_4, 0);
+	vi_call(p, 0, BPF_FUNC_loop);
+	vi_return(p);
+	// 回调函数紧跟在主程序之后，偏移相对于 ld_imm64 的下一条指令
+	if (!p->err)
+		p->insns[ld].imm = p->cnt - ld - 1;
+	p->cb_off = p->cnt;
+	vi_return(p);
+}
+
+// 主程序依次调用 n 个 bpf-to-bpf 子程序
+static void vi_gen_subprogs(struct vi_prog *p, __u32 n, int map_fd) {
+	// 主程序为 n 条调用指令加两条返回指令，每个子程序3条指令，
+	// 第 i 个子程序起始于 n + 2 + 3 * i，偏移相对于调用指令的下一条
+	for (__u32 i = 0; i < n; i++)
+		vi_call(p, BPF_PSEUDO_CALL, n + 1 + 2 * i);
+	vi_return(p);
+	for (__u32 i = 0; i < n; i++) {
+		vi_alu_imm(p, BPF_MOV, BPF_REG_0, i);
+		vi_alu_imm(p, BPF_ADD, BPF_REG_0, 1);
+		vi_emit(p, BPF_JMP | BPF_EXIT, 0, 0, 0, 0);
+	}
+}
+
+static const struct bench_feature vi_feat_loop =
+    BENCH_HELPER(SOCKET_FILTER, loop);
+
+struct vi_family {
+	const char *name;
+	__u32 max_n;
+	void (*gen)(struct vi_prog *p, __u32 n, int map_fd);
+	// 额外依赖的内核特性，不支持时跳过，NULL 表示无
+	const struct bench_feature *feat;
+	// 程序需要 BTF func_info
+	bool btf;
+};
+
+static const struct vi_family vi_families[] = {
+    {"map_ops", 4096, vi_gen_map_ops, NULL, false},
+    {"branches", 4096, vi_gen_branches, NULL, false},
+    {"branch_paths", 64, vi_gen_branch_paths, NULL, false},
+    {"bounded_loop", 4096, vi_gen_bounded_loop, NULL, false},
+    {"unrolled", 4096, vi_gen_unrolled, NULL, false},
+    {"bpf_loop", 4096, vi_gen_bpf_loop, &vi_feat_loop, true},
+    {"subprogs", VI_MAX_SUBPROGS, vi_gen_subprogs, NULL, false},
+};
+
+// 校验器日志中的统计，取不到的为NAN
+struct vi_stats {
+	double verify_us;
+	double processed;
+	double max_states;
+	double total_states;
+	double peak_states;
+};
+
+static void vi_parse_log(const char *log, struct vi_stats *st) {
+	unsigned int processed, limit, max_states, total, peak;
+	unsigned long long us;
+	const char *s;
+	int nr;
+
+	st->verify_us = st->processed = st->max_states = NAN;
+	st->total_states = st->peak_states = NAN;
+	s = strstr(log, "verification time ");
+	if (s && sscanf(s, "verification time %llu usec", &us) == 1)
+		st->verify_us = us;
+	s = strstr(log, "processed ");
+	if (!s)
+		return;
+	nr = sscanf(s,
+	            "processed %u insns (limit %u) max_states_per_insn %u "
+	            "total_states %u peak_states %u",
+	            &processed, &limit, &max_states, &total, &peak);
+	if (nr >= 1)
+		st->processed = processed;
+	// 较早的内核只输出处理的指令数
+	if (nr == 5) {
+		st->max_states = max_states;
+		st->total_states = total;
+		st->peak_states = peak;
+	}
+}
+
+// 主程序与 bpf_loop 回调共用的 BTF: int (void) 原型与两个静态函数
+static int vi_btf_load(struct btf **out) {
+	struct btf *btf;
+	int id, err;
+
+	btf = btf__new_empty();
+	if (!btf)
+		return -errno;
+	id = btf__add_int(btf, "int", 4, BTF_INT_SIGNED);
+	id = btf__add_func_proto(btf, id);
+	btf__add_func(btf, "vi_main", BTF_FUNC_STATIC, id);
+	btf__add_func(btf, "vi_callback", BTF_FUNC_STATIC, id);
+	err = btf__load_into_kernel(btf);
+	if (err) {
+		btf__free(btf);
+		return err;
+	}
+	*out = btf;
+	return 0;
+}
+
+static int vi_load(const struct vi_prog *p, const char *name, int btf_fd,
+                   __u32 log_level, char *log, size_t log_size) {
+	// 类型编号见 vi_btf_load: 3 为主程序，4 为回调
+	struct bpf_func_info funcs[2] = {{0, 3}, {p->cb_off, 4}};
+	LIBBPF_OPTS(bpf_prog_load_opts, opts, .log_level = log_level,
+	            .log_buf = log_level ? log : NULL,
+	            .log_size = log_level ? log_size : 0);
+
+	// 内核要求 bpf_loop 回调有 BTF 描述
+	if (p->cb_off) {
+		opts.prog_btf_fd = btf_fd;
+		opts.func_info = funcs;
+		opts.func_info_cnt = 2;
+		opts.func_info_rec_size = sizeof(funcs[0]);
+	}
+	return bpf_prog_load(BPF_PROG_TYPE_SOCKET_FILTER, name, "GPL", p->insns,
+	                     p->cnt, &opts);
+}
+
+// 取不到的值输出为 "-"
+static const char *vi_fmt(char *buf, size_t size, const char *fmt, double v) {
+	if (isnan(v))
+		return "-";
+	snprintf(buf, size, fmt, v);
+	return buf;
+}
+
+static int vi_run_one(const struct vi_family *fam, __u32 n, int map_fd,
+                      int btf_fd, volatile bool *exiting) {
+	char log[VI_LOG_SIZE], reason[128] = "", phase[64];
+	char b[8][16];
+	struct bpf_prog_info info;
+	__u32 info_len = sizeof(info);
+	struct vi_prog p = {};
+	__u64 samples[VI_LOADS], start;
+	double jited = NAN, xlated = NAN;
+	struct bench_lat lat = {NAN, NAN, NAN};
+	double load_min = NAN;
+	struct vi_stats st;
+	int fd, nr = 0, err = 0;
+
+	fam->gen(&p, n, map_fd);
+	if (p.err) {
+		free(p.insns);
+		return p.err;
+	}
+
+	// 第一次加载带统计日志；内核不支持 BPF_LOG_STATS 时不写日志，
+	// 此时退回无日志加载，统计项留空
+	log[0] = '\0';
+	fd = vi_load(&p, fam->name, btf_fd, VI_LOG_STATS, log, sizeof(log));
+	if (fd == -EINVAL && !log[0])
+		fd = vi_load(&p, fam->name, btf_fd, 0, NULL, 0);
+	vi_parse_log(log, &st);
+	if (fd < 0) {
+		// 日志第一行是校验器拒绝的原因
+		snprintf(reason, sizeof(reason), "%s", log[0] ? log : strerror(-fd));
+		reason[strcspn(reason, "\n")] = '\0';
+		goto print;
+	}
+	memset(&info, 0, sizeof(info));
+	if (!bpf_prog_get_info_by_fd(fd, &info, &info_len)) {
+		jited = info.jited_prog_len;
+		xlated = info.xlated_prog_len;
+	}
+	close(fd);
+
+	for (nr = 0; nr < VI_LOADS && !*exiting; nr++) {
+		start = bench_now_ns();
+		fd = vi_load(&p, fam->name, btf_fd, 0, NULL, 0);
+		samples[nr] = bench_now_ns() - start;
+		if (fd < 0) {
+			err = fd;
+			fprintf(stderr, "Failed to load %s/%u: %d\n", fam->name, n, err);
+			goto out;
+		}
+		close(fd);
+	}
+	snprintf(phase, sizeof(phase), "verifier/%s/%u", fam->name, n);
+	bench_lat_summarize(phase, samples, nr, &lat);
+	if (nr)
+		load_min = samples[0];
+
+print:
+	printf("%-12s %-6u %-7d %-10s %-10s %-10s %-10s %-7s %-7s %-9s %-9s "
+	       "%s\n",
+	       fam->name, n, p.cnt,
+	       vi_fmt(b[0], sizeof(b[0]), "%.1f", lat.p50 / 1e3),
+	       vi_fmt(b[1], sizeof(b[1]), "%.1f", load_min / 1e3),
+	       vi_fmt(b[2], sizeof(b[2]), "%.0f", st.verify_us),
+	       vi_fmt(b[3], sizeof(b[3]), "%.0f", st.processed),
+	       vi_fmt(b[4], sizeof(b[4]), "%.0f", st.total_states),
+	       vi_fmt(b[5], sizeof(b[5]), "%.0f", st.peak_states),
+	       vi_fmt(b[6], sizeof(b[6]), "%.0f", jited),
+	       vi_fmt(b[7], sizeof(b[7]), "%.0f", xlated),
+	       reason[0] ? reason : "ok");
+	fflush(stdout);
+	BENCH_OUTPUT("verifier", BF_STR("program", fam->name), BF_U64("n", n),
+	             BF_U64("insns", p.cnt),
+	             BF_STR("status", fd < 0 ? "rejected" : "ok"),
+	             BF_STR("reason", reason), BF_F64("load_us", lat.p50 / 1e3),
+	             BF_F64("load_min_us", load_min / 1e3),
+	             BF_F64("verify_us", st.verify_us),
+	             BF_F64("processed", st.processed),
+	             BF_F64("max_states_per_insn", st.max_states),
+	             BF_F64("total_states", st.total_states),
+	             BF_F64("peak_states", st.peak_states),
+	             BF_F64("jited_bytes", jited), BF_F64("xlated_bytes", xlated));
+out:
+	free(p.insns);
+	return err;
+}
+
+int bench_verifier(volatile bool *exiting) {
+	struct btf *btf = NULL;
+	int map_fd, err = 0;
+
+	// map_ops 程序引用的 array map，只创建一次
+	map_fd = bpf_map_create(BPF_MAP_TYPE_ARRAY, "vi_array", sizeof(__u32),
+	                        sizeof(__u64), 1, NULL);
+	if (map_fd < 0) {
+		fprintf(stderr, "Failed to create vi_array: %d\n", map_fd);
+		return map_fd;
+	}
+	printf("%-12s %-6s %-7s %-10s %-10s %-10s %-10s %-7s %-7s %-9s %-9s %s\n",
+	       "PROGRAM", "N", "INSNS", "LOAD(us)", "MIN(us)", "VERIFY(us)",
+	       "PROCESSED", "STATES", "PEAK", "JIT(B)", "XLATED(B)", "STATUS");
+	for (int f = 0; !err && f < BENCH_ARRAY_SIZE(vi_families); f++) {
+		const struct vi_family *fam = &vi_families[f];
+
+		if (fam->feat && !bench_feature_supported(fam->feat)) {
+			printf("%-12s unsupported by running kernel (missing %s)\n",
+			       fam->name, fam->feat->name);
+			continue;
+		}
+		// BTF 只在第一次需要时加载
+		if (fam->btf && !btf) {
+			err = vi_btf_load(&btf);
+			if (err) {
+				printf("%-12s skipped, failed to load BTF: %d\n", fam->name,
+				       err);
+				err = 0;
+				continue;
+			}
+		}
+		for (int s = 0; !err && s < BENCH_ARRAY_SIZE(vi_sizes) && !*exiting;
+		     s++) {
+			if (vi_sizes[s] <= fam->max_n)
+				err = vi_run_one(fam, vi_sizes[s], map_fd,
+				                 btf ? btf__fd(btf) : -1, exiting);
+		}
+	}
+	btf__free(btf);
+	close(map_fd);
+	return err;
+}
+
+static const struct bench_feature verifier_feats[] = {
+    BENCH_PROG(SOCKET_FILTER),
+    BENCH_MAP(ARRAY),
+};
+
+BENCH_REGISTER(verifier) = {
+    .name = "verifier",
+    .key = 'V',
+    .doc = "Benchmark program load and verifier cost against program "
+           "complexity",
+    .feats = verifier_feats,
+    .nr_feats = BENCH_ARRAY_SIZE(verifier_feats),
+    .schema = "program,n,insns,status,reason,load_us,load_min_us,verify_us,"
+              "processed,max_states_per_insn,total_states,peak_states,"
+              "jited_bytes,xlated_bytes",
+    .run = bench_verifier,
+};
@@ -0,0 +1,173 @@
+// Copyright 2024 The EBPF performance testing Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// author: yys2020haha@163.com
+//
+// Startup probe: load and attach the maps object, then report startup cost.
+//
+// 同一份源码编译两次: 默认使用 libbpf 骨架(maps.skel.h)，定义 BENCH_LSKEL 时
+// 使用轻量骨架(maps.lskel.h，不链接 libbpf/libelf/zlib/zstd)。由 -S 基准测试
+// 反复启动，附加完成后向标准输出写一行:
+//   <main入口时间ns> <附加完成时间ns> <VmRSS KB> <VmHWM KB> <共享库个数>
+//   <共享库字节数>
+// 时间均为 CLOCK_MONOTONIC，由父进程减去 exec 前的时间戳
+#ifdef BENCH_LSKEL
+#include "maps.lskel.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#else
+#include "maps.skel.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// 统计的共享库个数与路径长度上限
+#define PROBE_MAX_LIBS 64
+#define PROBE_PATH_LEN 256
+
+static unsigned long long probe_now_ns(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#ifdef BENCH_LSKEL
+// 轻量骨架不会自动附加 tracepoint 程序，按 libbpf 的方式手动附加:
+// 打开 tracepoint 的 perf 事件并把程序绑定上去
+static int probe_attach_tracepoint(int prog_fd, const char *category,
+                                   const char *name) {
+	static const char *const roots[] = {"/sys/kernel/tracing",
+	                                    "/sys/kernel/debug/tracing"};
+	struct perf_event_attr attr = {};
+	char path[256];
+	FILE *f = NULL;
+	int id = -1, pfd;
+
+	for (size_t i = 0; !f && i < sizeof(roots) / sizeof(roots[0]); i++) {
+		snprintf(path, sizeof(path), "%s/events/%s/%s/id", roots[i],
+		         category, name);
+		f = fopen(path, "r");
+	}
+	if (!f)
+		return -1;
+	if (fscanf(f, "%d", &id) != 1)
+		id = -1;
+	fclose(f);
+	if (id < 0)
+		return -1;
+
+	attr.type = PERF_TYPE_TRACEPOINT;
+	attr.size = sizeof(attr);
+	attr.config = id;
+	attr.sample_period = 1;
+	attr.wakeup_events = 1;
+	pfd = syscall(__NR_perf_event_open, &attr, -1, 0, -1,
+	              PERF_FLAG_FD_CLOEXEC);
+	if (pfd < 0)
+		return -1;
+	if (ioctl(pfd, PERF_EVENT_IOC_SET_BPF, prog_fd) ||
+	    ioctl(pfd, PERF_EVENT_IOC_ENABLE, 0)) {
+		close(pfd);
+		return -1;
+	}
+	return pfd;
+}
+#endif
+
+// 当前与峰值常驻内存；posix_spawn 的子进程在 exec 前与父进程共享内存，
+// 父进程的 rusage.ru_maxrss 因此不可靠，由子进程自己读取 VmHWM
+static void probe_rss(long *rss, long *hwm) {
+	char line[128];
+	FILE *f;
+
+	*rss = *hwm = -1;
+	f = fopen("/proc/self/status", "r");
+	if (!f)
+		return;
+	while (fgets(line, sizeof(line), f)) {
+		sscanf(line, "VmRSS: %ld kB", rss);
+		sscanf(line, "VmHWM: %ld kB", hwm);
+	}
+	fclose(f);
+}
+
+// 统计映射进进程的共享库个数与文件大小之和
+static void probe_libs(int *nr, long long *bytes) {
+	char libs[PROBE_MAX_LIBS][PROBE_PATH_LEN];
+	char line[512], path[PROBE_PATH_LEN];
+	struct stat st;
+	FILE *f;
+	int i;
+
+	*nr = 0;
+	*bytes = 0;
+	f = fopen("/proc/self/maps", "r");
+	if (!f)
+		return;
+	while (fgets(line, sizeof(line), f) && *nr < PROBE_MAX_LIBS) {
+		if (sscanf(line, "%*s %*s %*s %*s %*s %255s", path) != 1 ||
+		    !strstr(path, ".so"))
+			continue;
+		for (i = 0; i < *nr && strcmp(libs[i], path); i++)
+			;
+		if (i < *nr)
+			continue;
+		snprintf(libs[(*nr)++], PROBE_PATH_LEN, "%s", path);
+		if (!stat(path, &st))
+			*bytes += st.st_size;
+	}
+	fclose(f);
+}
+
+int main(void) {
+	unsigned long long main_ns = probe_now_ns(), attach_ns;
+	struct maps_bpf *skel;
+	long long lib_bytes;
+	long rss, hwm;
+	int err, nr_libs;
+#ifdef BENCH_LSKEL
+	int pfd;
+#endif
+
+	skel = maps_bpf__open_and_load();
+	if (!skel) {
+		fprintf(stderr, "Failed to open and load BPF skeleton\n");
+		return 1;
+	}
+#ifdef BENCH_LSKEL
+	pfd = probe_attach_tracepoint(skel->progs.tp_sys_entry.prog_fd,
+	                              "raw_syscalls", "sys_enter");
+	err = pfd < 0;
+#else
+	err = maps_bpf__attach(skel);
+#endif
+	attach_ns = probe_now_ns();
+	if (err) {
+		fprintf(stderr, "Failed to attach BPF skeleton\n");
+		maps_bpf__destroy(skel);
+		return 1;
+	}
+	probe_rss(&rss, &hwm);
+	probe_libs(&nr_libs, &lib_bytes);
+	printf("%llu %llu %ld %ld %d %lld\n", main_ns, attach_ns, rss, hwm,
+	       nr_libs, lib_bytes);
+	fflush(stdout);
+#ifdef BENCH_LSKEL
+	close(pfd);
+#endif
+	maps_bpf__destroy(skel);
+	return 0;
+}